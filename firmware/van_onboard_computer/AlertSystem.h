@@ -20,7 +20,9 @@
 #include <Arduino.h>
 #include "config.h"
 #include "SystemData.h"
+#include "Settings.h"
 #include "Buzzer.h"
+#include "Watchdog.h"
 
 // ============================================
 // CLASSE AlertSystem
@@ -46,15 +48,16 @@ private:
   SystemState& state;
   
   // Buzzer
-  Buzzer* buzzer;
+  Buzzer buzzer;
   
   // Timing
-  unsigned long lastBuzzerToggle;
   unsigned long lastAlertCheck;
   
   // Configuration buzzer
-  uint16_t buzzerInterval;      ///< Intervalle entre bips (ms)
-  bool buzzerState;             ///< État actuel buzzer (on/off)
+  const BuzzerNote* buzzerPattern;  ///< Motif associé au niveau d'alerte (PROGMEM)
+  
+  // Dernière tentative de lecture gaz évaluée (watchdog)
+  uint8_t evaluatedGasSeq;
   
   // Flags
   bool initialized;
@@ -66,22 +69,14 @@ public:
    */
   AlertSystem(SystemState& sysState) 
     : state(sysState),
-      buzzer(nullptr),
-      lastBuzzerToggle(0),
+      buzzer(PIN_BUZZER),
       lastAlertCheck(0),
-      buzzerInterval(1000),
-      buzzerState(false),
+      buzzerPattern(nullptr),
+      evaluatedGasSeq(0),
       initialized(false)
   {
   }
   
-  /**
-   * @brief Destructeur
-   */
-  ~AlertSystem() {
-    if (buzzer) delete buzzer;
-  }
-  
   // ============================================
   // INITIALISATION
   // ============================================
@@ -94,12 +89,11 @@ public:
     DEBUG_PRINTLN(F("=== INITIALISATION SYSTEME ALERTE ==="));
     
     // Initialiser buzzer
-    buzzer = new Buzzer(PIN_BUZZER);
-    if (buzzer->begin()) {
+    if (buzzer.begin()) {
       state.sensors.buzzer = true;
-      DEBUG_PRINTLN(F("[OK] Buzzer initialise"));
+      LOG_INFO("Buzzer initialise");
     } else {
-      DEBUG_PRINTLN(F("[ECHEC] Buzzer non initialise"));
+      LOG_WARN("Buzzer non initialise");
       state.sensors.buzzer = false;
     }
     
@@ -110,9 +104,9 @@ public:
     state.alerts.buzzerActive = false;
     state.alerts.blockNavigation = false;
     
-    // Bip de démarrage
+    // Bip de démarrage (non-bloquant)
     if (state.sensors.buzzer) {
-      buzzer->beep(1000);
+      buzzer.beep(1000);
     }
     
     initialized = true;
@@ -139,7 +133,7 @@ public:
     state.alerts.primaryAlert = AlertType::NONE;
     
     // Réinitialiser toutes les alertes
-    for (uint8_t i = 0; i < 10; i++) {
+    for (uint8_t i = 0; i < ALERT_MAX_COUNT; i++) {
       state.alerts.alerts[i].active = false;
     }
     
@@ -149,12 +143,32 @@ public:
     }
     
     // Toujours vérifier les autres alertes
+    checkGasSensorAlerts();
     checkPowerAlerts();
     checkEnvironmentAlerts();
     checkLevelAlerts();
     
     // Mettre à jour mode système et buzzer
     updateAlertMode();
+    
+    reportProgress();
+  }
+  
+  /**
+   * @brief Signale au watchdog une passe qui a traité une tentative de lecture gaz
+   * 
+   * @details Tentative = state.safety.sampleSeq avancé, lecture réussie
+   * ou non. Sans capteur gaz en service, chaque passe complète compte.
+   * Une tentative jamais évaluée laisse la tâche en retard.
+   */
+  void reportProgress() {
+    bool gasActive = state.sensors.mq7 || state.sensors.mq2;
+    bool fresh = state.safety.sampleSeq != evaluatedGasSeq;
+    evaluatedGasSeq = state.safety.sampleSeq;
+    
+    if (fresh || !gasActive) {
+      watchdog.checkIn(WatchdogTask::ALERTS);
+    }
   }
   
   /**
@@ -162,60 +176,51 @@ public:
    */
   void checkGasAlerts() {
     // === CO - CRITICAL (>400 ppm) ===
-    if (state.safety.coValid && state.safety.coPPM > CO_THRESHOLD_DANGER) {
+    if (state.safety.coValid && state.safety.coPPM > settings.values.coDanger) {
       addAlert(AlertType::CO_HIGH, AlertLevel::CRITICAL, 
-               state.safety.coPPM, CO_THRESHOLD_DANGER,
-               "CO CRITIQUE!");
+               state.safety.coPPM, settings.values.coDanger);
     }
     // === CO - WARNING (>200 ppm) ===
-    else if (state.safety.coValid && state.safety.coPPM > CO_THRESHOLD_WARNING) {
+    else if (state.safety.coValid && state.safety.coPPM > settings.values.coWarning) {
       addAlert(AlertType::CO_HIGH, AlertLevel::WARNING, 
-               state.safety.coPPM, CO_THRESHOLD_WARNING,
-               "CO eleve");
+               state.safety.coPPM, settings.values.coWarning);
     }
     // === CO - INFO (>50 ppm) ===
-    else if (state.safety.coValid && state.safety.coPPM > CO_THRESHOLD_INFO) {
+    else if (state.safety.coValid && state.safety.coPPM > settings.values.coInfo) {
       addAlert(AlertType::CO_HIGH, AlertLevel::INFO, 
-               state.safety.coPPM, CO_THRESHOLD_INFO,
-               "CO detecte");
+               state.safety.coPPM, settings.values.coInfo);
     }
     
     // === GPL - CRITICAL (>3000 ppm) ===
-    if (state.safety.gplValid && state.safety.gplPPM > GPL_THRESHOLD_DANGER) {
+    if (state.safety.gplValid && state.safety.gplPPM > settings.values.gplDanger) {
       addAlert(AlertType::GPL_HIGH, AlertLevel::CRITICAL, 
-               state.safety.gplPPM, GPL_THRESHOLD_DANGER,
-               "GPL CRITIQUE!");
+               state.safety.gplPPM, settings.values.gplDanger);
     }
     // === GPL - WARNING (>1000 ppm) ===
-    else if (state.safety.gplValid && state.safety.gplPPM > GPL_THRESHOLD_WARNING) {
+    else if (state.safety.gplValid && state.safety.gplPPM > settings.values.gplWarning) {
       addAlert(AlertType::GPL_HIGH, AlertLevel::WARNING, 
-               state.safety.gplPPM, GPL_THRESHOLD_WARNING,
-               "GPL eleve");
+               state.safety.gplPPM, settings.values.gplWarning);
     }
     // === GPL - INFO (>500 ppm) ===
-    else if (state.safety.gplValid && state.safety.gplPPM > GPL_THRESHOLD_INFO) {
+    else if (state.safety.gplValid && state.safety.gplPPM > settings.values.gplInfo) {
       addAlert(AlertType::GPL_HIGH, AlertLevel::INFO, 
-               state.safety.gplPPM, GPL_THRESHOLD_INFO,
-               "GPL detecte");
+               state.safety.gplPPM, settings.values.gplInfo);
     }
     
     // === FUMÉE - DANGER (>2000 ppm) ===
-    if (state.safety.smokeValid && state.safety.smokePPM > SMOKE_THRESHOLD_DANGER) {
+    if (state.safety.smokeValid && state.safety.smokePPM > settings.values.smokeDanger) {
       addAlert(AlertType::SMOKE_HIGH, AlertLevel::DANGER, 
-               state.safety.smokePPM, SMOKE_THRESHOLD_DANGER,
-               "FUMEE DANGER!");
+               state.safety.smokePPM, settings.values.smokeDanger);
     }
     // === FUMÉE - WARNING (>1500 ppm) ===
-    else if (state.safety.smokeValid && state.safety.smokePPM > SMOKE_THRESHOLD_WARNING) {
+    else if (state.safety.smokeValid && state.safety.smokePPM > settings.values.smokeWarning) {
       addAlert(AlertType::SMOKE_HIGH, AlertLevel::WARNING, 
-               state.safety.smokePPM, SMOKE_THRESHOLD_WARNING,
-               "Fumee detectee");
+               state.safety.smokePPM, settings.values.smokeWarning);
     }
     // === FUMÉE - INFO (>1000 ppm) ===
-    else if (state.safety.smokeValid && state.safety.smokePPM > SMOKE_THRESHOLD_INFO) {
+    else if (state.safety.smokeValid && state.safety.smokePPM > settings.values.smokeInfo) {
       addAlert(AlertType::SMOKE_HIGH, AlertLevel::INFO, 
-               state.safety.smokePPM, SMOKE_THRESHOLD_INFO,
-               "Fumee legere");
+               state.safety.smokePPM, settings.values.smokeInfo);
     }
   }
   
@@ -224,51 +229,44 @@ public:
    */
   void checkPowerAlerts() {
     // === BATTERIE 12V BASSE - DANGER (<10.5V) ===
-    if (state.power.voltage12VValid && state.power.voltage12V < VOLTAGE_12V_MIN) {
+    if (state.power.voltage12VValid && state.power.voltage12V < settings.values.voltage12VMin) {
       addAlert(AlertType::VOLTAGE_12V_LOW, AlertLevel::DANGER, 
-               state.power.voltage12V, VOLTAGE_12V_MIN,
-               "BATTERIE CRITIQUE!");
+               state.power.voltage12V, settings.values.voltage12VMin);
     }
     // === BATTERIE 12V BASSE - WARNING (<11.5V) ===
-    else if (state.power.voltage12VValid && state.power.voltage12V < VOLTAGE_12V_WARNING) {
+    else if (state.power.voltage12VValid && state.power.voltage12V < settings.values.voltage12VWarning) {
       addAlert(AlertType::VOLTAGE_12V_LOW, AlertLevel::WARNING, 
-               state.power.voltage12V, VOLTAGE_12V_WARNING,
-               "Batterie faible");
+               state.power.voltage12V, settings.values.voltage12VWarning);
     }
     
     // === SURTENSION 12V - WARNING (>14.5V) ===
-    if (state.power.voltage12VValid && state.power.voltage12V > VOLTAGE_12V_MAX) {
+    if (state.power.voltage12VValid && state.power.voltage12V > settings.values.voltage12VMax) {
       addAlert(AlertType::VOLTAGE_12V_HIGH, AlertLevel::WARNING, 
-               state.power.voltage12V, VOLTAGE_12V_MAX,
-               "Surtension 12V");
+               state.power.voltage12V, settings.values.voltage12VMax);
     }
     
     // === SOUS-TENSION 5V - DANGER (<4.5V) ===
-    if (state.power.voltage5VValid && state.power.voltage5V < VOLTAGE_5V_MIN) {
+    if (state.power.voltage5VValid && state.power.voltage5V < settings.values.voltage5VMin) {
       addAlert(AlertType::VOLTAGE_5V_LOW, AlertLevel::DANGER, 
-               state.power.voltage5V, VOLTAGE_5V_MIN,
-               "5V CRITIQUE!");
+               state.power.voltage5V, settings.values.voltage5VMin);
     }
     
     // === SURTENSION 5V - WARNING (>5.5V) ===
-    if (state.power.voltage5VValid && state.power.voltage5V > VOLTAGE_5V_MAX) {
+    if (state.power.voltage5VValid && state.power.voltage5V > settings.values.voltage5VMax) {
       addAlert(AlertType::VOLTAGE_5V_HIGH, AlertLevel::WARNING, 
-               state.power.voltage5V, VOLTAGE_5V_MAX,
-               "Surtension 5V");
+               state.power.voltage5V, settings.values.voltage5VMax);
     }
     
     // === SUR-COURANT 12V - WARNING ===
-    if (state.power.voltage12VValid && state.power.current12V > CURRENT_12V_MAX) {
+    if (state.power.voltage12VValid && state.power.current12V > settings.values.current12VMax) {
       addAlert(AlertType::CURRENT_12V_HIGH, AlertLevel::WARNING, 
-               state.power.current12V, CURRENT_12V_MAX,
-               "Surintensity 12V");
+               state.power.current12V, settings.values.current12VMax);
     }
     
     // === SUR-COURANT 5V - WARNING ===
-    if (state.power.voltage5VValid && state.power.current5V > CURRENT_5V_MAX) {
+    if (state.power.voltage5VValid && state.power.current5V > settings.values.current5VMax) {
       addAlert(AlertType::CURRENT_5V_HIGH, AlertLevel::WARNING, 
-               state.power.current5V, CURRENT_5V_MAX,
-               "Surintensity 5V");
+               state.power.current5V, settings.values.current5VMax);
     }
   }
   
@@ -277,24 +275,34 @@ public:
    */
   void checkEnvironmentAlerts() {
     // === TEMPÉRATURE HAUTE - WARNING (>35°C) ===
-    if (state.environment.tempIntValid && state.environment.tempInterior > TEMP_WARNING) {
+    if (state.environment.tempIntValid && state.environment.tempInterior > settings.values.tempWarning) {
       addAlert(AlertType::TEMP_HIGH, AlertLevel::WARNING, 
-               state.environment.tempInterior, TEMP_WARNING,
-               "Temp elevee");
+               state.environment.tempInterior, settings.values.tempWarning);
     }
     
     // === TEMPÉRATURE BASSE - WARNING (<0°C) ===
-    if (state.environment.tempIntValid && state.environment.tempInterior < 0) {
+    if (state.environment.tempIntValid && state.environment.tempInterior < settings.values.tempFreeze) {
       addAlert(AlertType::TEMP_LOW, AlertLevel::WARNING, 
-               state.environment.tempInterior, 0,
-               "Temp basse");
+               state.environment.tempInterior, settings.values.tempFreeze);
     }
     
     // === HUMIDITÉ HAUTE - INFO (>80%) ===
-    if (state.environment.humidityValid && state.environment.humidity > HUMIDITY_WARNING) {
+    if (state.environment.humidityValid && state.environment.humidity > settings.values.humidityWarning) {
       addAlert(AlertType::HUMIDITY_HIGH, AlertLevel::INFO, 
-               state.environment.humidity, HUMIDITY_WARNING,
-               "Humidite haute");
+               state.environment.humidity, settings.values.humidityWarning);
+    }
+  }
+  
+  /**
+   * @brief Vérifie l'état des capteurs gaz
+   * 
+   * @details Capteur hors service après lectures ratées répétées : la
+   * surveillance CO/GPL est perdue, valeur = nombre de capteurs en défaut.
+   */
+  void checkGasSensorAlerts() {
+    uint8_t faults = state.safety.mq7Fault + state.safety.mq2Fault;
+    if (faults > 0) {
+      addAlert(AlertType::GAS_SENSOR_FAULT, AlertLevel::WARNING, faults, 0);
     }
   }
   
@@ -303,10 +311,9 @@ public:
    */
   void checkLevelAlerts() {
     // === INCLINAISON - WARNING (>5°) ===
-    if (state.level.valid && state.level.totalTilt > TILT_WARNING) {
+    if (state.level.valid && state.level.totalTilt > settings.values.tiltWarning) {
       addAlert(AlertType::TILT_HIGH, AlertLevel::WARNING, 
-               state.level.totalTilt, TILT_WARNING,
-               "Inclinaison");
+               state.level.totalTilt, settings.values.tiltWarning);
     }
   }
   
@@ -320,20 +327,19 @@ public:
    * @param level Niveau de gravité
    * @param value Valeur ayant déclenché l'alerte
    * @param threshold Seuil franchi
-   * @param message Message descriptif
    */
-  void addAlert(AlertType type, AlertLevel level, float value, float threshold, const char* message) {
-    if (state.alerts.activeAlertCount >= 10) return; // Limite atteinte
+  void addAlert(AlertType type, AlertLevel level, float value, float threshold) {
+    if (state.alerts.activeAlertCount >= ALERT_MAX_COUNT) return; // Limite atteinte
     
-    uint8_t index = state.alerts.activeAlertCount;
+    Alert& alert = state.alerts.alerts[state.alerts.activeAlertCount];
+    float factor = alertScale(type);
     
-    state.alerts.alerts[index].type = type;
-    state.alerts.alerts[index].level = level;
-    state.alerts.alerts[index].value = value;
-    state.alerts.alerts[index].threshold = threshold;
-    state.alerts.alerts[index].timestamp = millis();
-    state.alerts.alerts[index].active = true;
-    state.alerts.alerts[index].message = message;
+    alert.type = type;
+    alert.level = level;
+    alert.value = toFixed16(value, factor);
+    alert.threshold = toFixed16(threshold, factor);
+    alert.timestamp = toTimestamp16(millis());
+    alert.active = true;
     
     state.alerts.activeAlertCount++;
     
@@ -351,11 +357,11 @@ public:
     // Déterminer action selon niveau d'alerte
     switch (state.alerts.currentLevel) {
       case AlertLevel::CRITICAL:
-        // Buzzer continu
+        // Sirène continue
         state.alerts.buzzerActive = true;
         state.alerts.blockNavigation = true;
         state.mode = SystemMode::MODE_ALERT;
-        buzzerInterval = 0; // Continu
+        buzzerPattern = PATTERN_ALERT_CRITICAL;
         break;
         
       case AlertLevel::DANGER:
@@ -363,14 +369,14 @@ public:
         state.alerts.buzzerActive = true;
         state.alerts.blockNavigation = true;
         state.mode = SystemMode::MODE_ALERT;
-        buzzerInterval = 200;
+        buzzerPattern = PATTERN_ALERT_DANGER;
         break;
         
       case AlertLevel::WARNING:
-        // Bips lents (1000ms)
+        // Bip bref toutes les 2s
         state.alerts.buzzerActive = true;
         state.alerts.blockNavigation = false;
-        buzzerInterval = 1000;
+        buzzerPattern = PATTERN_ALERT_WARNING;
         break;
         
       case AlertLevel::INFO:
@@ -401,46 +407,31 @@ public:
    * @brief Met à jour le buzzer (à appeler dans loop)
    * 
    * @details
-   * Gère les patterns de bips selon le niveau d'alerte :
-   * - CRITICAL : Buzzer continu
+   * Sélectionne le motif sonore selon le niveau d'alerte :
+   * - CRITICAL : Sirène continue deux tons
    * - DANGER : Bips rapides (200ms on/off)
-   * - WARNING : Bips lents (1000ms on/off)
+   * - WARNING : Bip bref toutes les 2s
    * - INFO/NONE : Silence
+   * 
+   * Le motif n'est (re)lancé qu'au changement de niveau ; la lecture
+   * elle-même est cadencée par le séquenceur du Buzzer (non-bloquant).
    */
   void updateBuzzer() {
-    if (!state.sensors.buzzer || !buzzer) return;
+    if (!state.sensors.buzzer) return;
     
-    unsigned long now = millis();
+    buzzer.update();
     
     if (!state.alerts.buzzerActive) {
-      // Arrêter le buzzer si actif
-      if (buzzerState) {
-        buzzer->stop();
-        buzzerState = false;
+      // Arrêter le motif d'alerte s'il est en cours
+      if (buzzerPattern && buzzer.isPlayingPattern(buzzerPattern)) {
+        buzzer.stop();
       }
       return;
     }
     
-    // CRITICAL : Buzzer continu
-    if (buzzerInterval == 0) {
-      if (!buzzerState) {
-        buzzer->tone(1000, 0); // Son continu
-        buzzerState = true;
-      }
-      return;
-    }
-    
-    // DANGER / WARNING : Bips intermittents
-    if (now - lastBuzzerToggle >= buzzerInterval) {
-      lastBuzzerToggle = now;
-      
-      if (buzzerState) {
-        buzzer->stop();
-        buzzerState = false;
-      } else {
-        buzzer->tone(1000, buzzerInterval - 50); // Bip avec petite pause
-        buzzerState = true;
-      }
+    // Lancer le motif du niveau courant (en boucle)
+    if (!buzzer.isPlayingPattern(buzzerPattern)) {
+      buzzer.play(buzzerPattern, true);
     }
   }
   
@@ -448,10 +439,7 @@ public:
    * @brief Force l'arrêt du buzzer (pour acquittement temporaire)
    */
   void silenceBuzzer() {
-    if (buzzer) {
-      buzzer->stop();
-      buzzerState = false;
-    }
+    buzzer.stop();
   }
   
   // ============================================
@@ -499,17 +487,12 @@ public:
   }
   
   /**
-   * @brief Obtient une alerte par index
-   * @param index Index de l'alerte (0-9)
-   * @return Structure Alert
+   * @brief Obtient une alerte par index (sans copie)
+   * @param index Index de l'alerte (0 à ALERT_MAX_COUNT-1)
+   * @return Alerte dans SystemState, nullptr si index invalide
    */
-  Alert getAlert(uint8_t index) const {
-    if (index < 10) {
-      return state.alerts.alerts[index];
-    }
-    Alert empty;
-    empty.active = false;
-    return empty;
+  const Alert* getAlert(uint8_t index) const {
+    return (index < ALERT_MAX_COUNT) ? &state.alerts.alerts[index] : nullptr;
   }
   
   /**
@@ -24,6 +24,7 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <Adafruit_BME280.h>
+#include "I2CBus.h"
 
 
 // ============================================
@@ -56,7 +57,8 @@ enum class BME280Status {
   NOT_INITIALIZED,   ///< Capteur non initialisé
   READY,            ///< Capteur prêt et fonctionnel
   ERROR_NOT_FOUND,  ///< Capteur non détecté sur I2C
-  ERROR_COMM        ///< Erreur de communication
+  ERROR_COMM,       ///< Erreur de communication
+  ERROR_TIMEOUT     ///< Transaction I2C expirée (bus bloqué)
 };
 
 // ============================================
@@ -101,6 +103,14 @@ private:
   uint16_t sampleInterval;        ///< Intervalle entre lectures (ms)
   uint8_t i2cAddress;             ///< Adresse I2C du capteur
   float seaLevelPressure;         ///< Pression niveau mer pour calcul altitude
+  uint8_t failedReads;            ///< Lectures ratées consécutives (saturé)
+  
+  /**
+   * @brief Comptabilise une lecture ratée
+   */
+  void readFailed() {
+    if (failedReads < 0xFF) failedReads++;
+  }
   
 public:
   /**
@@ -114,7 +124,8 @@ public:
     lastUpdate(0),
     sampleInterval(interval),
     i2cAddress(addr),
-    seaLevelPressure(SEA_LEVEL_PRESSURE_HPA)
+    seaLevelPressure(SEA_LEVEL_PRESSURE_HPA),
+    failedReads(0)
   {
     // Initialiser structure données
     memset(&currentData, 0, sizeof(BME280Data));
@@ -127,21 +138,29 @@ public:
    * @return true si succès, false si échec
    * 
    * @details
-   * - Vérifie la présence du capteur sur le bus I2C
+   * - Vérifie la présence du capteur sur le bus I2C (~50 µs si absent)
    * - Configure les paramètres de mesure
    * - Active le mode normal
+   *
+   * @warning Bloquant ~120 ms si le capteur répond : Adafruit_BME280::begin()
+   * enchaîne reset logiciel (10 ms), attente de la copie NVM (pas de
+   * 10 ms, ~2 ms en pratique) et stabilisation (100 ms), sans point
+   * d'entrée pour découper ces étapes. Pendant ce temps, Timer0 continue
+   * de séquencer le buzzer et d'avancer millis() ; les échéances du
+   * watchdog (secondes) et WDT_TIMEOUT (4 s) ne sont pas menacées.
+   * Seul un bus qui échoue pendant l'attente NVM prolonge le blocage
+   * (registre d'état relu à 0xFF) : le WDT matériel y met fin.
    */
   bool begin() {
     // Vérifier présence I2C
-    Wire.beginTransmission(i2cAddress);
-    if (Wire.endTransmission() != 0) {
+    if (!I2CBus::probe(i2cAddress)) {
       status = BME280Status::ERROR_NOT_FOUND;
       return false;
     }
     
     // Initialiser avec adresse spécifique
     if (!bme.begin(i2cAddress)) {
-      status = BME280Status::ERROR_NOT_FOUND;
+      status = I2CBus::takeTimeout() ? BME280Status::ERROR_TIMEOUT : BME280Status::ERROR_NOT_FOUND;
       return false;
     }
     
@@ -153,7 +172,13 @@ public:
                     Adafruit_BME280::FILTER_X16,      // Filtre pour stabilité
                     Adafruit_BME280::STANDBY_MS_500); // Standby 500ms
     
+    if (I2CBus::takeTimeout()) {
+      status = BME280Status::ERROR_TIMEOUT;
+      return false;
+    }
+    
     status = BME280Status::READY;
+    failedReads = 0;
     
     // Première lecture pour remplir les données
     forceUpdate();
@@ -172,13 +197,20 @@ public:
    * À appeler régulièrement dans loop().
    */
   bool update() {
-    if (status != BME280Status::READY) return false;
-    
     unsigned long now = millis();
     if (now - lastUpdate < sampleInterval) {
       return false; // Intervalle non écoulé
     }
     
+    // Erreur de bus : plus de lecture avant begin(), échec à chaque échéance
+    if (status != BME280Status::READY) {
+      if (status != BME280Status::NOT_INITIALIZED) {
+        lastUpdate = now;
+        readFailed();
+      }
+      return false;
+    }
+    
     return readSensor();
   }
 
@@ -364,6 +396,14 @@ public:
     return i2cAddress;
   }
 
+  /**
+   * @brief Lectures ratées consécutives (HealthMonitor)
+   * @return Nombre d'échecs depuis la dernière lecture réussie (saturé)
+   */
+  uint8_t getFailedReads() const {
+    return failedReads;
+  }
+
 private:
   /**
    * @brief Lit les données du capteur
@@ -382,14 +422,23 @@ private:
     
     currentData.timestamp = lastUpdate;
     
+    // Bus expiré : valeurs non significatives, begin() requis
+    if (I2CBus::takeTimeout()) {
+      status = BME280Status::ERROR_TIMEOUT;
+      readFailed();
+      return false;
+    }
+    
     // Vérifier valeurs valides (NaN = erreur lecture)
     if (isnan(currentData.temperature) || 
         isnan(currentData.humidity) || 
         isnan(currentData.pressure)) {
       status = BME280Status::ERROR_COMM;
+      readFailed();
       return false;
     }
     
+    failedReads = 0;
     return true;
   }
 };
@@ -0,0 +1,100 @@
+/**
+ * @file BoardProfile.h
+ * @brief Profil matériel : capteurs présents fixés à la compilation
+ * @author Frédéric BAILLON
+ * @version 0.1.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Les drapeaux BOARD_HAS_* de config.h décrivent le câblage du van.
+ * Chaque capteur est porté par un SensorSlot<T, présent> :
+ * - Présent : l'emplacement contient l'instance du capteur
+ * - Absent : emplacement vide, le test `if (slot)` vaut false à la
+ *   compilation et tout le code qui en dépend est éliminé
+ *
+ * @code
+ * SensorSlot<DS18B20Sensor, BoardProfile::ds18b20> ds18b20;
+ *
+ * if (!ds18b20 || !state.sensors.ds18b20) return;  // constant si absent
+ * ds18b20->update();
+ * @endcode
+ *
+ * Le profil est choisi par BOARD_PROFILE (config.h, -DBOARD_PROFILE=n).
+ * Gain d'un profil réduit : tools/scripts/profile_sizes.py compile
+ * chaque profil et mesure son .elf avec avr-size (text, data, bss) ;
+ * avec --port, il relève aussi le temps de boucle par télémétrie.
+ */
+
+#ifndef BOARD_PROFILE_H
+#define BOARD_PROFILE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// ============================================
+// PROFIL
+// ============================================
+/**
+ * @struct BoardProfile
+ * @brief Capteurs câblés (constantes de compilation)
+ */
+struct BoardProfile {
+  static constexpr bool bme280     = BOARD_HAS_BME280;
+  static constexpr bool ds18b20    = BOARD_HAS_DS18B20;
+  static constexpr bool mpu6050    = BOARD_HAS_MPU6050;
+  static constexpr bool mq7        = BOARD_HAS_MQ7;
+  static constexpr bool mq2        = BOARD_HAS_MQ2;
+  static constexpr bool ina226_12v = BOARD_HAS_INA226_12V;
+  static constexpr bool ina226_5v  = BOARD_HAS_INA226_5V;
+
+  /// Nombre de capteurs prévus par le profil
+  static constexpr uint8_t sensorCount = bme280 + ds18b20 + mpu6050 + mq7 + mq2 +
+                                         ina226_12v + ina226_5v;
+};
+
+// ============================================
+// EMPLACEMENT CAPTEUR
+// ============================================
+/**
+ * @class SensorSlot
+ * @brief Capteur présent : contient l'instance
+ * @tparam T Classe du capteur
+ * @tparam PRESENT Capteur câblé (BoardProfile)
+ */
+template<typename T, bool PRESENT>
+class SensorSlot {
+private:
+  T sensor;
+
+public:
+  /**
+   * @brief Construit le capteur avec les arguments donnés
+   */
+  template<typename... Args>
+  SensorSlot(Args&&... args) : sensor(static_cast<Args&&>(args)...) {}
+
+  explicit operator bool() const { return true; }
+
+  T* operator->() { return &sensor; }
+  const T* operator->() const { return &sensor; }
+};
+
+/**
+ * @brief Capteur absent : aucune instance, accès éliminés
+ *
+ * @details operator->() n'est atteint que derrière un test `if (slot)`
+ * toujours faux : le compilateur retire la branche.
+ */
+template<typename T>
+class SensorSlot<T, false> {
+public:
+  template<typename... Args>
+  SensorSlot(Args&&...) {}
+
+  explicit operator bool() const { return false; }
+
+  T* operator->() { return nullptr; }
+  const T* operator->() const { return nullptr; }
+};
+
+#endif // BOARD_PROFILE_H
@@ -0,0 +1,220 @@
+/**
+ * @file BubbleLevel.h
+ * @brief Niveau à bulle graphique et hauteurs de calage par roue
+ * @author Frédéric BAILLON
+ * @version 0.1.0
+ * @date 2024-11-26
+ *
+ * @details
+ * L'écran LEVEL n'affichait que trois nombres, difficiles à suivre en
+ * manœuvrant sur les cales. Il montre désormais :
+ * - Une bulle 3 × 3 pixels sur un champ de 9 × 4 cellules (45 × 32
+ *   pixels), repère central fixe. La bulle va vers le côté haut, comme
+ *   un niveau posé sur le plancher ; butée verticale à
+ *   LEVEL_BUBBLE_RANGE, même échelle horizontalement.
+ * - La hauteur à ajouter sous chaque roue (avant/arrière,
+ *   gauche/droite), en cm, d'après l'empattement et la voie du
+ *   registre de paramètres ("wheelbase", "track").
+ *
+ * Les cellules du champ sont des motifs calculés (GlyphCache.h) :
+ * 2 cellules de repère + 4 au plus pour la bulle. Un déplacement de la
+ * bulle ne renvoie que les motifs et cellules modifiés.
+ *
+ * Pendant l'affichage de l'écran, le MPU6050 est lu toutes les
+ * LEVEL_MPU_INTERVAL ms (SensorManager::setLevelling()).
+ *
+ * Conventions (LEVEL_ROLL_SIGN / LEVEL_PITCH_SIGN selon le montage) :
+ * roll > 0 = côté droit plus bas, pitch > 0 = avant plus haut.
+ * Hauteurs calculées aux petits angles (sin ≈ angle, écart < 2 % à 20°).
+ */
+
+#ifndef BUBBLE_LEVEL_H
+#define BUBBLE_LEVEL_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "SystemData.h"
+#include "Settings.h"
+#include "LCDFramebuffer.h"
+#include "FixedFormat.h"
+
+// ============================================
+// CONFIGURATION
+// ============================================
+#define BUBBLE_FIELD_COLS       9       ///< Largeur du champ (cellules)
+#define BUBBLE_CENTER_X         22      ///< Centre du champ (pixel, colonne 4)
+#define BUBBLE_CENTER_Y         15      ///< Centre du champ (pixel, entre lignes 1 et 2)
+#define BUBBLE_TRAVEL           14      ///< Course de la bulle à LEVEL_BUBBLE_RANGE (pixels)
+#define BUBBLE_GUIDE_COL        12      ///< Colonne des hauteurs de calage (gauche, droite)
+
+// ============================================
+// TYPES ET STRUCTURES
+// ============================================
+/**
+ * @enum Wheel
+ * @brief Roues (ordre des hauteurs de calage)
+ */
+enum class Wheel : uint8_t {
+  FRONT_LEFT,
+  FRONT_RIGHT,
+  REAR_LEFT,
+  REAR_RIGHT,
+  COUNT
+};
+
+// ============================================
+// CLASSE BubbleLevel
+// ============================================
+/**
+ * @class BubbleLevel
+ * @brief Dessin du niveau à bulle et calcul du calage
+ */
+class BubbleLevel {
+private:
+  /**
+   * @brief Pixel allumé dans le champ
+   * @param x Colonne de pixel (0-44)
+   * @param y Ligne de pixel (0-31)
+   * @param bx Centre de la bulle
+   * @param by Centre de la bulle
+   */
+  static bool pixel(int8_t x, int8_t y, int8_t bx, int8_t by) {
+    // Bulle 3 × 3
+    if (abs(x - bx) <= 1 && abs(y - by) <= 1) return true;
+
+    // Repère : coins d'un carré 5 × 5 autour du centre
+    return (x == BUBBLE_CENTER_X - 2 || x == BUBBLE_CENTER_X + 2) &&
+           (y == BUBBLE_CENTER_Y - 2 || y == BUBBLE_CENTER_Y + 2);
+  }
+
+  /**
+   * @brief Position de la bulle sur un axe
+   * @param tilt Inclinaison (centièmes de degré, signe : côté haut positif)
+   * @param center Pixel central
+   * @param travel Course maximale (pixels)
+   */
+  static int8_t position(int16_t tilt, int8_t center, int8_t travel) {
+    int32_t offset = (int32_t)tilt * BUBBLE_TRAVEL / LEVEL_BUBBLE_RANGE;
+    if (offset > travel) offset = travel;
+    if (offset < -travel) offset = -travel;
+    return center + offset;
+  }
+
+  /**
+   * @brief Borne une inclinaison au domaine du calcul de calage
+   */
+  static int16_t clampTilt(int16_t tilt) {
+    if (tilt > LEVEL_GUIDE_MAX_TILT) return LEVEL_GUIDE_MAX_TILT;
+    if (tilt < -LEVEL_GUIDE_MAX_TILT) return -LEVEL_GUIDE_MAX_TILT;
+    return tilt;
+  }
+
+  /**
+   * @brief Dénivelé sur une distance (petits angles)
+   * @param distance Distance (cm)
+   * @param tilt Inclinaison (centièmes de degré, bornée)
+   * @return Dénivelé (mm) = distance × tilt × π/180
+   */
+  static int16_t drop(uint16_t distance, int16_t tilt) {
+    return (int32_t)distance * tilt * 1745 / 1000000L;
+  }
+
+public:
+  /**
+   * @brief Hauteurs à ajouter sous chaque roue pour mettre de niveau
+   * @param roll Roll (centièmes de degré)
+   * @param pitch Pitch (centièmes de degré)
+   * @param wheelbase Empattement (cm)
+   * @param track Voie (cm)
+   * @param raises Hauteurs en mm, indexées par Wheel (0 pour la roue la plus haute)
+   */
+  static void wheelRaises(int16_t roll, int16_t pitch, uint16_t wheelbase, uint16_t track,
+                          int16_t raises[(uint8_t)Wheel::COUNT]) {
+    roll = clampTilt(roll * LEVEL_ROLL_SIGN);
+    pitch = clampTilt(pitch * LEVEL_PITCH_SIGN);
+
+    // Avant plus haut que l'arrière de frontDrop, gauche que droite de leftDrop
+    int16_t frontDrop = drop(wheelbase, pitch);
+    int16_t leftDrop = drop(track, roll);
+
+    // Hauteur de chaque roue (× 2 pour rester entier), puis écart au point haut
+    int16_t height[(uint8_t)Wheel::COUNT] = {
+      (int16_t)( frontDrop + leftDrop),
+      (int16_t)( frontDrop - leftDrop),
+      (int16_t)(-frontDrop + leftDrop),
+      (int16_t)(-frontDrop - leftDrop)
+    };
+    int16_t highest = height[0];
+    for (uint8_t i = 1; i < (uint8_t)Wheel::COUNT; i++) {
+      if (height[i] > highest) highest = height[i];
+    }
+    for (uint8_t i = 0; i < (uint8_t)Wheel::COUNT; i++) {
+      raises[i] = (highest - height[i]) / 2;
+    }
+  }
+
+  /**
+   * @brief Dessine la bulle et le repère (colonnes 0-8)
+   * @param fb Image de l'écran
+   * @param level Mesures d'horizontalité
+   *
+   * @details Mesure invalide : repère seul. Cellules vides : espace.
+   */
+  static void drawBubble(LCDFramebuffer& fb, const LevelData& level) {
+    // Bulle hors champ si mesure invalide
+    int8_t bx = -10;
+    int8_t by = -10;
+    if (level.valid) {
+      // Côté haut : gauche si roll > 0, avant (haut de l'écran) si pitch > 0
+      bx = position(-level.roll.raw * LEVEL_ROLL_SIGN, BUBBLE_CENTER_X, BUBBLE_CENTER_X - 1);
+      by = position(-level.pitch.raw * LEVEL_PITCH_SIGN, BUBBLE_CENTER_Y, BUBBLE_CENTER_Y - 1);
+    }
+
+    for (uint8_t row = 0; row < LCD_ROWS; row++) {
+      for (uint8_t col = 0; col < BUBBLE_FIELD_COLS; col++) {
+        uint8_t bitmap[8];
+        bool lit = false;
+        bool bubble = false;
+        for (uint8_t line = 0; line < 8; line++) {
+          int8_t y = row * 8 + line;
+          bitmap[line] = 0;
+          for (uint8_t px = 0; px < 5; px++) {
+            int8_t x = col * 5 + px;
+            if (!pixel(x, y, bx, by)) continue;
+            bitmap[line] |= 0x10 >> px;
+            bubble |= abs(x - bx) <= 1 && abs(y - by) <= 1;
+          }
+          lit |= bitmap[line] != 0;
+        }
+        fb.put(col, row, lit ? fb.glyph(bitmap, bubble ? 'o' : '.') : ' ');
+      }
+    }
+  }
+
+  /**
+   * @brief Écrit les hauteurs de calage (cm, colonnes 12-17, lignes 2-3)
+   * @param fb Image de l'écran
+   * @param level Mesures d'horizontalité
+   */
+  static void drawGuidance(LCDFramebuffer& fb, const LevelData& level) {
+    int16_t raises[(uint8_t)Wheel::COUNT];
+    if (level.valid) {
+      wheelRaises(level.roll.raw, level.pitch.raw,
+                  settings.values.wheelbase, settings.values.track, raises);
+    }
+
+    char text[4];
+    for (uint8_t i = 0; i < (uint8_t)Wheel::COUNT; i++) {
+      uint8_t col = BUBBLE_GUIDE_COL + (i & 1) * 3;
+      uint8_t row = 2 + (i >> 1);
+      if (level.valid) {
+        FixedFormat::formatWidth(text, 3, raises[i], 1, 0);   // mm -> cm arrondi
+      } else {
+        strcpy(text, "  -");
+      }
+      fb.print(col, row, text);
+    }
+  }
+};
+
+#endif // BUBBLE_LEVEL_H
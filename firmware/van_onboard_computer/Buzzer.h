@@ -2,23 +2,31 @@
  * @file Buzzer.h
  * @brief Classe pour la gestion d'un buzzer piézoélectrique
  * @author Frédéric BAILLON
- * @version 0.1.0
+ * @version 0.2.0
  * @date 2024-11-21
- * 
+ *
  * @details
  * Cette classe gère un buzzer piézoélectrique actif ou passif via PWM.
  * Elle permet de générer des sons de différentes fréquences et durées.
+ *
+ * Lecture non-bloquante de motifs sonores :
+ * - Un motif est une suite compacte (fréquence, durée) stockée en PROGMEM
+ * - Chaque note est arrêtée par l'ISR de tone() (Timer2) à la milliseconde près
+ * - L'enchaînement des notes est cadencé par l'interruption Timer0 COMPA
+ *   (~1 kHz, partagée avec millis()) : loop() ne passe aucun temps sur le son
  */
 
 #ifndef BUZZER_H
 #define BUZZER_H
 
 #include <Arduino.h>
+#include <avr/interrupt.h>
 
 // ============================================
 // CONFIGURATION MATÉRIELLE
 // ============================================
 #define BUZZER_PIN 25        ///< Broche GPIO du buzzer (à adapter)
+#define BUZZER_TIMER_ISR 1   ///< 1 = séquenceur cadencé par Timer0 COMPA, 0 = par update()
 
 // ============================================
 // TYPES ET STRUCTURES
@@ -33,26 +41,112 @@
 #define NOTE_B4  494
 #define NOTE_C5  523
 
+// Fréquences spéciales dans un motif
+#define NOTE_REST   0        ///< Silence
+#define NOTE_BASE   1        ///< Fréquence de base passée à play()
+
+/**
+ * @struct BuzzerNote
+ * @brief Étape d'un motif sonore (stockée en PROGMEM)
+ */
+struct BuzzerNote {
+    uint16_t frequency;    ///< Fréquence en Hz (NOTE_REST = silence, NOTE_BASE = fréquence de base)
+    uint16_t duration;     ///< Durée de l'étape en ms (0 = fin du motif)
+};
+
+// ============================================
+// MOTIFS PRÉDÉFINIS
+// ============================================
+/// Bip court
+const BuzzerNote PATTERN_BEEP[] PROGMEM = {
+    {NOTE_BASE, 100}, {NOTE_REST, 0}
+};
+
+/// Double-bip
+const BuzzerNote PATTERN_DOUBLE_BEEP[] PROGMEM = {
+    {NOTE_BASE, 100}, {NOTE_REST, 100}, {NOTE_BASE, 100}, {NOTE_REST, 0}
+};
+
+/// Alarme deux tons
+const BuzzerNote PATTERN_ALARM[] PROGMEM = {
+    {800, 100}, {1200, 100}, {NOTE_REST, 0}
+};
+
+/// Alerte WARNING : bip bref toutes les 2 s
+const BuzzerNote PATTERN_ALERT_WARNING[] PROGMEM = {
+    {1000, 150}, {NOTE_REST, 1850}, {NOTE_REST, 0}
+};
+
+/// Alerte DANGER : bips rapides (200 ms on/off)
+const BuzzerNote PATTERN_ALERT_DANGER[] PROGMEM = {
+    {1500, 200}, {NOTE_REST, 200}, {NOTE_REST, 0}
+};
+
+/// Alerte CRITICAL : sirène continue deux tons
+const BuzzerNote PATTERN_ALERT_CRITICAL[] PROGMEM = {
+    {800, 250}, {1200, 250}, {NOTE_REST, 0}
+};
+
 // ============================================
 // DEFINITION CLASSE Buzzer
 // ============================================
 /**
  * @class Buzzer
  * @brief Gestion d'un buzzer piézoélectrique
- * 
+ *
  * Cette classe encapsule les fonctionnalités d'un buzzer :
  * - Génération de tonalités à fréquences variables
  * - Gestion de la durée des sons
- * - Patterns sonores prédéfinis (bip, double-bip, alarme)
+ * - Séquenceur de motifs non-bloquant (bip, double-bip, alarme, alertes)
  */
 class Buzzer {
 private:
-    uint8_t pin;           ///< Broche GPIO du buzzer
-    bool initialized;      ///< État d'initialisation
-    uint32_t startTime;    ///< Temps de début du son
-    uint32_t duration;     ///< Durée du son en cours
+    uint8_t pin;                        ///< Broche GPIO du buzzer
+    bool initialized;                   ///< État d'initialisation
+    bool toneActive;                    ///< Note simple en cours (tone())
+    uint32_t startTime;                 ///< Temps de début du son
+    uint32_t duration;                  ///< Durée du son en cours (0 = continu)
+
+    // Séquenceur
+    const BuzzerNote* volatile pattern; ///< Motif en cours (PROGMEM, nullptr = aucun)
+    volatile uint8_t step;              ///< Index de la note en cours
+    volatile uint32_t stepStart;        ///< Début de la note en cours
+    volatile uint16_t stepDuration;     ///< Durée de la note en cours
+    volatile bool looping;              ///< Rejouer le motif en boucle
+    volatile uint32_t playStart;        ///< Début de la lecture du motif
+    volatile uint32_t playDuration;     ///< Durée max de lecture (0 = illimitée)
+    uint16_t baseFrequency;             ///< Fréquence substituée à NOTE_BASE
+
+    /**
+     * @brief Démarre la note courante du motif
+     * @param now Timestamp actuel
+     * @return false si fin du motif atteinte
+     */
+    bool startStep(uint32_t now) {
+        BuzzerNote note;
+        memcpy_P(&note, &pattern[step], sizeof(BuzzerNote));
+
+        if (note.duration == 0) return false;
+
+        stepStart = now;
+        stepDuration = note.duration;
+
+        uint16_t frequency = (note.frequency == NOTE_BASE) ? baseFrequency : note.frequency;
+        if (frequency == NOTE_REST) {
+            ::noTone(pin);
+        } else {
+            // Arrêt de la note par l'ISR de tone()
+            ::tone(pin, frequency, note.duration);
+        }
+        return true;
+    }
 
 public:
+    /**
+     * @brief Instance cadencée par l'interruption Timer0 COMPA
+     */
+    static Buzzer* volatile activeInstance;
+
     /**
      * @brief Constructeur de la classe Buzzer
      * @param pin Numéro de la broche GPIO connectée au buzzer
@@ -60,8 +154,17 @@ public:
     Buzzer(uint8_t pin) :
         pin(pin),
         initialized(false),
+        toneActive(false),
         startTime(0),
-        duration(0)
+        duration(0),
+        pattern(nullptr),
+        step(0),
+        stepStart(0),
+        stepDuration(0),
+        looping(false),
+        playStart(0),
+        playDuration(0),
+        baseFrequency(1000)
     {}
 
     // INITIALISATION
@@ -74,78 +177,165 @@ public:
         pinMode(pin, OUTPUT);
         digitalWrite(pin, LOW);
         initialized = true;
-        
+
+#if BUZZER_TIMER_ISR
+        // Interruption de comparaison Timer0 (~1 kHz), Timer0 reste dédié à millis()
+        activeInstance = this;
+        OCR0A = 0xAF;
+        TIMSK0 |= _BV(OCIE0A);
+#endif
+
         return true;
     }
 
     /**
      * @brief Émet un son à une fréquence donnée
      * @param frequency Fréquence en Hz (20 à 20000 Hz typiquement)
-     * @param duration Durée en millisecondes (0 = son continu)
+     * @param toneDuration Durée en millisecondes (0 = son continu)
+     *
+     * @details Interrompt le motif en cours éventuel.
      */
-    void tone(uint16_t frequency, uint32_t duration = 0) {
+    void tone(uint16_t frequency, uint32_t toneDuration = 0) {
         if (!initialized) return;
-    
-        tone(pin, frequency);
-    
-        if (duration > 0) {
-            startTime = millis();
-            duration = duration;
+
+        // Section critique : pointeur 16 bits lu par l'ISR (écrit octet par octet)
+        noInterrupts();
+        pattern = nullptr;
+        if (toneDuration > 0) {
+            ::tone(pin, frequency, toneDuration);
         } else {
-            duration = 0;
+            ::tone(pin, frequency);
         }
-    }
+        interrupts();
 
+        toneActive = true;
+        startTime = millis();
+        duration = toneDuration;
+    }
 
     /**
-     * @brief Arrête le son en cours
+     * @brief Arrête le son en cours (note ou motif)
      */
     void stop() {
         if (!initialized) return;
-    
-        noTone(pin);
+
+        // Section critique : voir tone()
+        noInterrupts();
+        pattern = nullptr;
+        ::noTone(pin);
+        interrupts();
+        toneActive = false;
         duration = 0;
     }
 
+    // SÉQUENCEUR DE MOTIFS
+    // ------------------------------------------
     /**
-     * @brief Émet un bip court
+     * @brief Lance la lecture d'un motif (non-bloquant)
+     * @param newPattern Motif en PROGMEM, terminé par une note de durée 0
+     * @param loop true pour rejouer le motif en boucle
+     * @param frequency Fréquence substituée aux notes NOTE_BASE (Hz)
+     * @param maxDuration Durée max de lecture en ms (0 = fin du motif / illimitée)
+     */
+    void play(const BuzzerNote* newPattern, bool loop = false,
+              uint16_t frequency = 1000, uint32_t maxDuration = 0) {
+        if (!initialized || newPattern == nullptr) return;
+
+        uint32_t now = millis();
+
+        // Section critique : l'ISR ne doit pas voir un motif à moitié initialisé
+        noInterrupts();
+        pattern = newPattern;
+        baseFrequency = frequency;
+        looping = loop;
+        step = 0;
+        playStart = now;
+        playDuration = maxDuration;
+        bool started = startStep(now);
+        if (!started) pattern = nullptr;
+        interrupts();
+
+        if (!started) {
+            stop();
+        }
+    }
+
+    /**
+     * @brief Avance le séquenceur (tick)
+     *
+     * @details
+     * Appelé depuis l'ISR Timer0 COMPA (BUZZER_TIMER_ISR = 1)
+     * ou depuis loop() via update(). Coût : une comparaison de temps.
+     */
+    void tick() {
+        const BuzzerNote* current = pattern;
+        if (current == nullptr) return;
+
+        uint32_t now = millis();
+        if (now - stepStart < stepDuration) return;
+
+        // Durée max de lecture atteinte
+        if (playDuration > 0 && now - playStart >= playDuration) {
+            pattern = nullptr;
+            ::noTone(pin);
+            return;
+        }
+
+        step++;
+        if (startStep(now)) return;
+
+        // Fin du motif : boucle ou arrêt
+        step = 0;
+        if (looping && startStep(now)) return;
+
+        pattern = nullptr;
+        ::noTone(pin);
+    }
+
+    /**
+     * @brief Met à jour le séquenceur depuis loop()
+     *
+     * @details Sans effet si le séquenceur est cadencé par interruption.
+     */
+    void update() {
+#if !BUZZER_TIMER_ISR
+        tick();
+#endif
+    }
+
+    /**
+     * @brief Vérifie si un motif est en cours de lecture
+     * @param p Motif à comparer (nullptr = n'importe lequel)
+     * @return true si en lecture
+     */
+    bool isPlayingPattern(const BuzzerNote* p = nullptr) const {
+        const BuzzerNote* current = pattern;
+        if (current == nullptr) return false;
+        return (p == nullptr) || (current == p);
+    }
+
+    /**
+     * @brief Émet un bip court (non-bloquant)
      * @param frequency Fréquence du bip en Hz (défaut: 1000 Hz)
      */
     void beep(uint16_t frequency = 1000) {
-        tone(frequency, 100);
-        delay(100);
-        stop();
+        play(PATTERN_BEEP, false, frequency);
     }
 
     /**
-     * @brief Émet un double-bip
+     * @brief Émet un double-bip (non-bloquant)
      * @param frequency Fréquence des bips en Hz (défaut: 1000 Hz)
      */
     void doubleBeep(uint16_t frequency = 1000) {
-        tone(frequency, 100);
-        delay(100);
-        stop();
-        delay(100);
-        tone(frequency, 100);
-        delay(100);
-        stop();
+        play(PATTERN_DOUBLE_BEEP, false, frequency);
     }
 
     /**
-     * @brief Émet une séquence d'alarme
-     * @param duration Durée totale de l'alarme en ms (défaut: 1000 ms)
+     * @brief Émet une séquence d'alarme (non-bloquant)
+     * @param alarmDuration Durée totale de l'alarme en ms (défaut: 1000 ms)
      */
-    void alarm(uint32_t duration = 1000) {
-        uint32_t startTime = millis();
-    
-        while (millis() - startTime < duration) {
-            tone(800, 100);
-            delay(100);
-            stop();
-            tone(1200, 100);
-            delay(100);
-            stop();
-        }
+    void alarm(uint32_t alarmDuration = 1000) {
+        play(PATTERN_ALARM, true, 1000, alarmDuration);
     }
 
     /**
@@ -153,11 +343,25 @@ public:
      * @return true si un son est actif, false sinon
      */
     bool isPlaying() const {
-        if (duration == 0) return false;
-        
+        if (pattern != nullptr) return true;
+        if (!toneActive) return false;
+        if (duration == 0) return true;  // Son continu
+
         return (millis() - startTime) < duration;
     }
 
 };
 
+Buzzer* volatile Buzzer::activeInstance = nullptr;
+
+#if BUZZER_TIMER_ISR
+/**
+ * @brief Cadencement du séquenceur (Timer0 COMPA, ~1 kHz)
+ */
+ISR(TIMER0_COMPA_vect) {
+    Buzzer* instance = Buzzer::activeInstance;
+    if (instance) instance->tick();
+}
+#endif
+
 #endif // BUZZER_H
@@ -84,6 +84,7 @@ private:
   
   bool initialized;                     ///< État initialisation
   DS18B20Status status;                 ///< État actuel du capteur
+  uint8_t failedReads;                  ///< Lectures invalides consécutives (saturé)
 
   /**
    * @brief Vérifie si une température est valide
@@ -109,7 +110,8 @@ public:
       updateInterval(interval),
       resolution(res),
       initialized(false),
-      status(DS18B20Status::NOT_INITIALIZED)
+      status(DS18B20Status::NOT_INITIALIZED),
+      failedReads(0)
   {
     // Initialiser températures à valeur invalide
     for (uint8_t i = 0; i < DS18B20_MAX_SENSORS; i++) {
@@ -151,6 +153,7 @@ public:
     
     initialized = true;
     status = DS18B20Status::OK;
+    failedReads = 0;
     return true;
   }
 
@@ -246,10 +249,13 @@ public:
       }
     }
     
+    // Sonde absente du bus : -127 °C (DEVICE_DISCONNECTED_C), invalide
     if (!allValid) {
       status = DS18B20Status::INVALID_TEMPERATURE;
+      if (failedReads < 0xFF) failedReads++;
     } else {
       status = DS18B20Status::OK;
+      failedReads = 0;
     }
     
     return allValid;
@@ -311,6 +317,14 @@ public:
     return status;
   }
 
+  /**
+   * @brief Lectures invalides consécutives (HealthMonitor)
+   * @return Nombre d'échecs depuis la dernière lecture réussie (saturé)
+   */
+  uint8_t getFailedReads() const {
+    return failedReads;
+  }
+
   /**
    * @brief Vérifie si le capteur est initialisé
    * @return true si initialisé
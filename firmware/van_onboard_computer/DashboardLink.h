@@ -0,0 +1,426 @@
+/**
+ * @file DashboardLink.h
+ * @brief Liaison série vers le tableau de bord déporté (Arduino Nano)
+ * @author Frédéric BAILLON
+ * @version 0.1.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Diffuse l'état système vers le Nano de la cabine à INTERVAL_DASHBOARD
+ * (10 Hz) avec le protocole de DashboardProtocol.h :
+ * - Valeurs mises à l'échelle en int16 (table DashField)
+ * - DELTA : seuls les champs différents de l'état acquitté par le Nano
+ * - KEYFRAME périodique (DASHBOARD_KEYFRAME_INTERVAL) et après perte de liaison
+ * - Une trame en vol : retransmission sur NAK ou absence d'ACK,
+ *   abandon après DASHBOARD_MAX_RETRIES (KEYFRAME à la reprise)
+ *
+ * Émission non-bloquante : une trame n'est écrite que si le tampon
+ * TX du port série peut la contenir entièrement.
+ */
+
+#ifndef DASHBOARD_LINK_H
+#define DASHBOARD_LINK_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "SystemData.h"
+#include "DashboardProtocol.h"
+
+// ============================================
+// CLASSE DashboardLink
+// ============================================
+/**
+ * @class DashboardLink
+ * @brief Émetteur de l'état système vers le tableau de bord
+ */
+class DashboardLink {
+private:
+  // Référence à l'état système
+  SystemState& state;
+
+  // Port série
+  HardwareSerial& port;
+  DashboardFramer framer;
+
+  // Valeurs
+  int16_t ackedValues[DASH_FIELD_COUNT];    ///< État confirmé par le Nano
+  int16_t pendingValues[DASH_FIELD_COUNT];  ///< État de la trame en vol
+  bool ackedValid;                          ///< ackedValues exploitable
+
+  // Trame en vol
+  uint8_t txFrame[DASH_ENCODED_MAX];        ///< Trame encodée (retransmission)
+  uint8_t txLength;                         ///< Longueur de la trame en vol
+  uint8_t txSeq;                            ///< Séquence de la trame en vol
+  bool awaitingAck;                         ///< Trame en attente d'ACK
+  uint8_t retries;                          ///< Retransmissions de la trame en vol
+  uint8_t nextSeq;                          ///< Prochain numéro de séquence
+
+  // Timing
+  unsigned long lastUpdate;
+  unsigned long lastSend;
+  unsigned long lastKeyframe;
+
+  // Statistiques
+  uint32_t framesSent;
+  uint32_t bytesSent;
+  uint16_t retransmits;
+  uint16_t nakCount;
+  uint16_t timeoutCount;
+  uint16_t linkLossCount;
+
+  // Flags
+  bool initialized;
+  bool linkUp;                              ///< Dernière trame acquittée
+
+  /**
+   * @brief Met une valeur à l'échelle en int16 (saturée)
+   * @param value Valeur réelle
+   * @param scale Facteur d'échelle
+   * @return Valeur entière
+   */
+  static int16_t scale(float value, float scale) {
+    float scaled = value * scale;
+    if (scaled > 32767.0) return 32767;
+    if (scaled < -32768.0) return -32768;
+    return (int16_t)(scaled + (scaled >= 0 ? 0.5 : -0.5));
+  }
+
+  /**
+   * @brief Capture l'état système dans la table de champs
+   * @param values [out] Table de DASH_FIELD_COUNT valeurs
+   */
+  void snapshot(int16_t* values) const {
+    values[DASH_TEMP_INT]    = scale(state.environment.tempInterior, 10);
+    values[DASH_TEMP_EXT]    = scale(state.environment.tempExterior, 10);
+    values[DASH_HUMIDITY]    = scale(state.environment.humidity, 10);
+    values[DASH_PRESSURE]    = scale(state.environment.pressure, 10);
+    values[DASH_VOLTAGE_12V] = scale(state.power.voltage12V, 100);
+    values[DASH_CURRENT_12V] = scale(state.power.current12V, 100);
+    values[DASH_VOLTAGE_5V]  = scale(state.power.voltage5V, 100);
+    values[DASH_CURRENT_5V]  = scale(state.power.current5V, 100);
+    values[DASH_POWER_TOTAL] = scale(state.power.powerTotal, 10);
+    values[DASH_CO]          = scale(state.safety.coPPM, 1);
+    values[DASH_GPL]         = scale(state.safety.gplPPM, 1);
+    values[DASH_SMOKE]       = scale(state.safety.smokePPM, 1);
+    values[DASH_ROLL]        = scale(state.level.roll, 10);
+    values[DASH_PITCH]       = scale(state.level.pitch, 10);
+    values[DASH_ALERT]       = ((int16_t)state.alerts.currentLevel << 8) |
+                               state.alerts.activeAlertCount;
+    values[DASH_ALERT_TYPE]  = (int16_t)state.alerts.primaryAlert;
+
+    uint16_t flags = 0;
+    if (state.environment.tempIntValid)  flags |= DASH_FLAG_TEMP_INT;
+    if (state.environment.tempExtValid)  flags |= DASH_FLAG_TEMP_EXT;
+    if (state.environment.humidityValid) flags |= DASH_FLAG_HUMIDITY;
+    if (state.environment.pressureValid) flags |= DASH_FLAG_PRESSURE;
+    if (state.power.voltage12VValid)     flags |= DASH_FLAG_12V;
+    if (state.power.voltage5VValid)      flags |= DASH_FLAG_5V;
+    if (state.safety.mq7Preheated)       flags |= DASH_FLAG_MQ7_READY;
+    if (state.safety.mq2Preheated)       flags |= DASH_FLAG_MQ2_READY;
+    if (state.level.valid)               flags |= DASH_FLAG_LEVEL;
+    flags |= (uint16_t)state.mode << 12;
+    values[DASH_FLAGS] = (int16_t)flags;
+  }
+
+  /**
+   * @brief Construit le payload d'un KEYFRAME
+   * @param values Table de valeurs
+   * @param payload [out] Payload
+   * @return Longueur du payload
+   */
+  static uint8_t buildKeyframe(const int16_t* values, uint8_t* payload) {
+    uint8_t* out = payload;
+    for (uint8_t i = 0; i < DASH_FIELD_COUNT; i++) {
+      out = dashPutInt16(out, values[i]);
+    }
+    return out - payload;
+  }
+
+  /**
+   * @brief Construit le payload d'un DELTA
+   * @param values Valeurs actuelles
+   * @param reference Valeurs connues du Nano
+   * @param payload [out] Payload
+   * @return Longueur du payload (0 si aucun changement)
+   */
+  static uint8_t buildDelta(const int16_t* values, const int16_t* reference, uint8_t* payload) {
+    memset(payload, 0, DASH_MASK_BYTES);
+    uint8_t* out = payload + DASH_MASK_BYTES;
+
+    for (uint8_t i = 0; i < DASH_FIELD_COUNT; i++) {
+      if (values[i] == reference[i]) continue;
+      payload[i >> 3] |= 1 << (i & 7);
+      out = dashPutInt16(out, values[i]);
+    }
+
+    uint8_t length = out - payload;
+    return (length > DASH_MASK_BYTES) ? length : 0;
+  }
+
+  /**
+   * @brief Écrit la trame en vol sur le port série
+   * @return false si le tampon TX est trop plein (réessai au prochain cycle)
+   */
+  bool transmit() {
+    if (port.availableForWrite() < txLength) {
+      return false;
+    }
+    port.write(txFrame, txLength);
+    lastSend = millis();
+    framesSent++;
+    bytesSent += txLength;
+    return true;
+  }
+
+  /**
+   * @brief Retransmet la trame en vol
+   * @return false si le nombre max de tentatives est atteint
+   */
+  bool retransmit() {
+    if (retries >= DASHBOARD_MAX_RETRIES) {
+      // Liaison perdue : prochaine trame = KEYFRAME
+      awaitingAck = false;
+      ackedValid = false;
+      if (linkUp) linkLossCount++;
+      linkUp = false;
+      return false;
+    }
+    // Émission différée (tampon TX plein) : comptée comme une tentative,
+    // sinon chaque passage de loop() redéclarerait un timeout
+    retries++;
+    if (transmit()) {
+      retransmits++;
+    } else {
+      lastSend = millis();
+    }
+    return true;
+  }
+
+  /**
+   * @brief Traite les trames reçues du Nano (ACK/NAK)
+   *
+   * @details Le payload d'un ACK ou d'un NAK est le seq de la trame
+   * visée : seule la trame en vol (txSeq) est prise en compte, une
+   * réponse à une trame plus ancienne est ignorée.
+   */
+  void processIncoming() {
+    DashboardFrame frame;
+
+    while (port.available() > 0) {
+      if (!framer.feed(port.read(), frame)) continue;
+      if (!awaitingAck || frame.length < 1) continue;
+
+      uint8_t seq = frame.payload[0];
+
+      if (frame.type == DASH_TYPE_ACK && seq == txSeq) {
+        memcpy(ackedValues, pendingValues, sizeof(ackedValues));
+        ackedValid = true;
+        awaitingAck = false;
+        linkUp = true;
+      } else if (frame.type == DASH_TYPE_NAK && seq == txSeq) {
+        nakCount++;
+        retransmit();
+      }
+    }
+  }
+
+  /**
+   * @brief Prépare et émet la trame suivante
+   * @param now Timestamp actuel
+   */
+  void sendNext(unsigned long now) {
+    int16_t values[DASH_FIELD_COUNT];
+    uint8_t payload[DASH_PAYLOAD_MAX];
+    uint8_t type;
+    uint8_t length;
+
+    snapshot(values);
+
+    bool keyframeDue = (now - lastKeyframe >= DASHBOARD_KEYFRAME_INTERVAL);
+
+    if (!ackedValid || keyframeDue) {
+      // Liaison perdue : sonder au rythme des KEYFRAME seulement
+      if (!ackedValid && !linkUp && framesSent > 0 && !keyframeDue) return;
+
+      type = DASH_TYPE_KEYFRAME;
+      length = buildKeyframe(values, payload);
+      lastKeyframe = now;
+    } else {
+      type = DASH_TYPE_DELTA;
+      length = buildDelta(values, ackedValues, payload);
+      if (length == 0) return; // Rien de nouveau
+    }
+
+    txSeq = nextSeq++;
+    txLength = dashBuildFrame(type, txSeq, payload, length, txFrame);
+    memcpy(pendingValues, values, sizeof(pendingValues));
+    retries = 0;
+    awaitingAck = true;
+
+    if (!transmit()) {
+      lastSend = now; // Émission différée : traitée comme un timeout
+    }
+  }
+
+public:
+  /**
+   * @brief Constructeur
+   * @param sysState Référence à l'état système
+   * @param serial Port série du tableau de bord
+   */
+  DashboardLink(SystemState& sysState, HardwareSerial& serial)
+    : state(sysState),
+      port(serial),
+      ackedValid(false),
+      txLength(0),
+      txSeq(0),
+      awaitingAck(false),
+      retries(0),
+      nextSeq(0),
+      lastUpdate(0),
+      lastSend(0),
+      lastKeyframe(0),
+      framesSent(0),
+      bytesSent(0),
+      retransmits(0),
+      nakCount(0),
+      timeoutCount(0),
+      linkLossCount(0),
+      initialized(false),
+      linkUp(false)
+  {
+    memset(ackedValues, 0, sizeof(ackedValues));
+    memset(pendingValues, 0, sizeof(pendingValues));
+  }
+
+  // ============================================
+  // INITIALISATION
+  // ============================================
+
+  /**
+   * @brief Initialise la liaison
+   * @return true si succès
+   */
+  bool begin() {
+    DEBUG_PRINTLN(F("=== INITIALISATION TABLEAU DE BORD ==="));
+
+    port.begin(DASHBOARD_BAUD_RATE);
+    framer.reset();
+    initialized = true;
+
+    LOG_INFO("Liaison tableau de bord ouverte");
+    return true;
+  }
+
+  // ============================================
+  // MISE À JOUR
+  // ============================================
+
+  /**
+   * @brief Met à jour la liaison
+   *
+   * @details
+   * À appeler dans loop(). Traite les ACK/NAK à chaque appel,
+   * retransmet en cas de timeout et émet à INTERVAL_DASHBOARD.
+   */
+  void update() {
+    if (!initialized) return;
+
+    unsigned long now = millis();
+
+    processIncoming();
+
+    // Trame en vol sans réponse
+    if (awaitingAck) {
+      if (now - lastSend >= DASHBOARD_ACK_TIMEOUT) {
+        timeoutCount++;
+        retransmit();
+      }
+      return;
+    }
+
+    if (now - lastUpdate < INTERVAL_DASHBOARD) {
+      return;
+    }
+    lastUpdate = now;
+
+    sendNext(now);
+  }
+
+  /**
+   * @brief Force l'émission d'un KEYFRAME au prochain cycle
+   */
+  void requestKeyframe() {
+    ackedValid = false;
+  }
+
+  // ============================================
+  // GETTERS
+  // ============================================
+
+  /**
+   * @brief Vérifie si le Nano acquitte les trames
+   * @return true si liaison active
+   */
+  bool isLinkUp() const {
+    return linkUp;
+  }
+
+  /**
+   * @brief Obtient le nombre de trames émises (retransmissions incluses)
+   * @return Nombre de trames
+   */
+  uint32_t getFramesSent() const {
+    return framesSent;
+  }
+
+  /**
+   * @brief Obtient le nombre d'octets émis
+   * @return Nombre d'octets
+   */
+  uint32_t getBytesSent() const {
+    return bytesSent;
+  }
+
+  /**
+   * @brief Obtient le nombre de retransmissions
+   * @return Nombre de retransmissions
+   */
+  uint16_t getRetransmits() const {
+    return retransmits;
+  }
+
+  /**
+   * @brief Obtient le nombre de NAK reçus
+   * @return Nombre de NAK
+   */
+  uint16_t getNakCount() const {
+    return nakCount;
+  }
+
+  /**
+   * @brief Obtient le nombre de timeouts d'ACK
+   * @return Nombre de timeouts
+   */
+  uint16_t getTimeoutCount() const {
+    return timeoutCount;
+  }
+
+  /**
+   * @brief Obtient le nombre de pertes de liaison
+   * @return Nombre de pertes
+   */
+  uint16_t getLinkLossCount() const {
+    return linkLossCount;
+  }
+
+  /**
+   * @brief Obtient le nombre de trames reçues rejetées (CRC/COBS)
+   * @return Nombre d'erreurs
+   */
+  uint16_t getRxErrorCount() const {
+    return framer.getErrorCount();
+  }
+};
+
+#endif // DASHBOARD_LINK_H
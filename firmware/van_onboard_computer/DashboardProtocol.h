@@ -0,0 +1,330 @@
+/**
+ * @file DashboardProtocol.h
+ * @brief Protocole binaire de la liaison tableau de bord (Mega ↔ Nano)
+ * @author Frédéric BAILLON
+ * @version 0.1.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Fichier commun aux deux extrémités de la liaison (Arduino Mega et
+ * Arduino Nano de la cabine). Aucune dépendance vers SystemData.h.
+ *
+ * Trame brute : [type][seq][payload...][CRC16 MSB][CRC16 LSB]
+ * - CRC16-CCITT (poly 0x1021, init 0xFFFF) sur type + seq + payload
+ * - Encodage COBS : aucun octet 0x00 dans la trame encodée
+ * - Délimiteur 0x00 en fin de trame (resynchronisation immédiate)
+ *
+ * Types de trames :
+ * - KEYFRAME : toutes les valeurs (int16 mis à l'échelle)
+ * - DELTA    : masque des champs modifiés + leurs valeurs uniquement
+ * - ACK/NAK  : réponse du Nano, payload = seq de la trame acquittée /
+ *              rejetée. NAK : trame intègre (CRC valide) mais payload
+ *              inapplicable (incohérent, DELTA sans KEYFRAME préalable).
+ *              Trame corrompue : seq illisible, aucune réponse (le Mega
+ *              retransmet après DASHBOARD_ACK_TIMEOUT).
+ *
+ * Les valeurs d'un DELTA sont absolues : rejouer une trame est sans effet.
+ */
+
+#ifndef DASHBOARD_PROTOCOL_H
+#define DASHBOARD_PROTOCOL_H
+
+#include <Arduino.h>
+
+// ============================================
+// CONFIGURATION
+// ============================================
+#define DASH_TYPE_KEYFRAME      0x01    ///< Image complète
+#define DASH_TYPE_DELTA         0x02    ///< Champs modifiés uniquement
+#define DASH_TYPE_ACK           0x10    ///< Trame reçue (payload = seq)
+#define DASH_TYPE_NAK           0x11    ///< Trame rejetée (payload = seq de la trame rejetée)
+
+// ============================================
+// TABLE DES CHAMPS
+// ============================================
+/**
+ * @enum DashField
+ * @brief Champs transmis au tableau de bord (int16 mis à l'échelle)
+ */
+enum DashField : uint8_t {
+  DASH_TEMP_INT = 0,    ///< Température intérieure (°C x10)
+  DASH_TEMP_EXT,        ///< Température extérieure (°C x10)
+  DASH_HUMIDITY,        ///< Humidité (% x10)
+  DASH_PRESSURE,        ///< Pression (hPa x10)
+  DASH_VOLTAGE_12V,     ///< Tension 12V (V x100)
+  DASH_CURRENT_12V,     ///< Courant 12V (A x100)
+  DASH_VOLTAGE_5V,      ///< Tension 5V (V x100)
+  DASH_CURRENT_5V,      ///< Courant 5V (A x100)
+  DASH_POWER_TOTAL,     ///< Puissance totale (W x10)
+  DASH_CO,              ///< CO (ppm)
+  DASH_GPL,             ///< GPL (ppm)
+  DASH_SMOKE,           ///< Fumée (ppm)
+  DASH_ROLL,            ///< Roll (° x10)
+  DASH_PITCH,           ///< Pitch (° x10)
+  DASH_ALERT,           ///< Niveau alerte << 8 | nombre d'alertes actives
+  DASH_ALERT_TYPE,      ///< Type de l'alerte prioritaire
+  DASH_FLAGS,           ///< Bits de validité (DASH_FLAG_*) + mode << 12
+  DASH_FIELD_COUNT
+};
+
+// Bits de DASH_FLAGS
+#define DASH_FLAG_TEMP_INT      0x0001
+#define DASH_FLAG_TEMP_EXT      0x0002
+#define DASH_FLAG_HUMIDITY      0x0004
+#define DASH_FLAG_PRESSURE      0x0008
+#define DASH_FLAG_12V           0x0010
+#define DASH_FLAG_5V            0x0020
+#define DASH_FLAG_MQ7_READY     0x0040
+#define DASH_FLAG_MQ2_READY     0x0080
+#define DASH_FLAG_LEVEL         0x0100
+
+// Tailles
+#define DASH_MASK_BYTES         ((DASH_FIELD_COUNT + 7) / 8)
+#define DASH_PAYLOAD_MAX        (DASH_MASK_BYTES + 2 * DASH_FIELD_COUNT)
+#define DASH_RAW_MAX            (2 + DASH_PAYLOAD_MAX + 2)
+#define DASH_ENCODED_MAX        (DASH_RAW_MAX + DASH_RAW_MAX / 254 + 2)
+
+/**
+ * @struct DashboardFrame
+ * @brief Trame décodée
+ */
+struct DashboardFrame {
+  uint8_t type;                       ///< Type (DASH_TYPE_*)
+  uint8_t seq;                        ///< Numéro de séquence
+  uint8_t length;                     ///< Longueur du payload
+  uint8_t payload[DASH_PAYLOAD_MAX];  ///< Payload
+};
+
+// ============================================
+// CRC ET COBS
+// ============================================
+/**
+ * @brief Calcule un CRC16-CCITT
+ * @param data Données
+ * @param length Longueur
+ * @param crc Valeur initiale (chaînage)
+ * @return CRC16
+ */
+inline uint16_t dashCrc16(const uint8_t* data, uint8_t length, uint16_t crc = 0xFFFF) {
+  while (length--) {
+    crc ^= (uint16_t)(*data++) << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+    }
+  }
+  return crc;
+}
+
+/**
+ * @brief Encode un bloc en COBS (sans délimiteur)
+ * @param in Données brutes
+ * @param length Longueur (< 254)
+ * @param out Tampon de sortie (length + 1 octets)
+ * @return Longueur encodée
+ */
+inline uint8_t dashCobsEncode(const uint8_t* in, uint8_t length, uint8_t* out) {
+  uint8_t codeIndex = 0;
+  uint8_t code = 1;
+  uint8_t outIndex = 1;
+
+  for (uint8_t i = 0; i < length; i++) {
+    if (in[i] == 0) {
+      out[codeIndex] = code;
+      codeIndex = outIndex++;
+      code = 1;
+    } else {
+      out[outIndex++] = in[i];
+      code++;
+    }
+  }
+  out[codeIndex] = code;
+
+  return outIndex;
+}
+
+/**
+ * @brief Décode un bloc COBS (sans délimiteur)
+ * @param in Données encodées
+ * @param length Longueur encodée
+ * @param out Tampon de sortie (length octets)
+ * @return Longueur décodée (0 si bloc invalide)
+ */
+inline uint8_t dashCobsDecode(const uint8_t* in, uint8_t length, uint8_t* out) {
+  uint8_t inIndex = 0;
+  uint8_t outIndex = 0;
+
+  while (inIndex < length) {
+    uint8_t code = in[inIndex++];
+    if (code == 0 || inIndex + code - 1 > length) return 0;
+
+    for (uint8_t i = 1; i < code; i++) {
+      out[outIndex++] = in[inIndex++];
+    }
+    if (code < 0xFF && inIndex < length) {
+      out[outIndex++] = 0;
+    }
+  }
+
+  return outIndex;
+}
+
+// ============================================
+// CONSTRUCTION / LECTURE DES TRAMES
+// ============================================
+/**
+ * @brief Construit une trame encodée prête à émettre
+ * @param type Type de trame
+ * @param seq Numéro de séquence
+ * @param payload Payload (peut être nullptr si length = 0)
+ * @param length Longueur du payload (<= DASH_PAYLOAD_MAX)
+ * @param out Tampon de sortie (DASH_ENCODED_MAX octets)
+ * @return Longueur totale, délimiteur 0x00 inclus
+ */
+inline uint8_t dashBuildFrame(uint8_t type, uint8_t seq, const uint8_t* payload,
+                              uint8_t length, uint8_t* out) {
+  uint8_t raw[DASH_RAW_MAX];
+  raw[0] = type;
+  raw[1] = seq;
+  if (length > 0) memcpy(raw + 2, payload, length);
+
+  uint16_t crc = dashCrc16(raw, length + 2);
+  raw[length + 2] = crc >> 8;
+  raw[length + 3] = crc & 0xFF;
+
+  uint8_t encoded = dashCobsEncode(raw, length + 4, out);
+  out[encoded++] = 0x00;
+  return encoded;
+}
+
+/**
+ * @brief Écrit une valeur int16 (poids fort en premier)
+ * @param out Tampon
+ * @param value Valeur
+ * @return Pointeur après la valeur
+ */
+inline uint8_t* dashPutInt16(uint8_t* out, int16_t value) {
+  out[0] = (uint16_t)value >> 8;
+  out[1] = (uint16_t)value & 0xFF;
+  return out + 2;
+}
+
+/**
+ * @brief Lit une valeur int16 (poids fort en premier)
+ * @param in Tampon
+ * @return Valeur
+ */
+inline int16_t dashGetInt16(const uint8_t* in) {
+  return (int16_t)(((uint16_t)in[0] << 8) | in[1]);
+}
+
+/**
+ * @brief Applique le payload d'un KEYFRAME ou DELTA à une table de valeurs
+ * @param frame Trame décodée
+ * @param values [in/out] Table de DASH_FIELD_COUNT valeurs
+ * @return false si payload incohérent
+ */
+inline bool dashApplyFrame(const DashboardFrame& frame, int16_t* values) {
+  if (frame.type == DASH_TYPE_KEYFRAME) {
+    if (frame.length != 2 * DASH_FIELD_COUNT) return false;
+    for (uint8_t i = 0; i < DASH_FIELD_COUNT; i++) {
+      values[i] = dashGetInt16(&frame.payload[2 * i]);
+    }
+    return true;
+  }
+
+  if (frame.type != DASH_TYPE_DELTA || frame.length < DASH_MASK_BYTES) return false;
+
+  const uint8_t* data = frame.payload + DASH_MASK_BYTES;
+  const uint8_t* end = frame.payload + frame.length;
+  for (uint8_t i = 0; i < DASH_FIELD_COUNT; i++) {
+    if (!(frame.payload[i >> 3] & (1 << (i & 7)))) continue;
+    if (data + 2 > end) return false;
+    values[i] = dashGetInt16(data);
+    data += 2;
+  }
+  return data == end;
+}
+
+// ============================================
+// CLASSE DashboardFramer
+// ============================================
+/**
+ * @class DashboardFramer
+ * @brief Réassemblage des trames à partir du flux série
+ *
+ * @details
+ * Accumule les octets jusqu'au délimiteur 0x00, décode le COBS
+ * et vérifie le CRC. Une trame corrompue est comptée puis ignorée.
+ */
+class DashboardFramer {
+private:
+  uint8_t buffer[DASH_ENCODED_MAX];   ///< Octets encodés reçus
+  uint8_t length;                     ///< Octets en attente
+  bool overflow;                      ///< Trame trop longue en cours
+  uint16_t errorCount;                ///< Trames rejetées (COBS/CRC/taille)
+
+public:
+  DashboardFramer() : length(0), overflow(false), errorCount(0) {}
+
+  /**
+   * @brief Traite un octet reçu
+   * @param byte Octet
+   * @param frame [out] Trame complète et valide
+   * @return true si une trame valide vient d'être reçue
+   */
+  bool feed(uint8_t byte, DashboardFrame& frame) {
+    if (byte != 0x00) {
+      if (length < sizeof(buffer)) {
+        buffer[length++] = byte;
+      } else {
+        overflow = true;
+      }
+      return false;
+    }
+
+    // Délimiteur : fin de trame
+    uint8_t received = length;
+    bool tooLong = overflow;
+    length = 0;
+    overflow = false;
+
+    if (received == 0) return false;  // Délimiteurs consécutifs
+
+    uint8_t raw[DASH_ENCODED_MAX];
+    uint8_t rawLength = tooLong ? 0 : dashCobsDecode(buffer, received, raw);
+    if (rawLength < 4 || rawLength > DASH_RAW_MAX) {
+      errorCount++;
+      return false;
+    }
+
+    uint16_t crc = ((uint16_t)raw[rawLength - 2] << 8) | raw[rawLength - 1];
+    if (dashCrc16(raw, rawLength - 2) != crc) {
+      errorCount++;
+      return false;
+    }
+
+    frame.type = raw[0];
+    frame.seq = raw[1];
+    frame.length = rawLength - 4;
+    memcpy(frame.payload, raw + 2, frame.length);
+    return true;
+  }
+
+  /**
+   * @brief Obtient le nombre de trames rejetées
+   * @return Nombre d'erreurs
+   */
+  uint16_t getErrorCount() const {
+    return errorCount;
+  }
+
+  /**
+   * @brief Vide la trame en cours de réception
+   */
+  void reset() {
+    length = 0;
+    overflow = false;
+  }
+};
+
+#endif // DASHBOARD_PROTOCOL_H
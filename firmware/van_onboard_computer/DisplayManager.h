@@ -12,13 +12,22 @@
  * - Gestion du rétro-éclairage
  * - Affichage des alertes
  * - Écran de pré-chauffage
+ * - Messages temporaires non-bloquants (surimpression avec file d'attente)
+ * - Ré-initialisation du LCD après expiration I2C (I2CBus.h)
+ * - Veille de l'affichage : rétro-éclairage éteint, aucun rendu (sauf
+ *   alerte bloquante, qui réveille l'écran), image complète au réveil
+ * - Écrans dessinés dans une image RAM (LCDFramebuffer.h), écrans de
+ *   mesure décrits en flash (ScreenTemplate.h) : seules les cellules
+ *   modifiées sont envoyées au LCD
+ * - Historique 12V / humidité et courbes de tendance (TrendGraph.h)
+ * - Niveau à bulle et hauteurs de calage par roue (BubbleLevel.h)
  * 
  * Écrans disponibles :
  * - HOME : Températures + Tensions + Horizontalité (écran principal)
  * - ENVIRONMENT : Détails environnement (temp/humidité/pression/point de rosée)
  * - ENERGY : Détails énergie (tensions/courants/puissances)
  * - SAFETY : Détails sécurité (CO/GPL/fumée en temps réel)
- * - LEVEL : Détails horizontalité (Roll/Pitch détaillés)
+ * - LEVEL : Niveau à bulle, Roll/Pitch et calage des roues
  * - SETTINGS : Paramètres et calibration
  */
 
@@ -28,9 +37,36 @@
 #include <Arduino.h>
 #include "config.h"
 #include "SystemData.h"
+#include "Settings.h"
 #include "LCDDisplay.h"
+#include "LCDFramebuffer.h"
+#include "ScreenTemplate.h"
+#include "FixedFormat.h"
+#include "TrendGraph.h"
+#include "BubbleLevel.h"
 #include "KY040Encoder.h"
 
+// ============================================
+// TYPES ET STRUCTURES
+// ============================================
+/**
+ * @struct DisplayMessage
+ * @brief Message temporaire affiché en surimpression
+ */
+struct DisplayMessage {
+  char text[LCD_COLS + 1];  ///< Texte (tronqué à une ligne)
+  uint16_t duration;        ///< Durée d'affichage (ms, 0 = jusqu'au prochain rafraîchissement)
+};
+
+/**
+ * @enum DisplayPower
+ * @brief État d'alimentation de l'affichage
+ */
+enum class DisplayPower : uint8_t {
+  AWAKE,      ///< Rétro-éclairage allumé, écran rafraîchi
+  ASLEEP      ///< Rétro-éclairage éteint, aucun accès LCD
+};
+
 // ============================================
 // CLASSE DisplayManager
 // ============================================
@@ -41,8 +77,15 @@
 class DisplayManager {
 private:
   // LCD et encodeur
-  LCDDisplay* lcd;
-  KY040Encoder* encoder;
+  LCDDisplay lcd;
+  KY040Encoder encoder;
+  
+  // Image de l'écran et rendu des gabarits
+  LCDFramebuffer frame;
+  ScreenRenderer renderer;
+  
+  // Historique des mesures (courbes ENERGY / ENVIRONMENT)
+  TrendHistory history;
   
   // Référence à l'état système
   SystemState& state;
@@ -50,35 +93,57 @@ private:
   // Timing
   unsigned long lastUpdate;
   unsigned long lastEncoderActivity;
+  unsigned long lastLcdRetry;   ///< Dernière tentative de ré-initialisation LCD
+  
+  // Messages temporaires (file circulaire)
+  DisplayMessage messageQueue[LCD_MESSAGE_QUEUE_SIZE];
+  uint8_t messageHead;          ///< Index du message courant
+  uint8_t messageCount;         ///< Nombre de messages en file
+  unsigned long messageStart;   ///< Début d'affichage du message courant
+  bool messageShown;            ///< Message courant affiché à l'écran
   
   // Flags
   bool initialized;
   bool forceRedraw;
   
+  uint8_t refreshScale;         ///< Ralentissement du rafraîchissement (profil)
+  
+  // Veille de l'affichage
+  DisplayPower power;
+  uint16_t frameWrites;         ///< Octets HD44780 du dernier écran rendu
+  uint32_t skippedFrames;       ///< Rafraîchissements évités en veille
+  uint32_t savedKilobytes;      ///< Kio I2C évités en veille (estimation)
+  uint32_t savedBusBytes;       ///< Reste en octets (< 1024 après report)
+  uint16_t wakeCount;           ///< Réveils (encodeur, alerte bloquante)
+  
 public:
   /**
    * @brief Constructeur
    * @param sysState Référence à l'état système
    */
   DisplayManager(SystemState& sysState) 
-    : lcd(nullptr),
-      encoder(nullptr),
+    : lcd(I2C_LCD),
+      encoder(PIN_ENCODER_CLK, PIN_ENCODER_DT, PIN_ENCODER_SW),
       state(sysState),
       lastUpdate(0),
       lastEncoderActivity(0),
+      lastLcdRetry(0),
+      messageHead(0),
+      messageCount(0),
+      messageStart(0),
+      messageShown(false),
       initialized(false),
-      forceRedraw(true)
+      forceRedraw(true),
+      refreshScale(1),
+      power(DisplayPower::AWAKE),
+      frameWrites(0),
+      skippedFrames(0),
+      savedKilobytes(0),
+      savedBusBytes(0),
+      wakeCount(0)
   {
   }
   
-  /**
-   * @brief Destructeur
-   */
-  ~DisplayManager() {
-    if (lcd) delete lcd;
-    if (encoder) delete encoder;
-  }
-  
   // ============================================
   // INITIALISATION
   // ============================================
@@ -91,34 +156,27 @@ public:
     DEBUG_PRINTLN(F("=== INITIALISATION AFFICHAGE ==="));
     
     // Initialiser LCD
-    lcd = new LCDDisplay(I2C_LCD);
-    if (lcd->begin()) {
+    if (lcd.begin()) {
       state.sensors.lcd = true;
-      DEBUG_PRINTLN(F("[OK] LCD initialise"));
+      LOG_INFO("LCD initialise");
       
       // Afficher écran de démarrage
       showBootScreen();
     } else {
-      DEBUG_PRINTLN(F("[ECHEC] LCD non detecte"));
+      LOG_WARN("LCD non detecte");
       state.sensors.lcd = false;
       return false;
     }
     
     // Initialiser encodeur
-    encoder = new KY040Encoder(PIN_ENCODER_CLK, PIN_ENCODER_DT, PIN_ENCODER_SW);
-    if (encoder->begin()) {
+    if (encoder.begin()) {
       state.sensors.encoder = true;
-      DEBUG_PRINTLN(F("[OK] Encodeur initialise"));
+      LOG_INFO("Encodeur initialise");
     } else {
-      DEBUG_PRINTLN(F("[ECHEC] Encodeur non initialise"));
+      LOG_WARN("Encodeur non initialise");
       state.sensors.encoder = false;
     }
     
-    // Créer caractères personnalisés
-    lcd->createChar(0, (uint8_t*)CHAR_DEGREE);
-    lcd->createChar(1, (uint8_t*)CHAR_ALERT);
-    lcd->createChar(2, (uint8_t*)CHAR_BATTERY);
-    
     initialized = true;
     lastEncoderActivity = millis();
     
@@ -131,10 +189,11 @@ public:
   void showBootScreen() {
     if (!state.sensors.lcd) return;
     
-    lcd->clear();
-    lcd->printCenter("VAN COMPUTER", 0);
-    lcd->printCenter("v" FIRMWARE_VERSION, 1);
-    lcd->printCenter("Initialisation...", 3);
+    lcd.clear();
+    lcd.printCenter("VAN COMPUTER", 0);
+    lcd.printCenter("v" FIRMWARE_VERSION, 1);
+    lcd.printCenter("Initialisation...", 3);
+    frame.invalidate();
   }
   
   // ============================================
@@ -153,63 +212,172 @@ public:
     
     unsigned long now = millis();
     
+    // Historique : échantillonné même écran en veille
+    history.update(state, now);
+    
     // Mettre à jour encodeur
     if (state.sensors.encoder) {
-      encoder->update();
+      encoder.update();
       handleEncoder();
     }
     
     // Gérer timeout rétro-éclairage
     handleBacklightTimeout();
     
-    // Rafraîchir écran selon intervalle
-    if (now - lastUpdate >= INTERVAL_DISPLAY || forceRedraw) {
+    // LCD perdu (expiration I2C) : les messages expirent quand même
+    if (!lcd.isReady()) {
+      updateMessages(now);
+      recoverLcd(now);
+      return;
+    }
+    
+    // Alerte bloquante : l'écran doit être lisible
+    if (power == DisplayPower::ASLEEP && state.alerts.blockNavigation) {
+      wake();
+    }
+    
+    unsigned long interval = (unsigned long)settings.values.intervalDisplay * refreshScale;
+    
+    // Veille : messages expirés sans affichage, rendu compté comme évité
+    if (power == DisplayPower::ASLEEP) {
+      updateMessages(now);
+      if (now - lastUpdate >= interval) {
+        lastUpdate = now;
+        skippedFrames++;
+        savedBusBytes += (uint32_t)frameWrites * LCD_I2C_BYTES_PER_WRITE;
+        savedKilobytes += savedBusBytes / 1024;
+        savedBusBytes %= 1024;
+      }
+      return;
+    }
+    
+    // Message temporaire en surimpression (sauf alerte bloquante)
+    if (updateMessages(now) && !state.alerts.blockNavigation) {
+      return;
+    }
+    
+    // Rafraîchir écran selon intervalle (ralenti par le profil)
+    if (now - lastUpdate >= interval || forceRedraw) {
       lastUpdate = now;
+      uint32_t before = lcd.getWriteCount();
       refreshScreen();
+      frameWrites = lcd.getWriteCount() - before;
       forceRedraw = false;
     }
   }
   
+  /**
+   * @brief Met l'affichage en veille (rétro-éclairage éteint)
+   * 
+   * @details Plus aucun accès LCD jusqu'au réveil : le contenu affiché
+   * n'est plus tenu à jour.
+   */
+  void sleep() {
+    if (power == DisplayPower::ASLEEP) return;
+    lcd.backlightOff();
+    state.backlightOn = false;
+    power = DisplayPower::ASLEEP;
+  }
+  
+  /**
+   * @brief Réveille l'affichage et resynchronise l'écran
+   * 
+   * @details Effacement puis image complète : l'écran figé depuis la
+   * mise en veille ne doit pas apparaître. Le message en cours est
+   * réaffiché avec sa durée complète.
+   */
+  void wake() {
+    if (power == DisplayPower::AWAKE) return;
+    lcd.backlightOn();
+    lcd.clear();
+    frame.invalidate();
+    state.backlightOn = true;
+    power = DisplayPower::AWAKE;
+    messageShown = false;
+    forceRedraw = true;
+    if (wakeCount < 0xFFFF) wakeCount++;
+  }
+  
+  /**
+   * @brief Ré-initialise le LCD après une expiration I2C
+   * @param now millis()
+   * 
+   * @details Une tentative toutes les LCD_RETRY_INTERVAL ms ; l'écran
+   * courant est redessiné en entier une fois le LCD revenu.
+   */
+  void recoverLcd(unsigned long now) {
+    if (state.sensors.lcd) {
+      state.sensors.lcd = false;
+      lastLcdRetry = now;
+      LOG_WARN("LCD perdu (bus I2C)");
+      return;
+    }
+    
+    if (now - lastLcdRetry < LCD_RETRY_INTERVAL) return;
+    lastLcdRetry = now;
+    
+    if (lcd.begin()) {
+      frame.invalidateGlyphs();
+      state.sensors.lcd = true;
+      state.backlightOn = true;
+      power = DisplayPower::AWAKE;
+      frame.invalidate();
+      forceRedraw = true;
+      messageShown = false;
+      LOG_INFO("LCD reinitialise");
+    }
+  }
+  
   /**
    * @brief Gère les événements de l'encodeur
+   * 
+   * @details Vide la file d'événements remplie par l'ISR :
+   * chaque cran est traité, même après une loop() lente.
    */
   void handleEncoder() {
-    // Rotation détectée
-    if (encoder->hasRotated()) {
+    EncoderEvent event;
+    while (encoder.popEvent(event)) {
       lastEncoderActivity = millis();
       state.lastEncoderActivity = lastEncoderActivity;
       
-      // Activer rétro-éclairage si éteint
-      if (!state.backlightOn) {
-        lcd->backlightOn();
-        state.backlightOn = true;
-        return; // Premier clic juste rallume
+      // Écran en veille : le premier événement ne fait que réveiller
+      if (power == DisplayPower::ASLEEP) {
+        wake();
+        continue;
       }
       
-      // Pas de navigation si alerte bloquante
-      if (state.alerts.blockNavigation) {
-        return;
+      switch (event) {
+        case EncoderEvent::ROTATE_CW:
+        case EncoderEvent::ROTATE_CCW:
+          // Pas de navigation si alerte bloquante
+          if (state.alerts.blockNavigation) {
+            break;
+          }
+          
+          // Changer d'écran selon direction
+          if (event == EncoderEvent::ROTATE_CW) {
+            nextScreen();
+          } else {
+            previousScreen();
+          }
+          forceRedraw = true;
+          break;
+          
+        case EncoderEvent::BUTTON_CLICKED:
+          handleButtonEvent(ButtonEvent::CLICKED);
+          forceRedraw = true;
+          break;
+          
+        case EncoderEvent::BUTTON_LONG_PRESS:
+          handleButtonEvent(ButtonEvent::LONG_PRESS);
+          forceRedraw = true;
+          break;
+          
+        default:
+          // Appui : réveil / activité uniquement
+          forceRedraw = true;
+          break;
       }
-      
-      // Changer d'écran selon direction
-      RotationDirection dir = encoder->getDirection();
-      if (dir == RotationDirection::CLOCKWISE) {
-        nextScreen();
-      } else if (dir == RotationDirection::COUNTER_CLOCKWISE) {
-        previousScreen();
-      }
-      
-      forceRedraw = true;
-    }
-    
-    // Bouton pressé
-    ButtonEvent event = encoder->getButtonEvent();
-    if (event != ButtonEvent::NONE) {
-      lastEncoderActivity = millis();
-      state.lastEncoderActivity = lastEncoderActivity;
-      
-      handleButtonEvent(event);
-      forceRedraw = true;
     }
   }
   
@@ -317,14 +485,14 @@ public:
    * @brief Gère le timeout du rétro-éclairage
    */
   void handleBacklightTimeout() {
-    if (LCD_BACKLIGHT_TIMEOUT == 0) return; // Désactivé
+    if (settings.values.backlightTimeout == 0) return; // Désactivé
     
     unsigned long now = millis();
     unsigned long idle = now - lastEncoderActivity;
     
-    if (idle >= LCD_BACKLIGHT_TIMEOUT && state.backlightOn) {
-      lcd->backlightOff();
-      state.backlightOn = false;
+    // Jamais de veille pendant une alerte bloquante
+    if (idle >= settings.values.backlightTimeout && !state.alerts.blockNavigation) {
+      sleep();
     }
   }
   
@@ -336,7 +504,7 @@ public:
     unsigned long idle = now - lastEncoderActivity;
     
     // Retour HOME après 5 min d'inactivité
-    if (idle >= ENCODER_TIMEOUT && state.currentScreen != Screen::SCREEN_HOME) {
+    if (idle >= settings.values.screenTimeout && state.currentScreen != Screen::SCREEN_HOME) {
       state.currentScreen = Screen::SCREEN_HOME;
       forceRedraw = true;
     }
@@ -348,248 +516,111 @@ public:
   
   /**
    * @brief Rafraîchit l'écran actuel
+   * 
+   * @details Dessin dans l'image (LCDFramebuffer), puis envoi des
+   * seules cellules modifiées.
    */
   void refreshScreen() {
     if (!state.sensors.lcd) return;
     
-    // Mode pré-chauffage
+    frame.beginFrame();
+    
     if (state.mode == SystemMode::MODE_PREHEAT) {
+      // Mode pré-chauffage
       showPreheatScreen();
-      return;
-    }
-    
-    // Mode alerte bloquante
-    if (state.alerts.blockNavigation) {
+    } else if (state.alerts.blockNavigation) {
+      // Mode alerte bloquante
       showAlertScreen();
-      return;
+    } else {
+      // Afficher l'écran courant
+      switch (state.currentScreen) {
+        case Screen::SCREEN_ENVIRONMENT:
+          renderer.render(&SCREEN_ENVIRONMENT_TEMPLATE, frame, state);
+          TrendGraph::draw(frame, LCD_COLS - TREND_SAMPLES, 2, TREND_SAMPLES,
+                           history, TrendSeries::HUMIDITY, TREND_SPAN_HUMIDITY);
+          break;
+        case Screen::SCREEN_ENERGY:
+          renderer.render(&SCREEN_ENERGY_TEMPLATE, frame, state);
+          TrendGraph::draw(frame, LCD_COLS - TREND_SAMPLES, 3, TREND_SAMPLES,
+                           history, TrendSeries::VOLTAGE_12V, TREND_SPAN_12V);
+          break;
+        case Screen::SCREEN_SAFETY:
+          showSafetyScreen();
+          break;
+        case Screen::SCREEN_LEVEL:
+          showLevelScreen();
+          break;
+        case Screen::SCREEN_SETTINGS:
+          showSettingsScreen();
+          break;
+        case Screen::SCREEN_HOME:
+        default:
+          showHomeScreen();
+          break;
+      }
     }
     
-    // Afficher l'écran courant
-    switch (state.currentScreen) {
-      case Screen::SCREEN_HOME:
-        showHomeScreen();
-        break;
-      case Screen::SCREEN_ENVIRONMENT:
-        showEnvironmentScreen();
-        break;
-      case Screen::SCREEN_ENERGY:
-        showEnergyScreen();
-        break;
-      case Screen::SCREEN_SAFETY:
-        showSafetyScreen();
-        break;
-      case Screen::SCREEN_LEVEL:
-        showLevelScreen();
-        break;
-      case Screen::SCREEN_SETTINGS:
-        showSettingsScreen();
-        break;
-      default:
-        showHomeScreen();
-        break;
-    }
+    frame.flush(lcd);
   }
   
   /**
-   * @brief Affiche l'écran HOME
+   * @brief Affiche l'écran HOME (SCREEN_HOME_TEMPLATE)
    * 
-   * Format :
-   * ┌────────────────────┐
-   * │INT:23° - EXT:15°   │  Ligne 0 : Températures
-   * │65% - P: 1013       │  Ligne 1 : Humidité + Pression
-   * │ X:+2° Y:-1°        │  Ligne 2 : Horizontalité
-   * │12.3V-5.0V ████     │  Ligne 3 : Tensions + Barre
-   * └────────────────────┘
+   * @details Gabarit, puis barre de puissance (ligne 3) et icône
+   * d'alerte WARNING/INFO (coin supérieur droit) : nuage si l'alerte
+   * principale concerne un gaz, point d'exclamation sinon.
    */
   void showHomeScreen() {
-    lcd->clear();
-    
-    char buffer[21];
-    
-    // Ligne 0 : Températures
-    snprintf(buffer, sizeof(buffer), "INT:%d%c - EXT:%d%c",
-             (int)state.environment.tempInterior, (char)0xDF,
-             (int)state.environment.tempExterior, (char)0xDF);
-    lcd->printAt(0, 0, buffer);
-    
-    // Ligne 1 : Humidité + Pression
-    snprintf(buffer, sizeof(buffer), "%d%% - P:%d",
-             (int)state.environment.humidity,
-             (int)state.environment.pressure);
-    lcd->printAt(0, 1, buffer);
-    
-    // Ligne 2 : Horizontalité
-    snprintf(buffer, sizeof(buffer), " X:%+d%c Y:%+d%c",
-             (int)state.level.roll, (char)0xDF,
-             (int)state.level.pitch, (char)0xDF);
-    lcd->printAt(0, 2, buffer);
-    
-    // Ligne 3 : Tensions + Barre puissance
-    snprintf(buffer, sizeof(buffer), "%.1fV-%.1fV ",
-             state.power.voltage12V,
-             state.power.voltage5V);
-    lcd->printAt(0, 3, buffer);
+    renderer.render(&SCREEN_HOME_TEMPLATE, frame, state);
     
     // Barre puissance (4 caractères)
     drawPowerBar(11, 3, 4);
     
     // Icône alerte si WARNING/INFO
-    if (state.alerts.currentLevel == AlertLevel::WARNING ||
-        state.alerts.currentLevel == AlertLevel::INFO) {
-      lcd->printCustomChar(19, 0, 1); // Icône alerte
+    bool warning = state.alerts.currentLevel == AlertLevel::WARNING ||
+                   state.alerts.currentLevel == AlertLevel::INFO;
+    char icon = ' ';
+    if (warning) {
+      bool gas = false;
+      if (state.alerts.activeAlertCount > 0) {
+        AlertType type = state.alerts.alerts[0].type;
+        gas = type == AlertType::CO_HIGH || type == AlertType::GPL_HIGH ||
+              type == AlertType::SMOKE_HIGH;
+      }
+      icon = frame.glyph(gas ? GlyphId::GAS : GlyphId::ALERT);
     }
+    frame.put(19, 0, icon);
   }
   
   /**
-   * @brief Affiche l'écran ENVIRONMENT
+   * @brief Affiche l'écran LEVEL (SCREEN_LEVEL_TEMPLATE)
    * 
-   * Format :
-   * ┌────────────────────┐
-   * │=== ENVIRONNEMENT ===│
-   * │Int:23.5° Ext:15.2° │
-   * │Humid: 65%          │
-   * │Press: 1013 hPa     │
-   * └────────────────────┘
+   * @details Gabarit (Roll/Pitch), puis bulle (colonnes 0-8) et
+   * hauteurs de calage avant/arrière (lignes 2-3).
    */
-  void showEnvironmentScreen() {
-    lcd->clear();
-    
-    char buffer[21];
-    
-    // Titre
-    lcd->printCenter("ENVIRONNEMENT", 0);
-    
-    // Températures
-    snprintf(buffer, sizeof(buffer), "Int:%.1f%c Ext:%.1f%c",
-             state.environment.tempInterior, (char)0xDF,
-             state.environment.tempExterior, (char)0xDF);
-    lcd->printAt(0, 1, buffer);
-    
-    // Humidité
-    snprintf(buffer, sizeof(buffer), "Humid: %d%%",
-             (int)state.environment.humidity);
-    lcd->printAt(0, 2, buffer);
-    
-    // Pression
-    snprintf(buffer, sizeof(buffer), "Press: %d hPa",
-             (int)state.environment.pressure);
-    lcd->printAt(0, 3, buffer);
+  void showLevelScreen() {
+    renderer.render(&SCREEN_LEVEL_TEMPLATE, frame, state);
+    BubbleLevel::drawBubble(frame, state.level);
+    BubbleLevel::drawGuidance(frame, state.level);
   }
   
   /**
-   * @brief Affiche l'écran ENERGY
+   * @brief Affiche l'écran SAFETY (SCREEN_SAFETY_TEMPLATE)
    * 
-   * Format :
-   * ┌────────────────────┐
-   * │===== ENERGIE ======│
-   * │12V: 12.3V - 5.2A   │
-   * │ 5V:  5.0V - 1.8A   │
-   * │Total: 68.5 W       │
-   * └────────────────────┘
-   */
-  void showEnergyScreen() {
-    lcd->clear();
-    
-    char buffer[21];
-    
-    // Titre
-    lcd->printCenter("ENERGIE", 0);
-    
-    // Rail 12V
-    snprintf(buffer, sizeof(buffer), "12V: %.1fV - %.1fA",
-             state.power.voltage12V,
-             state.power.current12V);
-    lcd->printAt(0, 1, buffer);
-    
-    // Rail 5V
-    snprintf(buffer, sizeof(buffer), " 5V: %.1fV - %.1fA",
-             state.power.voltage5V,
-             state.power.current5V);
-    lcd->printAt(0, 2, buffer);
-    
-    // Puissance totale
-    snprintf(buffer, sizeof(buffer), "Total: %.1f W",
-             state.power.powerTotal);
-    lcd->printAt(0, 3, buffer);
-  }
-  
-  /**
-   * @brief Affiche l'écran SAFETY
-   * 
-   * Format :
-   * ┌────────────────────┐
-   * │===== SECURITE =====│
-   * │CO:    50 ppm  [OK] │
-   * │GPL:  150 ppm  [OK] │
-   * │Fumee: 80 ppm  [OK] │
-   * └────────────────────┘
+   * @details Gabarit, puis statut de chaque gaz en colonne 14.
    */
   void showSafetyScreen() {
-    lcd->clear();
-    
-    char buffer[21];
-    
-    // Titre
-    lcd->printCenter("SECURITE", 0);
-    
-    // CO
-    const char* coStatus = getGasStatus(state.safety.coPPM, 
-                                        CO_THRESHOLD_WARNING,
-                                        CO_THRESHOLD_DANGER);
-    snprintf(buffer, sizeof(buffer), "CO:  %4d ppm %s",
-             (int)state.safety.coPPM, coStatus);
-    lcd->printAt(0, 1, buffer);
-    
-    // GPL
-    const char* gplStatus = getGasStatus(state.safety.gplPPM,
-                                         GPL_THRESHOLD_WARNING,
-                                         GPL_THRESHOLD_DANGER);
-    snprintf(buffer, sizeof(buffer), "GPL: %4d ppm %s",
-             (int)state.safety.gplPPM, gplStatus);
-    lcd->printAt(0, 2, buffer);
-    
-    // Fumée
-    const char* smokeStatus = getGasStatus(state.safety.smokePPM,
-                                           SMOKE_THRESHOLD_WARNING,
-                                           SMOKE_THRESHOLD_DANGER);
-    snprintf(buffer, sizeof(buffer), "Fum: %4d ppm %s",
-             (int)state.safety.smokePPM, smokeStatus);
-    lcd->printAt(0, 3, buffer);
-  }
-  
-  /**
-   * @brief Affiche l'écran LEVEL
-   * 
-   * Format :
-   * ┌────────────────────┐
-   * │=== HORIZONTALITE ===│
-   * │Roll:  +2.5°        │
-   * │Pitch: -1.3°        │
-   * │Total:  2.8°        │
-   * └────────────────────┘
-   */
-  void showLevelScreen() {
-    lcd->clear();
-    
-    char buffer[21];
-    
-    // Titre
-    lcd->printCenter("HORIZONTALITE", 0);
-    
-    // Roll
-    snprintf(buffer, sizeof(buffer), "Roll:  %+.1f%c",
-             state.level.roll, (char)0xDF);
-    lcd->printAt(0, 1, buffer);
+    renderer.render(&SCREEN_SAFETY_TEMPLATE, frame, state);
     
-    // Pitch
-    snprintf(buffer, sizeof(buffer), "Pitch: %+.1f%c",
-             state.level.pitch, (char)0xDF);
-    lcd->printAt(0, 2, buffer);
-    
-    // Inclinaison totale
-    snprintf(buffer, sizeof(buffer), "Total: %.1f%c",
-             state.level.totalTilt, (char)0xDF);
-    lcd->printAt(0, 3, buffer);
+    frame.print(14, 1, getGasStatus(state.safety.coPPM,
+                                    settings.values.coWarning,
+                                    settings.values.coDanger));
+    frame.print(14, 2, getGasStatus(state.safety.gplPPM,
+                                    settings.values.gplWarning,
+                                    settings.values.gplDanger));
+    frame.print(14, 3, getGasStatus(state.safety.smokePPM,
+                                    settings.values.smokeWarning,
+                                    settings.values.smokeDanger));
   }
   
   /**
@@ -597,29 +628,24 @@ public:
    * 
    * Format :
    * ┌────────────────────┐
-   * │===== PARAMETRES ====│
-   * │MPU6050:            │
+   * │     PARAMETRES     │
+   * │MPU6050:CAL OK      │
    * │ [Clic:Calibration] │
    * │ [Long:Quitter]     │
    * └────────────────────┘
    */
   void showSettingsScreen() {
-    lcd->clear();
+    renderer.reset();
     
     // Titre
-    lcd->printCenter("PARAMETRES", 0);
+    frame.printCenter("PARAMETRES", 0);
     
-    // Options
-    lcd->printAt(0, 1, "MPU6050:");
-    lcd->printAt(1, 2, "[Clic:Calibration]");
-    lcd->printAt(1, 3, "[Long:Quitter]");
+    // État calibration
+    frame.printLine(1, state.level.calibrated ? "MPU6050:CAL OK" : "MPU6050:NON CAL");
     
-    // Afficher état calibration
-    if (state.level.calibrated) {
-      lcd->printAt(8, 1, "CAL OK");
-    } else {
-      lcd->printAt(8, 1, "NON CAL");
-    }
+    // Options
+    frame.printLine(2, "[Clic:Calibration]", 1);
+    frame.printLine(3, "[Long:Quitter]", 1);
   }
   
   /**
@@ -629,17 +655,18 @@ public:
    * ┌────────────────────┐
    * │  PRE-CHAUFFE GAZ   │
    * │                    │
-   * │ [████████░░░░░░]   │
+   * │ [████████......]   │
    * │   2min 30s         │
    * └────────────────────┘
    */
   void showPreheatScreen() {
-    lcd->clear();
+    renderer.reset();
     
     char buffer[21];
     
     // Titre
-    lcd->printCenter("PRE-CHAUFFE GAZ", 0);
+    frame.printCenter("PRE-CHAUFFE GAZ", 0);
+    frame.fill(0, 1, LCD_COLS);
     
     // Calculer temps restant
     unsigned long elapsed = millis() - state.preheatStartTime;
@@ -654,24 +681,21 @@ public:
     uint8_t percent = (elapsed * 100) / maxTime;
     if (percent > 100) percent = 100;
     
-    lcd->setCursor(1, 2);
-    lcd->getLCD().print('[');
+    frame.put(0, 2, ' ');
+    frame.put(1, 2, '[');
     uint8_t filled = (14 * percent) / 100;
     for (uint8_t i = 0; i < 14; i++) {
-      if (i < filled) {
-        lcd->getLCD().write(0xFF);
-      } else {
-        lcd->getLCD().write('.');
-      }
+      frame.put(2 + i, 2, i < filled ? (char)0xFF : '.');
     }
-    lcd->getLCD().print(']');
+    frame.put(16, 2, ']');
+    frame.fill(17, 2, LCD_COLS - 17);
     
     // Temps restant
     uint16_t remainingSec = remaining / 1000;
     uint8_t minutes = remainingSec / 60;
     uint8_t seconds = remainingSec % 60;
-    snprintf(buffer, sizeof(buffer), "   %dmin %02ds", minutes, seconds);
-    lcd->printAt(0, 3, buffer);
+    snprintf(buffer, sizeof(buffer), "%dmin %02ds", minutes, seconds);
+    frame.printLine(3, buffer, 3);
   }
   
   /**
@@ -686,32 +710,41 @@ public:
    * └────────────────────┘
    */
   void showAlertScreen() {
-    lcd->clear();
+    renderer.reset();
     
     char buffer[21];
     
     // Titre avec niveau
     snprintf(buffer, sizeof(buffer), "!!! %s !!!",
              alertLevelToString(state.alerts.currentLevel));
-    lcd->printCenter(buffer, 0);
+    frame.printCenter(buffer, 0);
     
     // Message de l'alerte principale
-    if (state.alerts.activeAlertCount > 0) {
-      Alert alert = state.alerts.alerts[0];
-      
-      // Message
-      lcd->printCenter(alert.message, 1);
-      
-      // Valeur
-      snprintf(buffer, sizeof(buffer), "%.0f", alert.value);
-      lcd->printCenter(buffer, 2);
-      
-      // Action selon niveau
-      if (alert.level == AlertLevel::CRITICAL) {
-        lcd->printCenter("EVACUEZ!", 3);
-      } else if (alert.level == AlertLevel::DANGER) {
-        lcd->printCenter("ATTENTION!", 3);
-      }
+    if (state.alerts.activeAlertCount == 0) {
+      frame.fill(0, 1, LCD_COLS);
+      frame.fill(0, 2, LCD_COLS);
+      frame.fill(0, 3, LCD_COLS);
+      return;
+    }
+    
+    const Alert& alert = state.alerts.alerts[0];
+    
+    // Message
+    strncpy_P(buffer, (const char*)alertMessage(alert), sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+    frame.printCenter(buffer, 1);
+    
+    // Valeur
+    FixedFormat::format(buffer, alert.value, alertDecimals(alert.type), 0);
+    frame.printCenter(buffer, 2);
+    
+    // Action selon niveau
+    if (alert.level == AlertLevel::CRITICAL) {
+      frame.printCenter("EVACUEZ!", 3);
+    } else if (alert.level == AlertLevel::DANGER) {
+      frame.printCenter("ATTENTION!", 3);
+    } else {
+      frame.fill(0, 3, LCD_COLS);
     }
   }
   
@@ -724,22 +757,17 @@ public:
    * @param col Colonne de départ
    * @param row Ligne
    * @param width Largeur en caractères
+   * 
+   * @details Pleine échelle 200 W, calcul en dixièmes de watt
+   * (powerTotal brut).
    */
   void drawPowerBar(uint8_t col, uint8_t row, uint8_t width) {
-    // Calculer pourcentage charge
-    const float MAX_POWER = 200.0;
-    float percent = (state.power.powerTotal / MAX_POWER) * 100.0;
-    percent = constrain(percent, 0.0, 100.0);
+    const int16_t MAX_POWER_TENTHS = 2000;
+    int16_t power = constrain(state.power.powerTotal.raw, 0, MAX_POWER_TENTHS);
+    uint8_t filled = ((int32_t)power * width) / MAX_POWER_TENTHS;
     
-    uint8_t filled = (width * percent) / 100;
-    
-    lcd->setCursor(col, row);
     for (uint8_t i = 0; i < width; i++) {
-      if (i < filled) {
-        lcd->getLCD().write(0xFF); // Bloc plein
-      } else {
-        lcd->getLCD().write('.');  // Vide
-      }
+      frame.put(col + i, row, i < filled ? (char)0xFF : '.');
     }
   }
   
@@ -748,11 +776,11 @@ public:
    * @param ppm Concentration
    * @param warning Seuil WARNING
    * @param danger Seuil DANGER
-   * @return Statut "[OK]" / "[!]" / "[X]"
+   * @return Statut "[OK]" / "[!] " / "[X] " (4 caractères)
    */
   const char* getGasStatus(float ppm, float warning, float danger) {
-    if (ppm >= danger) return "[X]";      // Danger
-    if (ppm >= warning) return "[!]";     // Warning
+    if (ppm >= danger) return "[X] ";     // Danger
+    if (ppm >= warning) return "[!] ";    // Warning
     return "[OK]";                         // OK
   }
   
@@ -777,6 +805,14 @@ public:
     lastEncoderActivity = millis();
   }
   
+  /**
+   * @brief Ralentit le rafraîchissement de l'écran (profil de fonctionnement)
+   * @param scale Multiplicateur de l'intervalle d'affichage (1 = registre)
+   */
+  void setRefreshScale(uint8_t scale) {
+    refreshScale = scale ? scale : 1;
+  }
+  
   /**
    * @brief Active/désactive le rétro-éclairage
    * @param on true pour allumer
@@ -785,27 +821,123 @@ public:
     if (!state.sensors.lcd) return;
     
     if (on) {
-      lcd->backlightOn();
+      wake();
     } else {
-      lcd->backlightOff();
+      sleep();
     }
-    state.backlightOn = on;
   }
   
   /**
-   * @brief Affiche un message temporaire
+   * @brief Affiche un message temporaire (non-bloquant)
    * @param message Message à afficher
-   * @param duration Durée d'affichage (ms)
+   * @param duration Durée d'affichage (ms, 0 = jusqu'au prochain rafraîchissement)
+   * 
+   * @details
+   * Le message est placé en file d'attente et affiché en surimpression
+   * de l'écran courant. Il expire par horodatage dans update(), puis
+   * le message suivant (ou l'écran normal) est affiché.
+   * Un message de durée 0 cède immédiatement sa place au suivant.
    */
   void showMessage(const char* message, uint16_t duration = 2000) {
     if (!state.sensors.lcd) return;
     
-    lcd->clear();
-    lcd->printCenter(message, 1);
-    delay(duration);
+    // Message instantané déjà affiché : remplacé par le nouveau
+    if (messageShown && messageQueue[messageHead].duration == 0) {
+      popMessage();
+    }
+    
+    // File pleine : le dernier message en attente est remplacé
+    uint8_t slot;
+    if (messageCount < LCD_MESSAGE_QUEUE_SIZE) {
+      slot = (messageHead + messageCount) % LCD_MESSAGE_QUEUE_SIZE;
+      messageCount++;
+    } else {
+      slot = (messageHead + messageCount - 1) % LCD_MESSAGE_QUEUE_SIZE;
+    }
+    
+    strncpy(messageQueue[slot].text, message, LCD_COLS);
+    messageQueue[slot].text[LCD_COLS] = '\0';
+    messageQueue[slot].duration = duration;
+    
+    // Affichage immédiat si aucun message en cours (utile pendant setup())
+    if (!messageShown) {
+      drawMessage();
+    }
+  }
+  
+  /**
+   * @brief Vérifie si des événements encodeur attendent d'être traités
+   * @return true si la file de l'encodeur n'est pas vide
+   */
+  bool hasPendingInput() const {
+    return state.sensors.encoder && encoder.hasEvent();
+  }
+  
+  /**
+   * @brief Vérifie si un message temporaire est affiché ou en attente
+   * @return true si la file n'est pas vide
+   */
+  bool hasMessage() const {
+    return messageCount > 0;
+  }
+  
+  /**
+   * @brief Supprime tous les messages temporaires
+   */
+  void clearMessages() {
+    messageCount = 0;
+    messageShown = false;
     forceRedraw = true;
   }
   
+  /**
+   * @brief Gère l'expiration des messages temporaires
+   * @param now Timestamp actuel
+   * @return true si un message occupe encore l'écran
+   */
+  bool updateMessages(unsigned long now) {
+    if (messageCount == 0) return false;
+    
+    if (messageShown && now - messageStart >= messageQueue[messageHead].duration) {
+      popMessage();
+      forceRedraw = true;
+      
+      if (messageCount == 0) return false;
+    }
+    
+    if (!messageShown) {
+      drawMessage();
+    }
+    
+    return true;
+  }
+  
+  /**
+   * @brief Affiche le message en tête de file
+   */
+  void drawMessage() {
+    messageStart = millis();
+    messageShown = true;
+    
+    // Ne jamais masquer un écran d'alerte bloquante ; rien en veille
+    if (state.alerts.blockNavigation || power == DisplayPower::ASLEEP) return;
+    
+    lcd.clear();
+    lcd.printCenter(messageQueue[messageHead].text, 1);
+    frame.invalidate();
+  }
+  
+  /**
+   * @brief Retire le message en tête de file
+   */
+  void popMessage() {
+    if (messageCount == 0) return;
+    
+    messageHead = (messageHead + 1) % LCD_MESSAGE_QUEUE_SIZE;
+    messageCount--;
+    messageShown = false;
+  }
+  
   // ============================================
   // GETTERS
   // ============================================
@@ -833,6 +965,81 @@ public:
   bool isBacklightOn() const {
     return state.backlightOn;
   }
+  
+  /**
+   * @brief État d'alimentation de l'affichage
+   */
+  DisplayPower getPowerState() const {
+    return power;
+  }
+  
+  /**
+   * @brief Vérifie si l'écran LEVEL est visible
+   * @return true si affiché, écran allumé et hors alerte/pré-chauffage
+   * 
+   * @details Utilisé pour accélérer la lecture du MPU6050 pendant la
+   * mise à niveau (SensorManager::setLevelling()).
+   */
+  bool isLevelling() const {
+    return power == DisplayPower::AWAKE && state.sensors.lcd &&
+           !state.alerts.blockNavigation &&
+           state.mode != SystemMode::MODE_PREHEAT &&
+           state.currentScreen == Screen::SCREEN_LEVEL;
+  }
+  
+  /**
+   * @brief Rafraîchissements évités en veille (cumul)
+   */
+  uint32_t getSkippedFrames() const {
+    return skippedFrames;
+  }
+  
+  /**
+   * @brief Trafic I2C évité en veille (cumul, estimation)
+   * @return Kio : octets HD44780 évités × LCD_I2C_BYTES_PER_WRITE
+   */
+  uint32_t getSavedI2CKilobytes() const {
+    return savedKilobytes;
+  }
+  
+  /**
+   * @brief Nombre de réveils de l'affichage
+   */
+  uint16_t getWakeCount() const {
+    return wakeCount;
+  }
+  
+  /**
+   * @brief Cellules envoyées au LCD par l'image (cumul)
+   */
+  uint32_t getFlushedCells() const {
+    return frame.getFlushedCells();
+  }
+  
+  /**
+   * @brief Champs de gabarit reformatés / laissés tels quels (cumul)
+   */
+  uint32_t getFormattedSlots() const {
+    return renderer.getFormattedCount();
+  }
+  
+  uint32_t getUnchangedSlots() const {
+    return renderer.getUnchangedCount();
+  }
+  
+  /**
+   * @brief Cache des caractères personnalisés (statistiques)
+   */
+  const GlyphCache& getGlyphCache() const {
+    return frame.getGlyphCache();
+  }
+  
+  /**
+   * @brief Échantillons de tendance conservés
+   */
+  uint8_t getTrendSamples() const {
+    return history.getCount();
+  }
 };
 
 #endif // DISPLAY_MANAGER_H
@@ -0,0 +1,183 @@
+/**
+ * @file FixedFormat.h
+ * @brief Formatage entier des nombres à virgule fixe (sans printf flottant)
+ * @author Frédéric BAILLON
+ * @version 0.1.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Sur AVR, dtostrf() et les "%f" coûtent plusieurs centaines de µs
+ * (émulation flottante) et vsnprintf() n'accepte pas "%f" (affiche
+ * "?"). Les mesures sont déjà stockées en entiers à l'échelle connue
+ * (Fixed16, alertes) : le texte est produit par divisions entières
+ * sur la valeur brute.
+ *
+ * - Un seul arrondi (au plus proche) vers les décimales demandées
+ * - Pas de "-0" : une valeur arrondie à zéro perd son signe
+ * - Signe '+' optionnel, unité d'un caractère (symbole degré compris)
+ * - Largeur fixe : complété d'espaces, rempli de '#' si trop long
+ *
+ * Utilisé par les écrans LCD (ScreenTemplate.h), les messages série
+ * et la commande console "bench" (comparaison à snprintf/dtostrf).
+ */
+
+#ifndef FIXED_FORMAT_H
+#define FIXED_FORMAT_H
+
+#include <Arduino.h>
+
+// ============================================
+// CONFIGURATION
+// ============================================
+#define FIXED_FORMAT_SIGN       0x01    ///< Signe '+' forcé pour les valeurs positives
+#define FIXED_FORMAT_LEFT       0x02    ///< Aligné à gauche (droite par défaut)
+#define FIXED_FORMAT_OVERFLOW   '#'     ///< Remplissage si la valeur dépasse la largeur
+#define FIXED_FORMAT_DEGREE     '\xDF'  ///< Symbole degré (ROM HD44780 A00)
+#define FIXED_FORMAT_MAX        16      ///< Taille de buffer suffisante pour format()
+
+template<int16_t SCALE> struct Fixed16;
+
+// ============================================
+// CLASSE FixedFormat
+// ============================================
+/**
+ * @class FixedFormat
+ * @brief Conversion entier à virgule fixe -> texte
+ */
+class FixedFormat {
+private:
+  /**
+   * @brief Construit le texte à l'envers (unité, décimales, point, entier, signe)
+   * @param text Buffer (FIXED_FORMAT_MAX octets)
+   * @return Longueur
+   */
+  static uint8_t reversed(char* text, int32_t raw, uint8_t rawDecimals,
+                          uint8_t decimals, uint8_t flags, char unit) {
+    if (decimals > rawDecimals) decimals = rawDecimals;
+
+    // Mise à l'échelle des décimales affichées, arrondie une seule fois
+    uint32_t divisor = 1;
+    for (uint8_t i = decimals; i < rawDecimals; i++) {
+      divisor *= 10;
+    }
+    uint32_t magnitude = raw < 0 ? -(uint32_t)raw : (uint32_t)raw;
+    magnitude = (magnitude + divisor / 2) / divisor;
+    bool negative = raw < 0 && magnitude != 0;
+
+    uint8_t length = 0;
+    if (unit) text[length++] = unit;
+    for (uint8_t i = 0; i < decimals; i++) {
+      text[length++] = '0' + magnitude % 10;
+      magnitude /= 10;
+    }
+    if (decimals) text[length++] = '.';
+    do {
+      text[length++] = '0' + magnitude % 10;
+      magnitude /= 10;
+    } while (magnitude);
+    if (negative) {
+      text[length++] = '-';
+    } else if (flags & FIXED_FORMAT_SIGN) {
+      text[length++] = '+';
+    }
+    return length;
+  }
+
+public:
+  /**
+   * @brief Formate une valeur brute à virgule fixe
+   * @param out Buffer de sortie (FIXED_FORMAT_MAX octets)
+   * @param raw Valeur × 10^rawDecimals
+   * @param rawDecimals Décimales de la valeur brute
+   * @param decimals Décimales affichées (bornées à rawDecimals)
+   * @param flags FIXED_FORMAT_SIGN
+   * @param unit Caractère ajouté après la valeur (0 = aucun)
+   * @return Longueur du texte (terminé par '\0')
+   */
+  static uint8_t format(char* out, int32_t raw, uint8_t rawDecimals, uint8_t decimals,
+                        uint8_t flags = 0, char unit = 0) {
+    char text[FIXED_FORMAT_MAX];
+    uint8_t length = reversed(text, raw, rawDecimals, decimals, flags, unit);
+    for (uint8_t i = 0; i < length; i++) {
+      out[i] = text[length - 1 - i];
+    }
+    out[length] = '\0';
+    return length;
+  }
+
+  /**
+   * @brief Formate sur une largeur fixe
+   * @param out Buffer de sortie (width + 1 octets)
+   * @param width Largeur (espaces de complément, '#' si trop long)
+   * @param flags FIXED_FORMAT_SIGN, FIXED_FORMAT_LEFT
+   * @return width
+   */
+  static uint8_t formatWidth(char* out, uint8_t width, int32_t raw, uint8_t rawDecimals,
+                             uint8_t decimals, uint8_t flags = 0, char unit = 0) {
+    char text[FIXED_FORMAT_MAX];
+    uint8_t length = reversed(text, raw, rawDecimals, decimals, flags, unit);
+
+    if (length > width) {
+      memset(out, FIXED_FORMAT_OVERFLOW, width);
+    } else {
+      uint8_t padding = width - length;
+      char* p = out;
+      if (!(flags & FIXED_FORMAT_LEFT)) {
+        memset(p, ' ', padding);
+        p += padding;
+      }
+      while (length) {
+        *p++ = text[--length];
+      }
+      if (flags & FIXED_FORMAT_LEFT) {
+        memset(p, ' ', padding);
+      }
+    }
+    out[width] = '\0';
+    return width;
+  }
+
+  /**
+   * @brief Formate une mesure Fixed16 (décimales brutes déduites de SCALE)
+   * @param out Buffer de sortie (FIXED_FORMAT_MAX octets)
+   * @param value Mesure
+   * @param decimals Décimales affichées
+   * @return Longueur du texte
+   */
+  template<int16_t SCALE>
+  static uint8_t format(char* out, const Fixed16<SCALE>& value, uint8_t decimals,
+                        uint8_t flags = 0, char unit = 0) {
+    return format(out, value.raw, scaleDecimals(SCALE), decimals, flags, unit);
+  }
+
+  /**
+   * @brief Formate un float (une multiplication, puis chemin entier)
+   * @param out Buffer de sortie (FIXED_FORMAT_MAX octets)
+   * @param value Valeur (bornée à ±2e9 / 10^decimals)
+   * @param decimals Décimales affichées (0-4)
+   * @return Longueur du texte
+   *
+   * @details Pour les valeurs sans échelle entière (offsets, moyennes).
+   */
+  static uint8_t formatFloat(char* out, float value, uint8_t decimals,
+                             uint8_t flags = 0, char unit = 0) {
+    if (decimals > 4) decimals = 4;
+    float scaled = value;
+    for (uint8_t i = 0; i < decimals; i++) {
+      scaled *= 10;
+    }
+    scaled += scaled < 0 ? -0.5f : 0.5f;
+    if (scaled > 2.0e9f) scaled = 2.0e9f;
+    if (scaled < -2.0e9f) scaled = -2.0e9f;
+    return format(out, (int32_t)scaled, decimals, decimals, flags, unit);
+  }
+
+  /**
+   * @brief Décimales d'une échelle Fixed16 (1, 10, 100, 1000)
+   */
+  static constexpr uint8_t scaleDecimals(int16_t scale) {
+    return scale >= 1000 ? 3 : scale >= 100 ? 2 : scale >= 10 ? 1 : 0;
+  }
+};
+
+#endif // FIXED_FORMAT_H
@@ -0,0 +1,288 @@
+/**
+ * @file GlyphCache.h
+ * @brief Attribution dynamique des 8 caractères personnalisés (CGRAM)
+ * @author Frédéric BAILLON
+ * @version 0.1.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Le HD44780 n'a que 8 emplacements CGRAM et chaque motif coûte 9
+ * octets HD44780 (≈ 110 octets I2C). Les écrans ne réservent plus
+ * d'emplacement fixe : ils demandent un motif à chaque image et
+ * obtiennent le code caractère (0-7) à placer dans l'image.
+ *
+ * - Demande par identifiant (GlyphId, motifs en flash) ou par motif
+ *   (RAM, motifs calculés)
+ * - Motif déjà présent : même emplacement, aucun envoi
+ * - Sinon : emplacement libre, ou le moins récemment utilisé parmi
+ *   ceux non demandés dans l'image en cours (LRU)
+ * - Les 8 emplacements déjà demandés dans l'image : caractère ROM de
+ *   repli (affichage dégradé, jamais un motif faux)
+ * - Envois groupés et différés : flush() est appelé par
+ *   LCDFramebuffer::flush() avant les cellules
+ *
+ * Un motif n'est remplacé que s'il n'a pas été demandé dans l'image
+ * en cours : les écrans redessinant toutes leurs cellules
+ * personnalisées à chaque image, aucune cellule visible ne change de
+ * motif.
+ *
+ * Mémoire : 8 × 8 octets de motifs + 19 octets d'état.
+ */
+
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <Arduino.h>
+#include "LCDDisplay.h"
+
+// ============================================
+// CONFIGURATION
+// ============================================
+#define GLYPH_KEY_NONE          0xFF    ///< Emplacement libre
+#define GLYPH_KEY_BITMAP        0xFE    ///< Motif demandé par contenu (RAM)
+
+// ============================================
+// TYPES ET STRUCTURES
+// ============================================
+/**
+ * @enum GlyphId
+ * @brief Motifs prédéfinis (GLYPH_TABLE)
+ */
+enum class GlyphId : uint8_t {
+  ALERT,        ///< Point d'exclamation
+  GAS,          ///< Nuage de gaz
+  BATTERY,      ///< Batterie
+  ARROW_UP,     ///< Flèche haut (← et → existent en ROM : 0x7F, 0x7E)
+  ARROW_DOWN,   ///< Flèche bas
+  BAR_1,        ///< Barre verticale, 1 ligne sur 8 (TrendGraph.h)
+  BAR_2,
+  BAR_3,
+  BAR_4,
+  BAR_5,
+  BAR_6,
+  BAR_7,        ///< 7 lignes sur 8 (8 = bloc plein ROM 0xFF)
+  COUNT
+};
+
+/**
+ * @struct GlyphDef
+ * @brief Motif prédéfini et son remplaçant ROM
+ */
+struct GlyphDef {
+  uint8_t rows[8];    ///< 8 lignes de 5 bits
+  char fallback;      ///< Caractère ROM si aucun emplacement disponible
+};
+
+// ============================================
+// MOTIFS PRÉDÉFINIS (PROGMEM)
+// ============================================
+const GlyphDef GLYPH_TABLE[] PROGMEM = {
+  // ALERT
+  {{0b00100, 0b00100, 0b00100, 0b00100, 0b00100, 0b00000, 0b00100, 0b00000}, '!'},
+  // GAS
+  {{0b00000, 0b01100, 0b10010, 0b01001, 0b10110, 0b01001, 0b00110, 0b00000}, '~'},
+  // BATTERY
+  {{0b01110, 0b11111, 0b10001, 0b10001, 0b11111, 0b11111, 0b11111, 0b00000}, '='},
+  // ARROW_UP
+  {{0b00100, 0b01110, 0b10101, 0b00100, 0b00100, 0b00100, 0b00100, 0b00000}, '^'},
+  // ARROW_DOWN
+  {{0b00100, 0b00100, 0b00100, 0b00100, 0b10101, 0b01110, 0b00100, 0b00000}, 'v'},
+  // BAR_1 à BAR_7
+  {{0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b11111}, '_'},
+  {{0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b11111, 0b11111}, '_'},
+  {{0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b11111, 0b11111, 0b11111}, '_'},
+  {{0b00000, 0b00000, 0b00000, 0b00000, 0b11111, 0b11111, 0b11111, 0b11111}, '_'},
+  {{0b00000, 0b00000, 0b00000, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111}, (char)0xFF},
+  {{0b00000, 0b00000, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111}, (char)0xFF},
+  {{0b00000, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111}, (char)0xFF}
+};
+
+static_assert(sizeof(GLYPH_TABLE) / sizeof(GLYPH_TABLE[0]) == (uint8_t)GlyphId::COUNT,
+              "GLYPH_TABLE incomplet");
+
+// ============================================
+// CLASSE GlyphCache
+// ============================================
+/**
+ * @class GlyphCache
+ * @brief Emplacements CGRAM attribués à la demande (LRU, envoi différé)
+ */
+class GlyphCache {
+private:
+  uint8_t rows[LCD_GLYPH_SLOTS][8];   ///< Motif voulu de chaque emplacement
+  uint8_t keys[LCD_GLYPH_SLOTS];      ///< GlyphId, GLYPH_KEY_BITMAP ou GLYPH_KEY_NONE
+  uint8_t lastUse[LCD_GLYPH_SLOTS];   ///< Image de la dernière demande
+  uint8_t frameStamp;                 ///< Image en cours
+  uint8_t used;                       ///< Emplacements demandés dans l'image (1 bit chacun)
+  uint8_t pending;                    ///< Emplacements à envoyer au prochain flush()
+
+  // Statistiques
+  uint32_t hits;                      ///< Motifs déjà en place
+  uint32_t uploads;                   ///< Motifs envoyés
+  uint16_t evictions;                 ///< Motifs remplacés
+  uint16_t misses;                    ///< Demandes servies par le caractère de repli
+
+  /**
+   * @brief Marque un emplacement comme demandé dans l'image
+   * @return Code caractère
+   */
+  char use(uint8_t slot) {
+    used |= 1 << slot;
+    lastUse[slot] = frameStamp;
+    return (char)slot;
+  }
+
+  /**
+   * @brief Choisit l'emplacement à (ré)attribuer
+   * @return Emplacement, GLYPH_KEY_NONE si tous sont demandés dans l'image
+   */
+  uint8_t victim() const {
+    uint8_t best = GLYPH_KEY_NONE;
+    uint8_t bestAge = 0;
+    for (uint8_t slot = 0; slot < LCD_GLYPH_SLOTS; slot++) {
+      if (used & (1 << slot)) continue;
+      if (keys[slot] == GLYPH_KEY_NONE) return slot;
+      uint8_t age = frameStamp - lastUse[slot];
+      if (best == GLYPH_KEY_NONE || age > bestAge) {
+        best = slot;
+        bestAge = age;
+      }
+    }
+    return best;
+  }
+
+  /**
+   * @brief Attribue un emplacement à un nouveau motif (envoi différé)
+   * @return Emplacement, GLYPH_KEY_NONE si aucun disponible
+   */
+  uint8_t assign(uint8_t key) {
+    uint8_t slot = victim();
+    if (slot == GLYPH_KEY_NONE) {
+      if (misses < 0xFFFF) misses++;
+      return GLYPH_KEY_NONE;
+    }
+    if (keys[slot] != GLYPH_KEY_NONE && evictions < 0xFFFF) evictions++;
+    keys[slot] = key;
+    pending |= 1 << slot;
+    return slot;
+  }
+
+public:
+  GlyphCache()
+    : frameStamp(0),
+      used(0),
+      pending(0),
+      hits(0),
+      uploads(0),
+      evictions(0),
+      misses(0)
+  {
+    memset(keys, GLYPH_KEY_NONE, sizeof(keys));
+    memset(lastUse, 0, sizeof(lastUse));
+  }
+
+  // ============================================
+  // DEMANDES
+  // ============================================
+
+  /**
+   * @brief Début d'une image : les emplacements redeviennent remplaçables
+   */
+  void beginFrame() {
+    frameStamp++;
+    used = 0;
+  }
+
+  /**
+   * @brief Demande un motif prédéfini
+   * @param id Motif
+   * @return Code caractère (0-7), ou caractère ROM de repli
+   */
+  char request(GlyphId id) {
+    uint8_t key = (uint8_t)id;
+    if (key >= (uint8_t)GlyphId::COUNT) return ' ';
+
+    for (uint8_t slot = 0; slot < LCD_GLYPH_SLOTS; slot++) {
+      if (keys[slot] == key) {
+        hits++;
+        return use(slot);
+      }
+    }
+
+    uint8_t slot = assign(key);
+    if (slot == GLYPH_KEY_NONE) {
+      return (char)pgm_read_byte(&GLYPH_TABLE[key].fallback);
+    }
+    memcpy_P(rows[slot], GLYPH_TABLE[key].rows, 8);
+    return use(slot);
+  }
+
+  /**
+   * @brief Demande un motif calculé
+   * @param bitmap 8 lignes de 5 bits (RAM)
+   * @param fallback Caractère ROM si aucun emplacement disponible
+   * @return Code caractère (0-7), ou fallback
+   */
+  char request(const uint8_t bitmap[8], char fallback) {
+    for (uint8_t slot = 0; slot < LCD_GLYPH_SLOTS; slot++) {
+      if (keys[slot] == GLYPH_KEY_BITMAP && memcmp(rows[slot], bitmap, 8) == 0) {
+        hits++;
+        return use(slot);
+      }
+    }
+
+    uint8_t slot = assign(GLYPH_KEY_BITMAP);
+    if (slot == GLYPH_KEY_NONE) return fallback;
+    memcpy(rows[slot], bitmap, 8);
+    return use(slot);
+  }
+
+  // ============================================
+  // ENVOI AU LCD
+  // ============================================
+
+  /**
+   * @brief Envoie les motifs attribués depuis le dernier envoi
+   * @param lcd Écran
+   * @return Nombre de motifs envoyés
+   *
+   * @details Si le LCD n'est pas prêt, les motifs restent en attente.
+   */
+  uint8_t flush(LCDDisplay& lcd) {
+    if (!pending || !lcd.isReady()) return 0;
+
+    uint8_t sent = 0;
+    for (uint8_t slot = 0; slot < LCD_GLYPH_SLOTS; slot++) {
+      if (!(pending & (1 << slot))) continue;
+      lcd.createChar(slot, rows[slot]);
+      sent++;
+    }
+    pending = 0;
+    uploads += sent;
+    return sent;
+  }
+
+  /**
+   * @brief Marque tous les motifs attribués à renvoyer
+   *
+   * @details Après ré-initialisation du LCD (CGRAM perdue si l'écran
+   * a été hors tension).
+   */
+  void invalidate() {
+    pending = 0;
+    for (uint8_t slot = 0; slot < LCD_GLYPH_SLOTS; slot++) {
+      if (keys[slot] != GLYPH_KEY_NONE) pending |= 1 << slot;
+    }
+  }
+
+  // ============================================
+  // GETTERS
+  // ============================================
+
+  uint32_t getHits() const { return hits; }
+  uint32_t getUploads() const { return uploads; }
+  uint16_t getEvictions() const { return evictions; }
+  uint16_t getMisses() const { return misses; }
+};
+
+#endif // GLYPH_CACHE_H
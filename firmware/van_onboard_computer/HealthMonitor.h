@@ -0,0 +1,273 @@
+/**
+ * @file HealthMonitor.h
+ * @brief Supervision des capteurs numériques (bus I2C, OneWire)
+ * @author Frédéric BAILLON
+ * @version 0.1.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Un capteur qui quitte le bus (connecteur, coupure d'alimentation)
+ * laissait sa dernière valeur « valide » indéfiniment, et begin()
+ * n'était jamais rappelé. Ce module :
+ * - Sonde l'adresse I2C des capteurs en service et compte les échecs
+ * - Relève les lectures ratées de chaque capteur (timeout, valeur
+ *   invalide) : HEALTH_MAX_ERRORS consécutives le mettent hors service
+ * - Déclare périmée une mesure plus vieille que HEALTH_STALE_FACTOR
+ *   intervalles d'acquisition (flags *Valid effacés)
+ * - Met le capteur hors service puis retente begin() avec un délai
+ *   exponentiel (HEALTH_RETRY_MIN .. HEALTH_RETRY_MAX)
+ * - Débloque le bus I2C (I2CBus::recover()) si SDA/SCL restent bas
+ *
+ * Non-bloquant : un seul capteur est contrôlé par appel, toutes les
+ * HEALTH_CHECK_INTERVAL ms (un sondage I2C dure ~50 µs). Exception :
+ * la ré-initialisation d'un BME280 présent bloque ~120 ms
+ * (BME280Sensor::begin()), une fois par remise en service.
+ */
+
+#ifndef HEALTH_MONITOR_H
+#define HEALTH_MONITOR_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "SystemData.h"
+#include "SensorManager.h"
+#include "I2CBus.h"
+
+// ============================================
+// TYPES ET STRUCTURES
+// ============================================
+/**
+ * @struct DeviceHealth
+ * @brief Compteurs de santé d'un capteur
+ */
+struct DeviceHealth {
+  uint16_t errors;            ///< Sondages I2C ratés (cumul, saturé)
+  uint8_t misses;             ///< Sondages ratés consécutifs
+  uint8_t staleCount;         ///< Mesures périmées détectées (saturé)
+  uint8_t readFaults;         ///< Mises hors service sur lectures ratées (saturé)
+  uint8_t restarts;           ///< Remises en service réussies (saturé)
+  uint8_t backoff;            ///< Exposant du délai de nouvelle tentative
+  unsigned long onlineSince;  ///< Mise en service (ms) : délai de grâce
+  unsigned long retryAt;      ///< Prochaine tentative si hors service (ms)
+};
+
+// ============================================
+// CLASSE HealthMonitor
+// ============================================
+/**
+ * @class HealthMonitor
+ * @brief Superviseur des capteurs : péremption, erreurs, ré-initialisation
+ */
+class HealthMonitor {
+private:
+  SensorManager& sensors;
+
+  DeviceHealth health[(uint8_t)SensorId::COUNT];
+  uint8_t next;               ///< Prochain capteur contrôlé (tourniquet)
+  unsigned long lastCheck;
+
+  /**
+   * @brief Incrémente un compteur 8 bits sans débordement
+   */
+  static void saturatingIncrement(uint8_t& counter) {
+    if (counter < 0xFF) counter++;
+  }
+
+  /**
+   * @brief Contrôle un capteur en service
+   * @param id Capteur
+   * @param now millis()
+   */
+  void checkOnline(SensorId id, unsigned long now) {
+    DeviceHealth& h = health[(uint8_t)id];
+
+    // Présence sur le bus (DS18B20 : pas d'adresse, péremption seule)
+    uint8_t address = SensorManager::getAddress(id);
+    if (address != 0) {
+      if (I2CBus::probe(address)) {
+        h.misses = 0;
+      } else {
+        if (h.errors < 0xFFFF) h.errors++;
+        saturatingIncrement(h.misses);
+        if (h.misses >= HEALTH_MAX_ERRORS) {
+          LOG_WARN("%S: ne repond plus sur I2C (%u erreurs)", sensorName(id), h.errors);
+          takeOffline(id, now);
+        }
+        return;
+      }
+    }
+
+    // Lectures ratées signalées par le capteur lui-même
+    uint8_t failed = sensors.getFailedReads(id);
+    if (failed >= HEALTH_MAX_ERRORS) {
+      saturatingIncrement(h.readFaults);
+      LOG_WARN("%S: %u lectures ratees", sensorName(id), failed);
+      takeOffline(id, now);
+      return;
+    }
+
+    // Péremption : aucune mesure depuis N intervalles
+    unsigned long limit = sensors.getSampleInterval(id) * HEALTH_STALE_FACTOR;
+    if (limit < HEALTH_STALE_MIN) limit = HEALTH_STALE_MIN;
+
+    unsigned long age = sensors.getSampleAge(id);
+    if (now - h.onlineSince >= limit && age >= limit) {
+      saturatingIncrement(h.staleCount);
+      LOG_WARN("%S: mesure perimee (%lu s)", sensorName(id), age / 1000);
+      takeOffline(id, now);
+    }
+  }
+
+  /**
+   * @brief Tente de remettre en service un capteur défaillant
+   * @param id Capteur
+   * @param now millis()
+   */
+  void checkOffline(SensorId id, unsigned long now) {
+    DeviceHealth& h = health[(uint8_t)id];
+    if ((long)(now - h.retryAt) < 0) return;
+
+    // Bus bloqué par un esclave : begin() échouerait de toute façon
+    if (SensorManager::getAddress(id) != 0 && I2CBus::isStuck()) {
+      if (I2CBus::recover()) {
+        LOG_WARN("Bus I2C bloque: libere");
+      } else {
+        LOG_ERROR("Bus I2C bloque: deblocage en echec");
+      }
+    }
+
+    bool restarted = sensors.restart(id);
+    LOG_DEBUG("%S: begin() %lu ms", sensorName(id), millis() - now);
+    if (restarted) {
+      saturatingIncrement(h.restarts);
+      h.misses = 0;
+      h.backoff = 0;
+      h.onlineSince = millis();
+      LOG_INFO("%S: remis en service", sensorName(id));
+      return;
+    }
+
+    // Délai exponentiel : 1 s, 2 s, 4 s ... plafonné
+    unsigned long delayMs = (unsigned long)HEALTH_RETRY_MIN << h.backoff;
+    if (delayMs < HEALTH_RETRY_MAX) {
+      h.backoff++;
+    } else {
+      delayMs = HEALTH_RETRY_MAX;
+    }
+    h.retryAt = now + delayMs;
+    LOG_DEBUG("%S: nouvelle tentative dans %lu ms", sensorName(id), delayMs);
+  }
+
+  /**
+   * @brief Met un capteur hors service et programme sa ré-initialisation
+   */
+  void takeOffline(SensorId id, unsigned long now) {
+    DeviceHealth& h = health[(uint8_t)id];
+    sensors.suspend(id);
+    h.misses = 0;
+    h.backoff = 0;
+    h.retryAt = now + HEALTH_RETRY_MIN;
+  }
+
+public:
+  /**
+   * @brief Constructeur
+   * @param sensorManager Gestionnaire capteurs supervisé
+   */
+  HealthMonitor(SensorManager& sensorManager)
+    : sensors(sensorManager),
+      next(0),
+      lastCheck(0)
+  {
+    memset(health, 0, sizeof(health));
+  }
+
+  // ============================================
+  // INITIALISATION
+  // ============================================
+
+  /**
+   * @brief Démarre la supervision (après SensorManager::begin())
+   *
+   * @details Les capteurs absents au démarrage sont retentés dès le
+   * premier contrôle, puis avec le délai exponentiel.
+   */
+  void begin() {
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < (uint8_t)SensorId::COUNT; i++) {
+      health[i].onlineSince = now;
+      health[i].retryAt = now;
+    }
+    lastCheck = now;
+  }
+
+  // ============================================
+  // MISE À JOUR
+  // ============================================
+
+  /**
+   * @brief Contrôle le capteur suivant (non-bloquant)
+   */
+  void update() {
+    unsigned long now = millis();
+    if (now - lastCheck < HEALTH_CHECK_INTERVAL) return;
+    lastCheck = now;
+
+    // Capteur suivant prévu par le profil matériel
+    for (uint8_t i = 0; i < (uint8_t)SensorId::COUNT; i++) {
+      SensorId id = (SensorId)next;
+      next = (next + 1) % (uint8_t)SensorId::COUNT;
+
+      if (!SensorManager::isFitted(id)) continue;
+
+      if (sensors.isOnline(id)) {
+        checkOnline(id, now);
+      } else {
+        checkOffline(id, now);
+      }
+      return;
+    }
+  }
+
+  // ============================================
+  // GETTERS
+  // ============================================
+
+  /**
+   * @brief Compteurs de santé d'un capteur
+   * @param id Capteur
+   * @return Référence constante
+   */
+  const DeviceHealth& getHealth(SensorId id) const {
+    return health[(uint8_t)id];
+  }
+
+  /**
+   * @brief Nombre de capteurs prévus mais hors service
+   */
+  uint8_t getOfflineCount() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < (uint8_t)SensorId::COUNT; i++) {
+      SensorId id = (SensorId)i;
+      if (SensorManager::isFitted(id) && !sensors.isOnline(id)) count++;
+    }
+    return count;
+  }
+
+  /**
+   * @brief Nom d'un capteur supervisé (flash, pour "%S")
+   * @param id Capteur
+   */
+  static const __FlashStringHelper* sensorName(SensorId id) {
+    switch (id) {
+      case SensorId::BME280:     return F("BME280");
+      case SensorId::DS18B20:    return F("DS18B20");
+      case SensorId::MPU6050:    return F("MPU6050");
+      case SensorId::INA226_12V: return F("INA226 12V");
+      case SensorId::INA226_5V:  return F("INA226 5V");
+      default:                   return F("?");
+    }
+  }
+};
+
+#endif // HEALTH_MONITOR_H
@@ -0,0 +1,184 @@
+/**
+ * @file I2CBus.h
+ * @brief Utilitaires bus I2C : expiration, sondage et déblocage
+ * @author Frédéric BAILLON
+ * @version 0.1.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Un esclave réinitialisé au milieu d'un octet (coupure brève,
+ * parasite moteur, câble long) peut garder SDA à l'état bas. Sans
+ * expiration, Wire attend alors indéfiniment dans endTransmission()
+ * ou requestFrom() : loop() est figée, surveillance gaz comprise.
+ *
+ * - Chaque transaction est bornée à I2C_TIMEOUT_US
+ *   (Wire.setWireTimeout(), cœur AVR >= 1.8.3) ; le TWI est
+ *   réinitialisé après une expiration
+ * - Les classes capteurs/LCD appellent takeTimeout() après leurs
+ *   accès et passent leur statut en ERROR_TIMEOUT
+ * - Bus bloqué : jusqu'à 9 impulsions SCL jusqu'à libération de SDA,
+ *   puis un STOP (NXP UM10204 §3.1.16), soit ~0,1 ms
+ *
+ * Pire cas d'une transaction sur bus défaillant : I2C_TIMEOUT_US,
+ * puis déblocage immédiat.
+ */
+
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// ============================================
+// CONFIGURATION
+// ============================================
+// Valeurs de config.h si inclus avant (programme principal)
+#ifndef I2C_CLOCK_SPEED
+#define I2C_CLOCK_SPEED         400000  ///< I2C Fast Mode (Hz)
+#endif
+#ifndef I2C_TIMEOUT_US
+#define I2C_TIMEOUT_US          2000    ///< Durée max d'une transaction (µs)
+#endif
+
+#define I2C_RECOVERY_PULSES     9       ///< Impulsions SCL max (un octet + ACK)
+#define I2C_RECOVERY_HALF_US    5       ///< Demi-période SCL (µs, ~100 kHz)
+
+// ============================================
+// CLASSE I2CBus
+// ============================================
+/**
+ * @class I2CBus
+ * @brief Fonctions statiques d'accès bas niveau au bus I2C
+ */
+class I2CBus {
+private:
+  /**
+   * @brief Compteurs partagés (statiques locales : classe sans .cpp)
+   */
+  static uint16_t& timeoutCounter() {
+    static uint16_t count = 0;
+    return count;
+  }
+
+  static uint16_t& recoveryCounter() {
+    static uint16_t count = 0;
+    return count;
+  }
+
+  static void increment(uint16_t& counter) {
+    if (counter < 0xFFFF) counter++;
+  }
+
+public:
+  /**
+   * @brief (Ré)initialise le contrôleur TWI avec expiration
+   */
+  static void begin() {
+    Wire.begin();
+    Wire.setClock(I2C_CLOCK_SPEED);
+#if defined(WIRE_HAS_TIMEOUT)
+    Wire.setWireTimeout(I2C_TIMEOUT_US, true);
+#endif
+  }
+
+  /**
+   * @brief Consomme l'indicateur d'expiration de Wire
+   * @return true si une transaction a expiré depuis le dernier appel
+   *
+   * @details À appeler juste après les accès d'un périphérique pour
+   * lui attribuer l'erreur. Débloque le bus si une ligne reste basse.
+   */
+  static bool takeTimeout() {
+#if defined(WIRE_HAS_TIMEOUT)
+    if (!Wire.getWireTimeoutFlag()) return false;
+    Wire.clearWireTimeoutFlag();
+    increment(timeoutCounter());
+
+    if (isStuck()) recover();
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /**
+   * @brief Teste la présence d'un périphérique (adresse seule)
+   * @param address Adresse 7 bits
+   * @return true si le périphérique acquitte
+   */
+  static bool probe(uint8_t address) {
+    Wire.beginTransmission(address);
+    bool ack = Wire.endTransmission() == 0;
+    takeTimeout();
+    return ack;
+  }
+
+  /**
+   * @brief Vérifie si une ligne du bus est maintenue à l'état bas
+   * @return true si SDA ou SCL est bas au repos
+   *
+   * @note Lecture du registre PIN : valable même quand le TWI
+   * pilote les broches.
+   */
+  static bool isStuck() {
+    return digitalRead(SDA) == LOW || digitalRead(SCL) == LOW;
+  }
+
+  /**
+   * @brief Débloque le bus en générant des impulsions SCL puis un STOP
+   * @return true si SDA est libéré
+   *
+   * @details Les lignes sont pilotées en drain ouvert : sortie à 0
+   * pour tirer, entrée (pull-up) pour relâcher. Le TWI est
+   * réinitialisé à la fin dans tous les cas.
+   */
+  static bool recover() {
+    increment(recoveryCounter());
+    Wire.end();
+
+    pinMode(SDA, INPUT_PULLUP);
+    pinMode(SCL, INPUT_PULLUP);
+    delayMicroseconds(I2C_RECOVERY_HALF_US);
+
+    // Impulsions d'horloge jusqu'à libération de SDA
+    for (uint8_t i = 0; i < I2C_RECOVERY_PULSES && digitalRead(SDA) == LOW; i++) {
+      pinMode(SCL, OUTPUT);
+      digitalWrite(SCL, LOW);
+      delayMicroseconds(I2C_RECOVERY_HALF_US);
+      pinMode(SCL, INPUT_PULLUP);
+      delayMicroseconds(I2C_RECOVERY_HALF_US);
+    }
+
+    // STOP : SDA monte pendant que SCL est haut
+    pinMode(SDA, OUTPUT);
+    digitalWrite(SDA, LOW);
+    delayMicroseconds(I2C_RECOVERY_HALF_US);
+    pinMode(SDA, INPUT_PULLUP);
+    delayMicroseconds(I2C_RECOVERY_HALF_US);
+
+    bool released = digitalRead(SDA) == HIGH && digitalRead(SCL) == HIGH;
+
+    begin();
+    return released;
+  }
+
+  // ============================================
+  // STATISTIQUES
+  // ============================================
+
+  /**
+   * @brief Nombre de transactions expirées
+   */
+  static uint16_t getTimeoutCount() {
+    return timeoutCounter();
+  }
+
+  /**
+   * @brief Nombre de déblocages du bus
+   */
+  static uint16_t getRecoveryCount() {
+    return recoveryCounter();
+  }
+};
+
+#endif // I2C_BUS_H
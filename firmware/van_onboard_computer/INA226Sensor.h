@@ -23,6 +23,8 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <INA226.h>  // INA226Lib par Peter Buchegger
+#include "I2CBus.h"
+#include "FixedFormat.h"
 
 // ============================================
 // CONFIGURATION MATÉRIELLE
@@ -40,6 +42,8 @@
 #define INA226_MAX_CURRENT_12V  40.0f   ///< Courant max 12V : 81.92mV / 2mΩ = 40.96A
 #define INA226_MAX_CURRENT_5V   8.0f    ///< Courant max 5V : 81.92mV / 10mΩ = 8.19A
 
+#define INA226_MAX_BUS_VOLTAGE  36.0f   ///< Tension bus max mesurable (V)
+
 #define INA226_UPDATE_INTERVAL  500     ///< Intervalle de mise à jour (ms)
 
 // ============================================
@@ -77,7 +81,8 @@ enum class INA226Status {
   NOT_FOUND,            ///< Capteur non détecté sur I2C
   OVERFLOW,             ///< Dépassement capacité mesure
   UNDERVOLTAGE,         ///< Sous-tension détectée
-  OVERCURRENT           ///< Sur-courant détecté
+  OVERCURRENT,          ///< Sur-courant détecté
+  TIMEOUT               ///< Transaction I2C expirée (bus bloqué)
 };
 
 // ============================================
@@ -114,6 +119,7 @@ private:
   // État
   bool initialized;                 ///< État initialisation
   INA226Status status;              ///< État actuel
+  uint8_t failedReads;              ///< Lectures ratées consécutives (saturé)
   unsigned long lastUpdate;         ///< Timestamp dernière MAJ
   uint16_t updateInterval;          ///< Intervalle de mise à jour (ms)
   
@@ -164,6 +170,7 @@ public:
       power(0.0f),
       initialized(false),
       status(INA226Status::NOT_INITIALIZED),
+      failedReads(0),
       lastUpdate(0),
       updateInterval(interval)
   {
@@ -177,16 +184,16 @@ public:
     if (rail == PowerRailType::RAIL_12V) {
       shuntResistance = INA226_SHUNT_12V;      // 2 mΩ
       maxCurrent = INA226_MAX_CURRENT_12V;     // 40A
-      voltageMin = 10.5f;   // Minimum 12V
-      voltageMax = 14.5f;   // Maximum 12V
-      currentMax = 20.0f;   // Seuil alerte courant (adapté à vos besoins)
     } else {
       shuntResistance = INA226_SHUNT_5V;       // 10 mΩ
       maxCurrent = INA226_MAX_CURRENT_5V;      // 8A
-      voltageMin = 4.5f;    // Minimum 5V
-      voltageMax = 5.5f;    // Maximum 5V
-      currentMax = 3.0f;    // Seuil alerte courant (adapté à vos besoins)
     }
+    
+    // Seuils d'alerte : plage de mesure complète tant que l'application
+    // ne les a pas fixés (setVoltageThresholds / setCurrentThreshold)
+    voltageMin = 0.0f;
+    voltageMax = INA226_MAX_BUS_VOLTAGE;
+    currentMax = maxCurrent;
   }
 
   // INITIALISATION
@@ -197,8 +204,7 @@ public:
    */
   bool begin() {
     // Vérifier présence I2C
-    Wire.beginTransmission(i2cAddress);
-    if (Wire.endTransmission() != 0) {
+    if (!I2CBus::probe(i2cAddress)) {
       status = INA226Status::NOT_FOUND;
       return false;
     }
@@ -206,7 +212,7 @@ public:
     // Initialiser INA226 avec l'API de INA226Lib
     // begin(address) uniquement
     if (!ina.begin(i2cAddress)) {
-      status = INA226Status::NOT_FOUND;
+      status = I2CBus::takeTimeout() ? INA226Status::TIMEOUT : INA226Status::NOT_FOUND;
       return false;
     }
     
@@ -221,8 +227,14 @@ public:
     // calibrate(rShunt, maxExpectedCurrent)
     ina.calibrate(shuntResistance, maxCurrent);
     
+    if (I2CBus::takeTimeout()) {
+      status = INA226Status::TIMEOUT;
+      return false;
+    }
+    
     initialized = true;
     status = INA226Status::OK;
+    failedReads = 0;
     
     return true;
   }
@@ -274,10 +286,25 @@ public:
     
     // Lire toutes les valeurs avec l'API INA226Lib
     busVoltage = ina.readBusVoltage();      // Retourne en V
+    
+    // Bus expiré : ne pas enchaîner les lectures (une expiration chacune)
+    if (I2CBus::takeTimeout()) {
+      status = INA226Status::TIMEOUT;
+      if (failedReads < 0xFF) failedReads++;
+      return false;
+    }
+    
     shuntVoltage = ina.readShuntVoltage();  // Retourne en V
     current = ina.readShuntCurrent();       // Retourne en A
     power = ina.readBusPower();             // Retourne en W
     
+    if (I2CBus::takeTimeout()) {
+      status = INA226Status::TIMEOUT;
+      if (failedReads < 0xFF) failedReads++;
+      return false;
+    }
+    failedReads = 0;
+    
     // Vérifier limites
     checkLimits();
     
@@ -381,6 +408,14 @@ public:
     return status;
   }
 
+  /**
+   * @brief Lectures ratées consécutives (HealthMonitor)
+   * @return Nombre d'échecs depuis la dernière lecture réussie (saturé)
+   */
+  uint8_t getFailedReads() const {
+    return failedReads;
+  }
+
   /**
    * @brief Vérifie si le capteur est initialisé
    * @return true si initialisé
@@ -450,6 +485,7 @@ public:
       case INA226Status::OVERFLOW:        return "SURTENSION";
       case INA226Status::UNDERVOLTAGE:    return "SOUS-TENSION";
       case INA226Status::OVERCURRENT:     return "SURINTENSITY";
+      case INA226Status::TIMEOUT:         return "BUS I2C BLOQUE";
       default:                            return "INCONNU";
     }
   }
@@ -471,13 +507,12 @@ public:
    * @brief Formate une valeur avec unité
    * @param value Valeur
    * @param unit Unité
-   * @param buffer Buffer de sortie (min 16 caractères)
+   * @param buffer Buffer de sortie (FIXED_FORMAT_MAX + longueur de l'unité)
    * @param decimals Nombre de décimales
    */
   static void formatValue(float value, const char* unit, char* buffer, uint8_t decimals = 2) {
-    dtostrf(value, 0, decimals, buffer);
-    strcat(buffer, " ");
-    strcat(buffer, unit);
+    uint8_t length = FixedFormat::formatFloat(buffer, value, decimals, 0, ' ');
+    strcpy(buffer + length, unit);
   }
 };
 
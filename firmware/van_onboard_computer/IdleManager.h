@@ -0,0 +1,234 @@
+/**
+ * @file IdleManager.h
+ * @brief Veille CPU (mode IDLE AVR) entre deux échéances de loop()
+ * @author Frédéric BAILLON
+ * @version 0.1.0
+ * @date 2024-11-26
+ *
+ * @details
+ * loop() tournait en continu alors que la tâche périodique la plus
+ * rapide est le rafraîchissement LED (50 ms). En fin de loop(), le
+ * CPU est mis en veille IDLE jusqu'à la prochaine échéance : début
+ * du cycle + plus court des intervalles (LEDs, LCD, capteurs,
+ * supervision). Les intervalles de chaque module sont inchangés : la
+ * période MQ7/MQ2 (2 s) reste respectée à un cycle près.
+ *
+ * En IDLE les périphériques tournent : Timer0 (millis(), réveil
+ * toutes les 1,024 ms, séquenceur du buzzer), USART (journal,
+ * console), INT4/INT5 (encodeur, broches 2 et 3 du Mega). À chaque
+ * réveil, le programme principal fournit deux crochets :
+ * - Travail de fond (vidage du journal, télémétrie), interruptions
+ *   autorisées
+ * - Test de reprise (commande reçue, cran d'encodeur), évalué
+ *   interruptions masquées juste avant sleep_cpu() : un événement
+ *   arrivé après le test reste en attente et réveille aussitôt le CPU
+ *
+ * La période inclut l'émission du tableau de bord (INTERVAL_DASHBOARD)
+ * et, pendant la mise à niveau, LEVEL_MPU_INTERVAL (setLevelling()).
+ *
+ * Statistiques sur IDLE_STATS_WINDOW : taux d'activité CPU et
+ * estimation du courant consommé par le microcontrôleur seul
+ * (capteurs gaz, LCD et LEDs non compris).
+ */
+
+#ifndef IDLE_MANAGER_H
+#define IDLE_MANAGER_H
+
+#include <Arduino.h>
+#include <avr/sleep.h>
+#include "config.h"
+#include "Settings.h"
+
+// ============================================
+// CONFIGURATION
+// ============================================
+#define IDLE_STATS_WINDOW       10000   ///< Fenêtre de calcul des statistiques (ms)
+
+// ============================================
+// CLASSE IdleManager
+// ============================================
+/**
+ * @class IdleManager
+ * @brief Mise en veille IDLE jusqu'à l'échéance suivante
+ */
+class IdleManager {
+private:
+  void (*idleWork)();             ///< Travail de fond à chaque réveil
+  bool (*wakePending)();          ///< true = reprendre loop() (interruptions masquées)
+  bool levelling;                 ///< Écran LEVEL affiché (MPU6050 rapide)
+
+  unsigned long cycleStart;       ///< Début du cycle courant (ms)
+
+  // Statistiques (fenêtre courante)
+  unsigned long windowStart;      ///< Début de fenêtre (µs)
+  unsigned long sleptUs;          ///< Temps passé en veille dans la fenêtre (µs)
+  uint8_t activePercent;          ///< Taux d'activité de la dernière fenêtre (%)
+  unsigned long wakeups;          ///< Réveils anticipés par le test de reprise (cumul)
+
+  /**
+   * @brief Teste la reprise puis met le CPU en veille
+   * @param deadline Échéance du cycle (ms)
+   * @return true si la veille est terminée (échéance ou reprise)
+   *
+   * @details Tests faits interruptions masquées : une interruption
+   * survenue entre-temps reste en attente. sei() n'autorise les
+   * interruptions qu'après l'instruction suivante, sleep_cpu() est
+   * donc exécuté avant elle et le CPU se réveille aussitôt au lieu
+   * d'attendre le tick suivant.
+   */
+  bool sleepUntilInterrupt(unsigned long deadline) {
+    cli();
+    if ((long)(millis() - deadline) >= 0) {
+      sei();
+      return true;
+    }
+    if (wakePending && wakePending()) {
+      sei();
+      wakeups++;
+      return true;
+    }
+    sleep_enable();
+    sei();
+    sleep_cpu();
+    sleep_disable();
+    return false;
+  }
+
+  /**
+   * @brief Clôt la fenêtre de statistiques si elle est écoulée
+   */
+  void updateStats() {
+    unsigned long elapsed = micros() - windowStart;
+    if (elapsed < IDLE_STATS_WINDOW * 1000UL) return;
+
+    unsigned long sleptPercent = sleptUs / (elapsed / 100);
+    activePercent = sleptPercent < 100 ? 100 - sleptPercent : 0;
+    windowStart += elapsed;
+    sleptUs = 0;
+  }
+
+public:
+  /**
+   * @brief Constructeur
+   * @param work Travail de fond à chaque réveil (nullptr si aucun)
+   * @param pending Test de reprise, court et sans attente : appelé
+   *        interruptions masquées (nullptr si aucun)
+   */
+  IdleManager(void (*work)() = nullptr, bool (*pending)() = nullptr)
+    : idleWork(work),
+      wakePending(pending),
+      levelling(false),
+      cycleStart(0),
+      windowStart(0),
+      sleptUs(0),
+      activePercent(100),
+      wakeups(0)
+  {
+  }
+
+  // ============================================
+  // INITIALISATION
+  // ============================================
+
+  /**
+   * @brief Sélectionne le mode IDLE et démarre les statistiques
+   */
+  void begin() {
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    cycleStart = millis();
+    windowStart = micros();
+  }
+
+  // ============================================
+  // VEILLE
+  // ============================================
+
+  /**
+   * @brief Suit l'écran LEVEL (MPU6050 toutes les LEVEL_MPU_INTERVAL ms)
+   * @param active true tant que l'écran est affiché
+   */
+  void setLevelling(bool active) {
+    levelling = active;
+  }
+
+  /**
+   * @brief Période du cycle : plus court des intervalles périodiques
+   * @return Période en ms
+   */
+  unsigned long getCyclePeriod() const {
+    const RuntimeSettings& values = settings.values;
+    unsigned long period = values.intervalLeds;
+    if (values.intervalDisplay < period) period = values.intervalDisplay;
+    if (values.intervalMPU6050 < period) period = values.intervalMPU6050;
+    if (values.intervalINA226 < period) period = values.intervalINA226;
+    if (values.intervalMQ7 < period) period = values.intervalMQ7;
+    if (values.intervalMQ2 < period) period = values.intervalMQ2;
+    if (HEALTH_CHECK_INTERVAL < period) period = HEALTH_CHECK_INTERVAL;
+    #if USE_DASHBOARD_LCD
+    if (INTERVAL_DASHBOARD < period) period = INTERVAL_DASHBOARD;
+    #endif
+    if (levelling && LEVEL_MPU_INTERVAL < period) period = LEVEL_MPU_INTERVAL;
+    return period;
+  }
+
+  /**
+   * @brief Veille jusqu'à l'échéance du cycle (fin de loop())
+   *
+   * @details Cycle en retard (loop() plus longue que la période) :
+   * pas de veille, le cycle suivant part de maintenant.
+   */
+  void sleep() {
+    unsigned long period = getCyclePeriod();
+    unsigned long deadline = cycleStart + period;
+
+    if ((long)(millis() - deadline) >= 0) {
+      cycleStart = millis();
+      updateStats();
+      return;
+    }
+
+    #if USE_IDLE_SLEEP
+    unsigned long start = micros();
+    do {
+      if (idleWork) idleWork();
+    } while (!sleepUntilInterrupt(deadline));
+    sleptUs += micros() - start;
+    #endif
+
+    // Réveil anticipé : le cycle en cours garde son échéance
+    if ((long)(millis() - deadline) >= 0) {
+      cycleStart = deadline;
+    }
+    updateStats();
+  }
+
+  // ============================================
+  // STATISTIQUES
+  // ============================================
+
+  /**
+   * @brief Taux d'activité CPU sur la dernière fenêtre
+   * @return Pourcentage du temps hors veille (0-100)
+   */
+  uint8_t getActivePercent() const {
+    return activePercent;
+  }
+
+  /**
+   * @brief Courant estimé du microcontrôleur
+   * @return Courant moyen (mA) selon le taux d'activité
+   */
+  uint8_t getEstimatedCurrent() const {
+    return (IDLE_CURRENT_ACTIVE_MA * activePercent +
+            IDLE_CURRENT_SLEEP_MA * (100 - activePercent)) / 100;
+  }
+
+  /**
+   * @brief Réveils anticipés demandés par le test de reprise (cumul)
+   */
+  unsigned long getWakeups() const {
+    return wakeups;
+  }
+};
+
+#endif // IDLE_MANAGER_H
@@ -2,7 +2,7 @@
  * @file KY040Encoder.h
  * @brief Classe de gestion de l'encodeur rotatif KY040
  * @author Frédéric BAILLON
- * @version 0.1.0
+ * @version 0.2.0
  * @date 2024-11-21
  * 
  * @details
@@ -12,6 +12,13 @@
  * - Gestion des rotations (CW/CCW) et du bouton poussoir
  * - Détection des changements avec debouncing
  * - Responsabilité unique : lire et traiter événements encodeur
+ * 
+ * Décodage par interruption :
+ * - CLK et DT sur broches INT (2/3 sur Mega) : ISR sur chaque front
+ * - Table d'état Gray-code : les transitions invalides (rebonds) sont ignorées
+ * - Événements rotation/bouton dans une file circulaire sans verrou
+ *   (un crantage n'est jamais perdu, même avec une loop() lente)
+ * - Repli en scrutation si une broche n'a pas d'interruption
  */
 
 #ifndef KY040_ENCODER_H
@@ -22,9 +29,10 @@
 // ============================================
 // CONFIGURATION
 // ============================================
-#define KY040_DEBOUNCE_DELAY    5     ///< Délai anti-rebond rotation (ms)
+#define KY040_STEPS_PER_DETENT  4     ///< Transitions Gray-code par cran (mettre à 2 si besoin)
 #define KY040_BUTTON_DEBOUNCE   50    ///< Délai anti-rebond bouton (ms)
 #define KY040_LONG_PRESS_TIME   1000  ///< Durée appui long (ms)
+#define KY040_EVENT_QUEUE_SIZE  16    ///< Taille file d'événements (puissance de 2)
 
 // ============================================
 // TYPES ET STRUCTURES
@@ -51,6 +59,32 @@ enum class ButtonEvent {
   LONG_PRESS      ///< Appui long
 };
 
+/**
+ * @enum EncoderEvent
+ * @brief Événement de la file de l'encodeur
+ */
+enum class EncoderEvent : uint8_t {
+  NONE,             ///< Aucun événement
+  ROTATE_CW,        ///< Un cran horaire
+  ROTATE_CCW,       ///< Un cran anti-horaire
+  BUTTON_PRESSED,   ///< Bouton appuyé
+  BUTTON_CLICKED,   ///< Clic court (au relâchement)
+  BUTTON_LONG_PRESS ///< Appui long (dès le seuil atteint)
+};
+
+/**
+ * @brief Table de décodage quadrature (index = ancien état << 2 | nouvel état)
+ * 
+ * @details +1 / -1 pour une transition valide, 0 pour aucune
+ * transition ou une transition invalide (rebond, double saut).
+ */
+const int8_t KY040_GRAY_TABLE[16] PROGMEM = {
+   0, -1,  1,  0,
+   1,  0,  0, -1,
+  -1,  0,  0,  1,
+   0,  1, -1,  0
+};
+
 /**
  * @struct EncoderData
  * @brief Structure contenant l'état de l'encodeur
@@ -80,13 +114,27 @@ private:
   uint8_t pinDT;                ///< Broche DT (sortie B)
   uint8_t pinSW;                ///< Broche SW (bouton)
   
+  // Accès direct aux ports (lecture rapide en ISR)
+  volatile uint8_t* regCLK;     ///< Registre d'entrée CLK
+  volatile uint8_t* regDT;      ///< Registre d'entrée DT
+  uint8_t maskCLK;              ///< Masque bit CLK
+  uint8_t maskDT;               ///< Masque bit DT
+  bool interruptMode;           ///< true si décodage par interruption
+  
   // État rotation
-  int32_t position;             ///< Position courante
-  volatile uint8_t lastStateCLK;     ///< Dernier état CLK
-  volatile uint8_t lastStateDT;      ///< Dernier état DT
+  volatile int32_t position;         ///< Position courante
+  volatile uint8_t quadState;        ///< Dernier état (CLK << 1 | DT)
+  volatile int8_t stepAccumulator;   ///< Transitions depuis le dernier cran
   volatile bool rotationDetected;    ///< Flag rotation détectée
   volatile RotationDirection lastDirection;  ///< Dernière direction
-  unsigned long lastRotationTime;    ///< Timestamp dernière rotation
+  
+  // File d'événements (producteur : ISR + update(), consommateur : loop)
+  volatile EncoderEvent eventQueue[KY040_EVENT_QUEUE_SIZE];
+  volatile uint8_t eventHead;        ///< Index d'écriture
+  volatile uint8_t eventTail;        ///< Index de lecture
+  volatile uint16_t droppedEvents;   ///< Événements perdus (file pleine)
+  
+  static KY040Encoder* instance;     ///< Instance servie par l'ISR
   
   // État bouton
   bool buttonState;             ///< État actuel du bouton
@@ -104,47 +152,92 @@ private:
   bool limitEnabled;            ///< Activer limites position
   
   /**
-   * @brief Lit l'état actuel des pins CLK et DT
+   * @brief Lit l'état quadrature actuel
+   * @return CLK << 1 | DT
+   */
+  uint8_t readQuadrature() const {
+    return ((*regCLK & maskCLK) ? 2 : 0) | ((*regDT & maskDT) ? 1 : 0);
+  }
+  
+  /**
+   * @brief Ajoute un événement dans la file
+   * @param event Événement
+   * 
+   * @details Appelé depuis l'ISR ou, interruptions masquées, depuis loop().
+   */
+  void pushEvent(EncoderEvent event) {
+    uint8_t next = (eventHead + 1) & (KY040_EVENT_QUEUE_SIZE - 1);
+    if (next == eventTail) {
+      droppedEvents++;
+      return;
+    }
+    eventQueue[eventHead] = event;
+    eventHead = next;
+  }
+  
+  /**
+   * @brief Ajoute un événement bouton depuis loop()
+   * @param event Événement
+   */
+  void pushButtonEvent(EncoderEvent event) {
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+    pushEvent(event);
+    SREG = oldSREG;
+  }
+  
+  /**
+   * @brief Décode une transition CLK/DT
+   * 
+   * @details
+   * Appelé depuis l'ISR (ou update() en scrutation).
+   * Un cran est validé après KY040_STEPS_PER_DETENT transitions valides
+   * dans le même sens ; l'accumulateur est recalé à chaque position de repos.
    */
-  void readEncoderState() {
-    uint8_t clkState = digitalRead(pinCLK);
-    uint8_t dtState = digitalRead(pinDT);
+  void decode() {
+    uint8_t current = readQuadrature();
+    if (current == quadState) return;
     
-    // Détection de rotation (transition sur CLK)
-    if (clkState != lastStateCLK) {
-      unsigned long now = millis();
-      
-      // Anti-rebond
-      if (now - lastRotationTime >= KY040_DEBOUNCE_DELAY) {
-        lastRotationTime = now;
-        
-        // Déterminer direction
-        if (clkState != dtState) {
-          // Rotation horaire
-          lastDirection = reverseDirection ? 
-            RotationDirection::COUNTER_CLOCKWISE : 
-            RotationDirection::CLOCKWISE;
-          
-          if (!limitEnabled || position < maxPosition) {
-            position++;
-          }
-        } else {
-          // Rotation anti-horaire
-          lastDirection = reverseDirection ? 
-            RotationDirection::CLOCKWISE : 
-            RotationDirection::COUNTER_CLOCKWISE;
-          
-          if (!limitEnabled || position > minPosition) {
-            position--;
-          }
-        }
-        
-        rotationDetected = true;
+    stepAccumulator += (int8_t)pgm_read_byte(&KY040_GRAY_TABLE[(quadState << 2) | current]);
+    quadState = current;
+    
+    int8_t direction = 0;
+    if (stepAccumulator >= KY040_STEPS_PER_DETENT) {
+      direction = 1;
+    } else if (stepAccumulator <= -KY040_STEPS_PER_DETENT) {
+      direction = -1;
+    }
+    
+    // Position de repos (CLK et DT hauts) : recaler l'accumulateur
+    if (direction != 0 || current == 0x03) {
+      stepAccumulator = 0;
+    }
+    if (direction == 0) return;
+    
+    if (reverseDirection) direction = -direction;
+    
+    if (direction > 0) {
+      lastDirection = RotationDirection::CLOCKWISE;
+      if (!limitEnabled || position < maxPosition) {
+        position++;
+      }
+      pushEvent(EncoderEvent::ROTATE_CW);
+    } else {
+      lastDirection = RotationDirection::COUNTER_CLOCKWISE;
+      if (!limitEnabled || position > minPosition) {
+        position--;
       }
+      pushEvent(EncoderEvent::ROTATE_CCW);
     }
     
-    lastStateCLK = clkState;
-    lastStateDT = dtState;
+    rotationDetected = true;
+  }
+  
+  /**
+   * @brief Routine d'interruption CLK/DT
+   */
+  static void handleInterrupt() {
+    if (instance) instance->decode();
   }
   
   /**
@@ -169,6 +262,7 @@ private:
         buttonPressTime = now;
         longPressDetected = false;
         lastButtonEvent = ButtonEvent::PRESSED;
+        pushButtonEvent(EncoderEvent::BUTTON_PRESSED);
       } else {
         // Bouton relâché
         unsigned long pressDuration = now - buttonPressTime;
@@ -177,6 +271,7 @@ private:
           lastButtonEvent = ButtonEvent::LONG_PRESS;
         } else {
           lastButtonEvent = ButtonEvent::CLICKED;
+          pushButtonEvent(EncoderEvent::BUTTON_CLICKED);
         }
       }
     }
@@ -186,6 +281,7 @@ private:
       if (now - buttonPressTime >= KY040_LONG_PRESS_TIME) {
         longPressDetected = true;
         lastButtonEvent = ButtonEvent::LONG_PRESS;
+        pushButtonEvent(EncoderEvent::BUTTON_LONG_PRESS);
       }
     }
   }
@@ -201,12 +297,19 @@ public:
     : pinCLK(clk),
       pinDT(dt),
       pinSW(sw),
+      regCLK(nullptr),
+      regDT(nullptr),
+      maskCLK(0),
+      maskDT(0),
+      interruptMode(false),
       position(0),
-      lastStateCLK(HIGH),
-      lastStateDT(HIGH),
+      quadState(0x03),
+      stepAccumulator(0),
       rotationDetected(false),
       lastDirection(RotationDirection::NONE),
-      lastRotationTime(0),
+      eventHead(0),
+      eventTail(0),
+      droppedEvents(0),
       buttonState(false),
       lastButtonState(false),
       lastButtonChange(0),
@@ -232,12 +335,29 @@ public:
     pinMode(pinDT, INPUT_PULLUP);
     pinMode(pinSW, INPUT_PULLUP);
     
+    // Registres d'entrée (lecture rapide en ISR)
+    regCLK = portInputRegister(digitalPinToPort(pinCLK));
+    regDT = portInputRegister(digitalPinToPort(pinDT));
+    maskCLK = digitalPinToBitMask(pinCLK);
+    maskDT = digitalPinToBitMask(pinDT);
+    
     // Lecture état initial
-    lastStateCLK = digitalRead(pinCLK);
-    lastStateDT = digitalRead(pinDT);
+    quadState = readQuadrature();
+    stepAccumulator = 0;
     buttonState = digitalRead(pinSW) == LOW;
     
     initialized = true;
+    
+    // Interruptions sur les deux fronts de CLK et DT
+    int8_t intCLK = digitalPinToInterrupt(pinCLK);
+    int8_t intDT = digitalPinToInterrupt(pinDT);
+    interruptMode = (intCLK != NOT_AN_INTERRUPT && intDT != NOT_AN_INTERRUPT);
+    if (interruptMode) {
+      instance = this;
+      attachInterrupt(intCLK, handleInterrupt, CHANGE);
+      attachInterrupt(intDT, handleInterrupt, CHANGE);
+    }
+    
     return true;
   }
 
@@ -246,22 +366,71 @@ public:
   /**
    * @brief Met à jour l'état de l'encodeur
    * 
-   * @details À appeler dans loop() aussi souvent que possible
-   * pour détecter les rotations et événements bouton.
+   * @details À appeler dans loop() pour les événements bouton.
+   * Les rotations sont décodées par interruption (scrutées ici
+   * uniquement si les broches n'ont pas d'interruption).
    */
   void update() {
     if (!initialized) return;
     
-    readEncoderState();
+    if (!interruptMode) {
+      decode();
+    }
     processButton();
   }
 
+  /**
+   * @brief Retire le prochain événement de la file
+   * @param event [out] Événement
+   * @return true si un événement a été lu
+   */
+  bool popEvent(EncoderEvent& event) {
+    uint8_t tail = eventTail;
+    if (tail == eventHead) return false;
+    
+    event = eventQueue[tail];
+    eventTail = (tail + 1) & (KY040_EVENT_QUEUE_SIZE - 1);
+    return true;
+  }
+
+  /**
+   * @brief Vérifie si des événements sont en attente
+   * @return true si la file n'est pas vide
+   */
+  bool hasEvent() const {
+    return eventTail != eventHead;
+  }
+
+  /**
+   * @brief Obtient le nombre d'événements perdus (file pleine)
+   * @return Nombre d'événements perdus
+   */
+  uint16_t getDroppedEvents() const {
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+    uint16_t dropped = droppedEvents;
+    SREG = oldSREG;
+    return dropped;
+  }
+
+  /**
+   * @brief Vérifie si le décodage se fait par interruption
+   * @return true si ISR active
+   */
+  bool isInterruptDriven() const {
+    return interruptMode;
+  }
+
   /**
    * @brief Obtient la position actuelle
    * @return Position de l'encodeur
    */
   int32_t getPosition() const {
-    return position;
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+    int32_t pos = position;
+    SREG = oldSREG;
+    return pos;
   }
 
   /**
@@ -269,14 +438,17 @@ public:
    * @param pos Nouvelle position
    */
   void setPosition(int32_t pos) {
+    uint8_t oldSREG = SREG;
+    noInterrupts();
     position = pos;
+    SREG = oldSREG;
   }
 
   /**
    * @brief Réinitialise la position à zéro
    */
   void resetPosition() {
-    position = 0;
+    setPosition(0);
   }
 
   /**
@@ -343,6 +515,8 @@ public:
    * @param max Position maximale
    */
   void setLimits(int32_t min, int32_t max) {
+    uint8_t oldSREG = SREG;
+    noInterrupts();
     minPosition = min;
     maxPosition = max;
     limitEnabled = true;
@@ -350,15 +524,19 @@ public:
     // Ajuster position si hors limites
     if (position < minPosition) position = minPosition;
     if (position > maxPosition) position = maxPosition;
+    SREG = oldSREG;
   }
 
   /**
    * @brief Désactive les limites de position
    */
   void removeLimits() {
+    uint8_t oldSREG = SREG;
+    noInterrupts();
     limitEnabled = false;
     minPosition = INT32_MIN;
     maxPosition = INT32_MAX;
+    SREG = oldSREG;
   }
 
   /**
@@ -387,7 +565,7 @@ public:
    */
   EncoderData getData() const {
     EncoderData data;
-    data.position = position;
+    data.position = getPosition();
     data.lastDirection = lastDirection;
     data.lastButtonEvent = lastButtonEvent;
     data.buttonPressed = buttonState;
@@ -426,4 +604,6 @@ public:
   }
 };
 
+KY040Encoder* KY040Encoder::instance = nullptr;
+
 #endif // KY040_ENCODER_H
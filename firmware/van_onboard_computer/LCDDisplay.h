@@ -13,7 +13,7 @@
  * - Affichage 20 colonnes × 4 lignes
  * - Interface I2C (adresse 0x27 ou 0x3F selon module)
  * - Rétro-éclairage contrôlable
- * - Caractères personnalisés (8 maximum)
+ * - Caractères personnalisés (8 maximum, attribués par GlyphCache.h)
  * 
  * @note Compatible avec la bibliothèque LiquidCrystal_I2C
  * @warning Vérifier l'adresse I2C de votre module avant utilisation
@@ -25,6 +25,8 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <LiquidCrystal_I2C.h>
+#include "I2CBus.h"
+#include "FixedFormat.h"
 
 // ============================================
 // CONFIGURATION MATÉRIELLE
@@ -33,6 +35,11 @@
 #define LCD_COLS            20        ///< Nombre de colonnes
 #define LCD_ROWS            4         ///< Nombre de lignes
 
+// PCF8574 en mode 4 bits : 2 quartets × 3 écritures (donnée, E haut,
+// E bas), chacune adresse + 1 octet
+#define LCD_I2C_BYTES_PER_WRITE  12     ///< Octets sur le bus par octet HD44780
+#define LCD_GLYPH_SLOTS     8         ///< Emplacements CGRAM (caractères 0-7)
+
 // ============================================
 // TYPES ET STRUCTURES
 // ============================================
@@ -44,7 +51,8 @@ enum class LCDStatus {
   NOT_INITIALIZED,   ///< LCD non initialisé
   READY,            ///< LCD prêt et fonctionnel
   ERROR_NOT_FOUND,  ///< LCD non détecté sur I2C
-  ERROR_COMM        ///< Erreur de communication
+  ERROR_COMM,       ///< Erreur de communication
+  ERROR_TIMEOUT     ///< Transaction I2C expirée (bus bloqué)
 };
 
 /**
@@ -57,6 +65,38 @@ enum class LCDAlignment {
   RIGHT     ///< Alignement à droite
 };
 
+// ============================================
+// PILOTE AVEC COMPTAGE
+// ============================================
+/**
+ * @class CountingLCD
+ * @brief LiquidCrystal_I2C qui compte les octets de données envoyés
+ * 
+ * @details Caractères et motifs CGRAM passent tous par write() ;
+ * les commandes (curseur, effacement) ne sont pas comptées.
+ */
+class CountingLCD : public LiquidCrystal_I2C {
+private:
+  uint32_t writes;
+
+public:
+  CountingLCD(uint8_t addr, uint8_t cols, uint8_t rows)
+    : LiquidCrystal_I2C(addr, cols, rows),
+      writes(0)
+  {
+  }
+
+  size_t write(uint8_t value) override {
+    writes++;
+    return LiquidCrystal_I2C::write(value);
+  }
+  using Print::write;
+
+  uint32_t getWriteCount() const {
+    return writes;
+  }
+};
+
 // ============================================
 // DÉFINITION CLASSE LCDDisplay
 // ============================================
@@ -87,11 +127,24 @@ enum class LCDAlignment {
  */
 class LCDDisplay {
 private:
-  LiquidCrystal_I2C lcd;          ///< Instance bibliothèque LCD
+  CountingLCD lcd;                ///< Instance bibliothèque LCD
   LCDStatus status;               ///< État du LCD
   uint8_t i2cAddress;             ///< Adresse I2C
   bool backlightState;            ///< État du rétro-éclairage
   
+  /**
+   * @brief Passe en erreur si une transaction I2C a expiré
+   * 
+   * @details Appelé à la fin de chaque méthode d'écriture : les
+   * suivantes deviennent sans effet (statut != READY), un écran complet
+   * sur bus bloqué coûterait une expiration par octet.
+   */
+  void checkBus() {
+    if (I2CBus::takeTimeout()) {
+      status = LCDStatus::ERROR_TIMEOUT;
+    }
+  }
+  
 public:
   /**
    * @brief Constructeur
@@ -119,8 +172,7 @@ public:
    */
   bool begin() {
     // Vérifier présence I2C
-    Wire.beginTransmission(i2cAddress);
-    if (Wire.endTransmission() != 0) {
+    if (!I2CBus::probe(i2cAddress)) {
       status = LCDStatus::ERROR_NOT_FOUND;
       return false;
     }
@@ -130,6 +182,11 @@ public:
     lcd.backlight();
     lcd.clear();
     
+    if (I2CBus::takeTimeout()) {
+      status = LCDStatus::ERROR_TIMEOUT;
+      return false;
+    }
+    
     status = LCDStatus::READY;
     backlightState = true;
     
@@ -168,6 +225,7 @@ public:
   void clear() {
     if (status != LCDStatus::READY) return;
     lcd.clear();
+    checkBus();
   }
 
   /**
@@ -182,6 +240,7 @@ public:
     for (uint8_t i = 0; i < LCD_COLS; i++) {
       lcd.print(' ');
     }
+    checkBus();
   }
 
   /**
@@ -192,6 +251,7 @@ public:
   void setCursor(uint8_t col, uint8_t row) {
     if (status != LCDStatus::READY) return;
     lcd.setCursor(col, row);
+    checkBus();
   }
 
   /**
@@ -206,6 +266,7 @@ public:
     
     lcd.setCursor(col, row);
     lcd.print(text);
+    checkBus();
   }
 
   /**
@@ -236,8 +297,10 @@ public:
     clearLine(row);
     
     // Afficher centré
+    if (status != LCDStatus::READY) return;
     lcd.setCursor(startCol, row);
     lcd.print(text);
+    checkBus();
   }
 
   /**
@@ -265,6 +328,7 @@ public:
     
     lcd.setCursor(startCol, row);
     lcd.print(text);
+    checkBus();
   }
 
   /**
@@ -309,6 +373,7 @@ public:
     if (status != LCDStatus::READY) return;
     lcd.backlight();
     backlightState = true;
+    checkBus();
   }
 
   /**
@@ -318,6 +383,7 @@ public:
     if (status != LCDStatus::READY) return;
     lcd.noBacklight();
     backlightState = false;
+    checkBus();
   }
 
   /**
@@ -365,6 +431,7 @@ public:
     if (percent > 100) percent = 100;
     
     clearLine(row);
+    if (status != LCDStatus::READY) return;
     
     uint8_t startCol = 0;
     uint8_t barWidth = LCD_COLS;
@@ -393,6 +460,7 @@ public:
     }
     
     lcd.print(']');
+    checkBus();
   }
 
   /**
@@ -405,6 +473,7 @@ public:
     
     // Ligne du haut
     clearLine(0);
+    if (status != LCDStatus::READY) return;
     lcd.setCursor(0, 0);
     for (uint8_t i = 0; i < LCD_COLS; i++) {
       lcd.print('=');
@@ -415,10 +484,12 @@ public:
     
     // Ligne du bas
     clearLine(2);
+    if (status != LCDStatus::READY) return;
     lcd.setCursor(0, 2);
     for (uint8_t i = 0; i < LCD_COLS; i++) {
       lcd.print('=');
     }
+    checkBus();
   }
 
   /**
@@ -434,15 +505,36 @@ public:
     if (row >= LCD_ROWS) return;
     
     char buffer[21];
-    char valueStr[10];
+    char valueStr[FIXED_FORMAT_MAX];
     
-    dtostrf(value, 0, decimals, valueStr);
+    FixedFormat::formatFloat(valueStr, value, decimals);
     snprintf(buffer, sizeof(buffer), "%s: %s%s", label, valueStr, unit);
     
     clearLine(row);
     printAt(0, row, buffer);
   }
 
+  /**
+   * @brief Écrit une suite de cellules à partir d'une position
+   * @param col Colonne (0-19)
+   * @param row Ligne (0-3)
+   * @param cells Codes caractères (0-7 = caractères personnalisés)
+   * @param length Nombre de cellules
+   * 
+   * @details Écriture octet par octet : les codes 0 (CGRAM) ne
+   * terminent pas la suite, contrairement à printAt().
+   */
+  void writeRun(uint8_t col, uint8_t row, const char* cells, uint8_t length) {
+    if (status != LCDStatus::READY) return;
+    if (row >= LCD_ROWS) return;
+    
+    lcd.setCursor(col, row);
+    for (uint8_t i = 0; i < length; i++) {
+      lcd.write((uint8_t)cells[i]);
+    }
+    checkBus();
+  }
+
   // CARACTÈRES PERSONNALISÉS
   // ------------------------------------------
   /**
@@ -452,8 +544,9 @@ public:
    */
   void createChar(uint8_t location, uint8_t charmap[]) {
     if (status != LCDStatus::READY) return;
-    if (location > 7) return;
+    if (location >= LCD_GLYPH_SLOTS) return;
     lcd.createChar(location, charmap);
+    checkBus();
   }
 
   /**
@@ -468,6 +561,17 @@ public:
     
     lcd.setCursor(col, row);
     lcd.write(location);
+    checkBus();
+  }
+
+  // STATISTIQUES
+  // ------------------------------------------
+  /**
+   * @brief Octets de données envoyés au HD44780 depuis le démarrage
+   * @return Nombre d'octets (× LCD_I2C_BYTES_PER_WRITE sur le bus)
+   */
+  uint32_t getWriteCount() const {
+    return lcd.getWriteCount();
   }
 
   // ACCÈS DIRECT À LA BIBLIOTHÈQUE
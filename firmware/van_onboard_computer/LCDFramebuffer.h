@@ -0,0 +1,277 @@
+/**
+ * @file LCDFramebuffer.h
+ * @brief Image de l'écran 20x4 en RAM, envoi des seules cellules modifiées
+ * @author Frédéric BAILLON
+ * @version 0.1.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Chaque écran effaçait le LCD (clear() : 2 ms d'attente) puis
+ * réécrivait ses 80 cellules toutes les 100 ms. Les écrans dessinent
+ * désormais dans cette image ; une cellule n'est marquée modifiée que
+ * si son contenu change, et flush() n'envoie que les suites de
+ * cellules modifiées (un positionnement curseur par suite).
+ *
+ * Après une écriture directe sur le LCD (message, réveil,
+ * ré-initialisation), invalidate() force le renvoi complet.
+ *
+ * Caractères personnalisés : glyph() attribue un emplacement CGRAM
+ * (GlyphCache.h) ; les motifs sont envoyés par flush(), avant les
+ * cellules qui les affichent.
+ *
+ * Mémoire : 80 octets d'image + 10 octets de marquage + GlyphCache.
+ */
+
+#ifndef LCD_FRAMEBUFFER_H
+#define LCD_FRAMEBUFFER_H
+
+#include <Arduino.h>
+#include "LCDDisplay.h"
+#include "GlyphCache.h"
+
+// ============================================
+// CLASSE LCDFramebuffer
+// ============================================
+/**
+ * @class LCDFramebuffer
+ * @brief Image RAM de l'écran avec marquage des cellules modifiées
+ */
+class LCDFramebuffer {
+private:
+  char cells[LCD_ROWS][LCD_COLS];               ///< Contenu voulu
+  uint8_t dirty[(LCD_ROWS * LCD_COLS + 7) / 8]; ///< Cellules à envoyer (1 bit chacune)
+  GlyphCache glyphs;                            ///< Emplacements CGRAM
+
+  // Statistiques
+  uint32_t flushedCells;      ///< Cellules envoyées au LCD (cumul)
+  uint16_t flushCount;        ///< Appels de flush() ayant envoyé des cellules
+
+  static uint8_t index(uint8_t col, uint8_t row) {
+    return row * LCD_COLS + col;
+  }
+
+  bool isDirty(uint8_t col, uint8_t row) const {
+    uint8_t i = index(col, row);
+    return dirty[i >> 3] & (1 << (i & 7));
+  }
+
+  void markDirty(uint8_t col, uint8_t row) {
+    uint8_t i = index(col, row);
+    dirty[i >> 3] |= 1 << (i & 7);
+  }
+
+  void markClean(uint8_t col, uint8_t row) {
+    uint8_t i = index(col, row);
+    dirty[i >> 3] &= ~(1 << (i & 7));
+  }
+
+public:
+  /**
+   * @brief Constructeur : image vide, tout à envoyer
+   */
+  LCDFramebuffer()
+    : flushedCells(0),
+      flushCount(0)
+  {
+    memset(cells, ' ', sizeof(cells));
+    invalidate();
+  }
+
+  // ============================================
+  // DESSIN
+  // ============================================
+
+  /**
+   * @brief Écrit une cellule
+   * @param col Colonne (0-19)
+   * @param row Ligne (0-3)
+   * @param c Code caractère (0-7 = caractère personnalisé)
+   */
+  void put(uint8_t col, uint8_t row, char c) {
+    if (col >= LCD_COLS || row >= LCD_ROWS) return;
+    if (cells[row][col] == c) return;
+    cells[row][col] = c;
+    markDirty(col, row);
+  }
+
+  /**
+   * @brief Remplit des cellules avec un même caractère
+   * @param col Colonne de départ
+   * @param row Ligne
+   * @param width Nombre de cellules
+   * @param c Caractère
+   */
+  void fill(uint8_t col, uint8_t row, uint8_t width, char c = ' ') {
+    for (uint8_t i = 0; i < width; i++) {
+      put(col + i, row, c);
+    }
+  }
+
+  /**
+   * @brief Écrit un texte (RAM), tronqué au bord de l'écran
+   * @return Colonne suivant le texte
+   */
+  uint8_t print(uint8_t col, uint8_t row, const char* text) {
+    while (*text && col < LCD_COLS) {
+      put(col++, row, *text++);
+    }
+    return col;
+  }
+
+  /**
+   * @brief Écrit un texte en flash (PSTR), tronqué au bord de l'écran
+   * @return Colonne suivant le texte
+   */
+  uint8_t print_P(uint8_t col, uint8_t row, PGM_P text) {
+    char c;
+    while ((c = pgm_read_byte(text++)) && col < LCD_COLS) {
+      put(col++, row, c);
+    }
+    return col;
+  }
+
+  /**
+   * @brief Écrit une ligne entière, texte centré
+   * @param text Texte (RAM)
+   * @param row Ligne
+   */
+  void printCenter(const char* text, uint8_t row) {
+    uint8_t len = strlen(text);
+    if (len > LCD_COLS) len = LCD_COLS;
+    uint8_t start = (LCD_COLS - len) / 2;
+
+    fill(0, row, start);
+    uint8_t end = print(start, row, text);
+    fill(end, row, LCD_COLS - end);
+  }
+
+  /**
+   * @brief Écrit une ligne entière : texte à partir de col, espaces ailleurs
+   * @param row Ligne
+   * @param text Texte (RAM)
+   * @param col Colonne de départ du texte
+   *
+   * @details Préférer à clear() + print() : les cellules inchangées
+   * d'une image à l'autre ne sont pas renvoyées.
+   */
+  void printLine(uint8_t row, const char* text, uint8_t col = 0) {
+    fill(0, row, col);
+    uint8_t end = print(col, row, text);
+    fill(end, row, LCD_COLS - end);
+  }
+
+  /**
+   * @brief Début d'une image (à appeler avant de dessiner)
+   *
+   * @details Les caractères personnalisés non redemandés dans cette
+   * image deviennent remplaçables.
+   */
+  void beginFrame() {
+    glyphs.beginFrame();
+  }
+
+  /**
+   * @brief Code caractère d'un motif prédéfini
+   * @param id Motif
+   * @return Emplacement CGRAM (0-7) ou caractère ROM de repli
+   */
+  char glyph(GlyphId id) {
+    return glyphs.request(id);
+  }
+
+  /**
+   * @brief Code caractère d'un motif calculé
+   * @param bitmap 8 lignes de 5 bits
+   * @param fallback Caractère ROM si aucun emplacement disponible
+   */
+  char glyph(const uint8_t bitmap[8], char fallback) {
+    return glyphs.request(bitmap, fallback);
+  }
+
+  /**
+   * @brief Efface toute l'image (espaces)
+   */
+  void clear() {
+    for (uint8_t row = 0; row < LCD_ROWS; row++) {
+      fill(0, row, LCD_COLS);
+    }
+  }
+
+  // ============================================
+  // ENVOI AU LCD
+  // ============================================
+
+  /**
+   * @brief Marque toutes les cellules à renvoyer
+   *
+   * @details Après effacement ou écriture directe du LCD.
+   */
+  void invalidate() {
+    memset(dirty, 0xFF, sizeof(dirty));
+  }
+
+  /**
+   * @brief Marque les motifs CGRAM à renvoyer (LCD ré-initialisé)
+   */
+  void invalidateGlyphs() {
+    glyphs.invalidate();
+  }
+
+  /**
+   * @brief Envoie les cellules modifiées
+   * @param lcd Écran
+   * @return Nombre de cellules envoyées
+   *
+   * @details Motifs CGRAM en attente d'abord, puis une écriture par
+   * suite de cellules modifiées contiguës sur une ligne. Si le LCD
+   * n'est pas prêt, les cellules restent marquées (renvoyées après
+   * ré-initialisation).
+   */
+  uint8_t flush(LCDDisplay& lcd) {
+    if (!lcd.isReady()) return 0;
+    glyphs.flush(lcd);
+
+    uint8_t sent = 0;
+    for (uint8_t row = 0; row < LCD_ROWS; row++) {
+      uint8_t col = 0;
+      while (col < LCD_COLS) {
+        if (!isDirty(col, row)) {
+          col++;
+          continue;
+        }
+
+        uint8_t start = col;
+        while (col < LCD_COLS && isDirty(col, row)) {
+          markClean(col, row);
+          col++;
+        }
+        lcd.writeRun(start, row, &cells[row][start], col - start);
+        sent += col - start;
+      }
+    }
+
+    if (sent) {
+      flushedCells += sent;
+      if (flushCount < 0xFFFF) flushCount++;
+    }
+    return sent;
+  }
+
+  // ============================================
+  // GETTERS
+  // ============================================
+
+  /**
+   * @brief Contenu d'une cellule
+   */
+  char get(uint8_t col, uint8_t row) const {
+    if (col >= LCD_COLS || row >= LCD_ROWS) return ' ';
+    return cells[row][col];
+  }
+
+  uint32_t getFlushedCells() const { return flushedCells; }
+  uint16_t getFlushCount() const { return flushCount; }
+  const GlyphCache& getGlyphCache() const { return glyphs; }
+};
+
+#endif // LCD_FRAMEBUFFER_H
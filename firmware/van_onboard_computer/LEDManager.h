@@ -12,6 +12,8 @@
  * - Indicateurs gaz : CO (LED 4), GPL (LED 5)
  * - Indicateurs tensions : 12V (LED 6), 5V (LED 7)
  * - Animation en mode alerte
+ * - Moteur d'effets non-bloquant (images clés interpolées dans le temps)
+ * - Détection de changement : FastLED.show() uniquement si l'image change
  * 
  * Répartition des LEDs :
  * LED 0-3 : Barre puissance (gradient selon charge)
@@ -28,6 +30,62 @@
 #include <FastLED.h>
 #include "config.h"
 #include "SystemData.h"
+#include "Settings.h"
+
+// ============================================
+// TYPES ET STRUCTURES
+// ============================================
+/**
+ * @enum LEDEffect
+ * @brief Effets animés du bandeau (joués sans delay())
+ */
+enum class LEDEffect {
+  NONE,       ///< Affichage standard (indicateurs)
+  BOOT,       ///< Démarrage : balayage bleu puis flash vert
+  PREHEAT,    ///< Progression du pré-chauffage (LED de tête pulsée)
+  ALERT,      ///< Pulsation alerte DANGER/CRITICAL
+  TEST        ///< Pattern de test (2 s)
+};
+
+/**
+ * @struct LEDKeyframe
+ * @brief Image clé d'une animation : intensité à un instant donné
+ * 
+ * @details
+ * Entre deux images clés, l'intensité est interpolée linéairement.
+ * Les pistes sont stockées en PROGMEM.
+ */
+struct LEDKeyframe {
+  uint16_t time;    ///< Instant depuis le début du cycle (ms)
+  uint8_t level;    ///< Intensité (0-255)
+};
+
+// ============================================
+// PISTES D'ANIMATION (PROGMEM)
+// ============================================
+#define LED_BOOT_SWEEP_STEP     100     ///< Durée par LED du balayage de démarrage (ms)
+
+/// Flash de fin de démarrage (fondu de sortie)
+const LEDKeyframe LED_KEYS_BOOT_FLASH[] PROGMEM = {
+  {0, 255}, {150, 255}, {300, 0}
+};
+
+/// Pulsation de la LED de tête pendant le pré-chauffage
+const LEDKeyframe LED_KEYS_PREHEAT_PULSE[] PROGMEM = {
+  {0, 40}, {750, 255}, {1500, 40}
+};
+
+/// Clignotement adouci des alertes (période 2 x ALERT_BLINK_INTERVAL)
+const LEDKeyframe LED_KEYS_ALERT_PULSE[] PROGMEM = {
+  {0, 255},
+  {ALERT_BLINK_INTERVAL - 100, 255},
+  {ALERT_BLINK_INTERVAL, 0},
+  {2 * ALERT_BLINK_INTERVAL - 100, 0},
+  {2 * ALERT_BLINK_INTERVAL, 255}
+};
+
+#define LED_KEYS_COUNT(keys)    (sizeof(keys) / sizeof(LEDKeyframe))
+#define LED_LEVEL_STEP_MASK     0xF8    ///< Quantification des intensités (32 niveaux)
 
 // ============================================
 // CLASSE LEDManager
@@ -46,10 +104,23 @@ private:
   
   // Timing
   unsigned long lastUpdate;
-  unsigned long lastBlink;
   
-  // Animation alerte
-  bool blinkState;
+  // Moteur d'effets
+  LEDEffect effect;             ///< Effet ponctuel en cours (BOOT, TEST)
+  unsigned long effectStart;    ///< Début de l'effet en cours
+  uint8_t preheatPercent;       ///< Progression pré-chauffage (0-100)
+  
+  // Détection de changement
+  CRGB shownFrame[LED_COUNT];   ///< Dernière image envoyée au bandeau
+  uint8_t shownBrightness;      ///< Luminosité de la dernière image envoyée
+  bool frameValid;              ///< shownFrame reflète le bandeau
+  
+  // Statistiques
+  uint32_t showCount;           ///< Nombre de FastLED.show() effectués
+  uint32_t skipCount;           ///< Nombre d'images identiques non envoyées
+  uint16_t showsInWindow;       ///< show() dans la minute en cours
+  uint16_t showsLastMinute;     ///< show() sur la dernière minute complète
+  unsigned long windowStart;    ///< Début de la fenêtre de comptage
   
   // Flags
   bool initialized;
@@ -90,8 +161,16 @@ public:
   LEDManager(SystemState& sysState) 
     : state(sysState),
       lastUpdate(0),
-      lastBlink(0),
-      blinkState(false),
+      effect(LEDEffect::NONE),
+      effectStart(0),
+      preheatPercent(0),
+      shownBrightness(0),
+      frameValid(false),
+      showCount(0),
+      skipCount(0),
+      showsInWindow(0),
+      showsLastMinute(0),
+      windowStart(0),
       initialized(false)
   {
   }
@@ -103,6 +182,8 @@ public:
   /**
    * @brief Initialise le bandeau LED
    * @return true si succès
+   * 
+   * @details Non-bloquant : le test visuel est assuré par l'effet BOOT.
    */
   bool begin() {
     DEBUG_PRINTLN(F("=== INITIALISATION LED WS2812B ==="));
@@ -111,19 +192,14 @@ public:
     FastLED.addLeds<WS2812B, PIN_WS2812B, GRB>(leds, LED_COUNT);
     FastLED.setBrightness(LED_BRIGHTNESS);
     
-    // Test : toutes les LEDs en blanc
-    fill_solid(leds, LED_COUNT, CRGB::White);
-    FastLED.show();
-    delay(500);
-    
-    // Éteindre
-    fill_solid(leds, LED_COUNT, CRGB::Black);
-    FastLED.show();
-    
     state.sensors.leds = true;
     initialized = true;
     
-    DEBUG_PRINTLN(F("[OK] LED WS2812B initialisees"));
+    // Éteindre
+    fill_solid(leds, LED_COUNT, COLOR_OFF);
+    showFrame(true);
+    
+    LOG_INFO("LED WS2812B initialisees");
     return true;
   }
   
@@ -137,19 +213,42 @@ public:
    * @details
    * À appeler régulièrement dans loop().
    * Rafraîchit selon INTERVAL_LEDS (50ms).
+   * 
+   * Priorité des effets : BOOT/TEST > pré-chauffage > alerte > standard.
+   * FastLED.show() n'est appelé que si l'image change (voir showFrame()).
    */
   void update() {
     if (!initialized) return;
     
     unsigned long now = millis();
+    rollWindow(now);
     
     // Limiter fréquence rafraîchissement
-    if (now - lastUpdate < INTERVAL_LEDS) {
+    if (now - lastUpdate < settings.values.intervalLeds) {
       return;
     }
     lastUpdate = now;
     
-    // Mode alerte : animation clignotante
+    // Effet ponctuel en cours (démarrage, test)
+    if (effect != LEDEffect::NONE) {
+      uint16_t elapsed = (uint16_t)min(now - effectStart, 0xFFFFUL);
+      bool running = (effect == LEDEffect::BOOT) ? renderBoot(elapsed)
+                                                 : renderTest(elapsed);
+      showFrame();
+      if (!running) {
+        effect = LEDEffect::NONE;
+      }
+      return;
+    }
+    
+    // Pré-chauffage : progression animée
+    if (state.mode == SystemMode::MODE_PREHEAT) {
+      renderPreheat(now);
+      showFrame();
+      return;
+    }
+    
+    // Mode alerte : animation pulsée
     if (state.mode == SystemMode::MODE_ALERT && 
         state.alerts.currentLevel >= AlertLevel::DANGER) {
       updateAlertAnimation();
@@ -161,7 +260,7 @@ public:
     updateGasIndicators();
     updateVoltageIndicators();
     
-    FastLED.show();
+    showFrame();
   }
   
   /**
@@ -200,9 +299,9 @@ public:
     // LED 4 : CO
     if (state.safety.coValid && state.safety.mq7Preheated) {
       leds[LED_CO] = getGasColor(state.safety.coPPM, 
-                                  CO_THRESHOLD_INFO,
-                                  CO_THRESHOLD_WARNING,
-                                  CO_THRESHOLD_DANGER);
+                                  settings.values.coInfo,
+                                  settings.values.coWarning,
+                                  settings.values.coDanger);
     } else {
       leds[LED_CO] = COLOR_OFF; // Pré-chauffage en cours
     }
@@ -210,9 +309,9 @@ public:
     // LED 5 : GPL
     if (state.safety.gplValid && state.safety.mq2Preheated) {
       leds[LED_GPL] = getGasColor(state.safety.gplPPM, 
-                                   GPL_THRESHOLD_INFO,
-                                   GPL_THRESHOLD_WARNING,
-                                   GPL_THRESHOLD_DANGER);
+                                   settings.values.gplInfo,
+                                   settings.values.gplWarning,
+                                   settings.values.gplDanger);
     } else {
       leds[LED_GPL] = COLOR_OFF; // Pré-chauffage en cours
     }
@@ -225,10 +324,10 @@ public:
     // LED 6 : 12V
     if (state.power.voltage12VValid) {
       leds[LED_VOLTAGE_12V] = getVoltageColor(state.power.voltage12V,
-                                               VOLTAGE_12V_MIN,
-                                               VOLTAGE_12V_WARNING,
-                                               VOLTAGE_12V_NOMINAL,
-                                               VOLTAGE_12V_CHARGING);
+                                               settings.values.voltage12VMin,
+                                               settings.values.voltage12VWarning,
+                                               settings.values.voltage12VNominal,
+                                               settings.values.voltage12VCharging);
     } else {
       leds[LED_VOLTAGE_12V] = COLOR_OFF;
     }
@@ -236,10 +335,10 @@ public:
     // LED 7 : 5V
     if (state.power.voltage5VValid) {
       leds[LED_VOLTAGE_5V] = getVoltageColor(state.power.voltage5V,
-                                              VOLTAGE_5V_MIN,
-                                              VOLTAGE_5V_MIN + 0.2,
-                                              VOLTAGE_5V_NOMINAL,
-                                              VOLTAGE_5V_MAX);
+                                              settings.values.voltage5VMin,
+                                              settings.values.voltage5VMin + 0.2,
+                                              settings.values.voltage5VNominal,
+                                              settings.values.voltage5VMax);
     } else {
       leds[LED_VOLTAGE_5V] = COLOR_OFF;
     }
@@ -249,31 +348,197 @@ public:
    * @brief Animation en mode alerte
    * 
    * @details
-   * Toutes les LEDs clignotent en rouge (CRITICAL) ou orange (DANGER).
+   * Toutes les LEDs pulsent en rouge (CRITICAL) ou orange (DANGER),
+   * à la cadence de ALERT_BLINK_INTERVAL avec fondus interpolés.
    */
   void updateAlertAnimation() {
-    unsigned long now = millis();
+    uint16_t t = millis() % (2 * ALERT_BLINK_INTERVAL);
+    uint8_t level = interpolateKeyframes(LED_KEYS_ALERT_PULSE,
+                                         LED_KEYS_COUNT(LED_KEYS_ALERT_PULSE), t);
+    
+    bool critical = (state.alerts.currentLevel == AlertLevel::CRITICAL);
+    CRGB alertColor = critical ? COLOR_ALERT_CRITICAL : COLOR_ALERT_DANGER;
+    
+    fill_solid(leds, LED_COUNT, alertColor.nscale8(level));
+    
+    showFrame();
+  }
+  
+  // ============================================
+  // MOTEUR D'EFFETS
+  // ============================================
+  
+  /**
+   * @brief Démarre un effet ponctuel
+   * @param newEffect Effet à jouer (BOOT, TEST)
+   */
+  void startEffect(LEDEffect newEffect) {
+    if (!initialized) return;
+    effect = newEffect;
+    effectStart = millis();
+    lastUpdate = 0; // Première image immédiate
+  }
+  
+  /**
+   * @brief Interpole l'intensité d'une piste d'images clés
+   * @param keys Piste en PROGMEM (triée par temps croissant)
+   * @param count Nombre d'images clés
+   * @param t Instant dans la piste (ms)
+   * @return Intensité interpolée (0-255)
+   */
+  static uint8_t interpolateKeyframes(const LEDKeyframe* keys, uint8_t count, uint16_t t) {
+    // Quantifier : les fondus produisent des images identiques consécutives
+    uint8_t level = interpolateRaw(keys, count, t) & LED_LEVEL_STEP_MASK;
+    return (level == LED_LEVEL_STEP_MASK) ? 255 : level;
+  }
+  
+  /**
+   * @brief Interpolation linéaire brute d'une piste d'images clés
+   * @param keys Piste en PROGMEM
+   * @param count Nombre d'images clés
+   * @param t Instant dans la piste (ms)
+   * @return Intensité interpolée (0-255)
+   */
+  static uint8_t interpolateRaw(const LEDKeyframe* keys, uint8_t count, uint16_t t) {
+    LEDKeyframe a, b;
+    memcpy_P(&a, &keys[0], sizeof(LEDKeyframe));
+    if (t <= a.time) return a.level;
     
-    // Clignotement toutes les 500ms
-    if (now - lastBlink >= ALERT_BLINK_INTERVAL) {
-      lastBlink = now;
-      blinkState = !blinkState;
+    for (uint8_t i = 1; i < count; i++) {
+      memcpy_P(&b, &keys[i], sizeof(LEDKeyframe));
+      if (t < b.time) {
+        int16_t delta = (int16_t)b.level - (int16_t)a.level;
+        return a.level + (int16_t)(((int32_t)delta * (t - a.time)) / (b.time - a.time));
+      }
+      a = b;
     }
     
-    CRGB alertColor;
-    if (state.alerts.currentLevel == AlertLevel::CRITICAL) {
-      alertColor = COLOR_ALERT_CRITICAL;
-    } else {
-      alertColor = COLOR_ALERT_DANGER;
+    return a.level;
+  }
+  
+  /**
+   * @brief Clôt la fenêtre de comptage d'une minute si elle est écoulée
+   * @param now millis()
+   * 
+   * @details Appelé par update() même sans envoi : une minute sans
+   * image nouvelle compte 0 show().
+   */
+  void rollWindow(unsigned long now) {
+    if (now - windowStart < 60000UL) return;
+    showsLastMinute = (now - windowStart < 120000UL) ? showsInWindow : 0;
+    showsInWindow = 0;
+    windowStart = now;
+  }
+  
+  /**
+   * @brief Envoie l'image au bandeau si elle a changé
+   * @param force true pour envoyer sans comparaison
+   * @return true si FastLED.show() a été appelé
+   * 
+   * @details
+   * Compare leds[] et la luminosité à la dernière image envoyée
+   * (24 octets). FastLED.show() masque les interruptions pendant
+   * ~240 µs : l'éviter préserve l'encodeur et la réception série.
+   */
+  bool showFrame(bool force = false) {
+    if (!initialized) return false;
+    
+    uint8_t brightness = FastLED.getBrightness();
+    
+    if (!force && frameValid && brightness == shownBrightness &&
+        memcmp(leds, shownFrame, sizeof(shownFrame)) == 0) {
+      skipCount++;
+      return false;
     }
     
-    if (blinkState) {
-      fill_solid(leds, LED_COUNT, alertColor);
-    } else {
+    FastLED.show();
+    
+    memcpy(shownFrame, leds, sizeof(shownFrame));
+    shownBrightness = brightness;
+    frameValid = true;
+    
+    // Comptage par fenêtre d'une minute
+    rollWindow(millis());
+    showsInWindow++;
+    showCount++;
+    
+    return true;
+  }
+  
+  /**
+   * @brief Calcule une image de l'animation de démarrage
+   * @param elapsed Temps écoulé depuis le début (ms)
+   * @return false quand l'animation est terminée
+   */
+  bool renderBoot(uint16_t elapsed) {
+    fill_solid(leds, LED_COUNT, COLOR_OFF);
+    
+    // Balayage gauche → droite
+    uint16_t sweepTime = LED_BOOT_SWEEP_STEP * LED_COUNT;
+    if (elapsed < sweepTime) {
+      uint8_t position = elapsed / LED_BOOT_SWEEP_STEP;
+      leds[position] = CRGB::Blue;
+      return true;
+    }
+    
+    // Flash final avec fondu
+    uint16_t t = elapsed - sweepTime;
+    uint8_t level = interpolateKeyframes(LED_KEYS_BOOT_FLASH,
+                                         LED_KEYS_COUNT(LED_KEYS_BOOT_FLASH), t);
+    CRGB flash = CRGB::Green;
+    fill_solid(leds, LED_COUNT, flash.nscale8(level));
+    
+    return level > 0;
+  }
+  
+  /**
+   * @brief Calcule une image du pattern de test
+   * @param elapsed Temps écoulé depuis le début (ms)
+   * @return false quand le test est terminé (2 s)
+   */
+  bool renderTest(uint16_t elapsed) {
+    if (elapsed >= 2000) {
       fill_solid(leds, LED_COUNT, COLOR_OFF);
+      return false;
     }
     
-    FastLED.show();
+    // Afficher chaque LED en couleur différente
+    leds[0] = CRGB::Red;
+    leds[1] = CRGB::Green;
+    leds[2] = CRGB::Blue;
+    leds[3] = CRGB::Yellow;
+    leds[4] = CRGB::Cyan;
+    leds[5] = CRGB::Magenta;
+    leds[6] = CRGB::White;
+    leds[7] = CRGB::Orange;
+    return true;
+  }
+  
+  /**
+   * @brief Calcule une image de progression du pré-chauffage
+   * @param now Timestamp actuel
+   * 
+   * @details
+   * LEDs pleines en orange selon la progression, LED de tête pulsée
+   * (indique que le pré-chauffage est en cours).
+   */
+  void renderPreheat(unsigned long now) {
+    uint8_t activeLeds = map(preheatPercent, 0, 100, 0, LED_COUNT);
+    
+    uint16_t t = now % 1500;
+    uint8_t level = interpolateKeyframes(LED_KEYS_PREHEAT_PULSE,
+                                         LED_KEYS_COUNT(LED_KEYS_PREHEAT_PULSE), t);
+    
+    for (uint8_t i = 0; i < LED_COUNT; i++) {
+      if (i < activeLeds) {
+        leds[i] = CRGB::Orange;
+      } else if (i == activeLeds) {
+        CRGB head = CRGB::Orange;
+        leds[i] = head.nscale8(level);
+      } else {
+        leds[i] = COLOR_OFF;
+      }
+    }
   }
   
   // ============================================
@@ -347,71 +612,37 @@ public:
   // ============================================
   
   /**
-   * @brief Affiche une animation de démarrage
+   * @brief Lance l'animation de démarrage (non-bloquant)
+   * 
+   * @details Jouée par update() : balayage bleu puis flash vert.
    */
   void bootAnimation() {
-    if (!initialized) return;
-    
-    // Balayage gauche → droite
-    for (uint8_t i = 0; i < LED_COUNT; i++) {
-      leds[i] = CRGB::Blue;
-      FastLED.show();
-      delay(100);
-      leds[i] = COLOR_OFF;
-    }
-    
-    // Flash final
-    fill_solid(leds, LED_COUNT, CRGB::Green);
-    FastLED.show();
-    delay(200);
-    fill_solid(leds, LED_COUNT, COLOR_OFF);
-    FastLED.show();
+    startEffect(LEDEffect::BOOT);
   }
   
   /**
-   * @brief Affiche une animation de pré-chauffage
+   * @brief Met à jour la progression de l'animation de pré-chauffage
    * @param percent Pourcentage de pré-chauffage (0-100)
+   * 
+   * @details L'animation est jouée par update() tant que le mode est MODE_PREHEAT.
    */
   void preheatAnimation(uint8_t percent) {
-    if (!initialized) return;
-    
-    // Nombre de LEDs à allumer
-    uint8_t activeLeds = map(percent, 0, 100, 0, LED_COUNT);
-    
-    // Allumer progressivement en orange
-    for (uint8_t i = 0; i < LED_COUNT; i++) {
-      if (i < activeLeds) {
-        leds[i] = CRGB::Orange;
-      } else {
-        leds[i] = COLOR_OFF;
-      }
-    }
-    
-    FastLED.show();
+    preheatPercent = (percent > 100) ? 100 : percent;
   }
   
   /**
-   * @brief Affiche un pattern de test
+   * @brief Lance le pattern de test pendant 2 s (non-bloquant)
    */
   void testPattern() {
-    if (!initialized) return;
-    
-    // Afficher chaque LED en couleur différente
-    leds[0] = CRGB::Red;
-    leds[1] = CRGB::Green;
-    leds[2] = CRGB::Blue;
-    leds[3] = CRGB::Yellow;
-    leds[4] = CRGB::Cyan;
-    leds[5] = CRGB::Magenta;
-    leds[6] = CRGB::White;
-    leds[7] = CRGB::Orange;
-    
-    FastLED.show();
-    delay(2000);
-    
-    // Éteindre
-    fill_solid(leds, LED_COUNT, COLOR_OFF);
-    FastLED.show();
+    startEffect(LEDEffect::TEST);
+  }
+  
+  /**
+   * @brief Vérifie si un effet ponctuel est en cours
+   * @return true si BOOT ou TEST en cours
+   */
+  bool isEffectRunning() const {
+    return effect != LEDEffect::NONE;
   }
   
   /**
@@ -420,7 +651,7 @@ public:
   void clear() {
     if (!initialized) return;
     fill_solid(leds, LED_COUNT, COLOR_OFF);
-    FastLED.show();
+    showFrame();
   }
   
   /**
@@ -430,7 +661,7 @@ public:
   void setBrightness(uint8_t brightness) {
     if (!initialized) return;
     FastLED.setBrightness(brightness);
-    FastLED.show();
+    showFrame();
   }
   
   /**
@@ -441,7 +672,7 @@ public:
   void setLED(uint8_t index, CRGB color) {
     if (!initialized || index >= LED_COUNT) return;
     leds[index] = color;
-    FastLED.show();
+    showFrame();
   }
   
   /**
@@ -451,7 +682,7 @@ public:
   void setAll(CRGB color) {
     if (!initialized) return;
     fill_solid(leds, LED_COUNT, color);
-    FastLED.show();
+    showFrame();
   }
   
   // ============================================
@@ -473,6 +704,31 @@ public:
   uint8_t getBrightness() const {
     return FastLED.getBrightness();
   }
+  
+  /**
+   * @brief Obtient le nombre total de FastLED.show()
+   * @return Nombre d'envois au bandeau
+   */
+  uint32_t getShowCount() const {
+    return showCount;
+  }
+  
+  /**
+   * @brief Obtient le nombre d'images identiques non envoyées
+   * @return Nombre d'envois évités
+   */
+  uint32_t getSkipCount() const {
+    return skipCount;
+  }
+  
+  /**
+   * @brief Obtient le nombre de FastLED.show() par minute
+   * @return Envois sur la dernière minute complète
+   *         (minute en cours tant qu'aucune n'est complète)
+   */
+  uint16_t getShowsPerMinute() const {
+    return (showCount > showsInWindow) ? showsLastMinute : showsInWindow;
+  }
 };
 
 #endif // LED_MANAGER_H
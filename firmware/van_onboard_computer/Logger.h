@@ -0,0 +1,487 @@
+/**
+ * @file Logger.h
+ * @brief Journal de debug bufferisé, non-bloquant
+ * @author Frédéric BAILLON
+ * @version 0.2.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Les messages sont écrits dans un tampon circulaire statique
+ * (LOG_BUFFER_SIZE), puis vidés vers Serial par drain() quand le
+ * tampon TX matériel a de la place : loop() n'attend jamais le port série.
+ *
+ * - Écriture protégée (interruptions masquées) : utilisable depuis une ISR
+ * - Tampon plein : le reste de la ligne est abandonné et compté,
+ *   un marqueur "[LOG] n ligne(s) perdue(s)" est émis ensuite
+ * - Mode synchrone (setup()) : tampon plein → vidage bloquant, rien n'est perdu
+ *
+ * Le filtrage par niveau (LOG_ERROR/LOG_WARN/LOG_INFO/LOG_DEBUG) est
+ * fait à la compilation dans config.h : les messages filtrés
+ * disparaissent de la flash.
+ *
+ * Journal à jetons (USE_LOG_TOKENS) :
+ * - Chaque format LOG_* est remplacé à la compilation par son empreinte
+ *   FNV-1a 32 bits : la chaîne n'est plus stockée en flash
+ * - Trame : [0xA5][0x5B][niveau][longueur][jeton][arguments][CRC16 LSB][CRC16 MSB]['\n']
+ * - Arguments binaires little-endian, selon les promotions printf :
+ *   int 16 bits, long 32 bits, float 32 bits, chaîne terminée par 0
+ * - tools/scripts/log_detokenizer.py reconstruit le dictionnaire depuis
+ *   les sources et rétablit le texte
+ */
+
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <Arduino.h>
+#include "DashboardProtocol.h"
+
+// ============================================
+// CONFIGURATION
+// ============================================
+#ifndef LOG_BUFFER_SIZE
+#define LOG_BUFFER_SIZE         512     ///< Taille du tampon circulaire (octets)
+#endif
+
+#define LOG_FORMAT_BUFFER       96      ///< Tampon de formatage printf (octets)
+
+#define LOG_TOKEN_SYNC_1        0xA5    ///< Premier octet d'en-tête (commun à la télémétrie)
+#define LOG_TOKEN_SYNC_2        0x5B    ///< Second octet d'en-tête (trame de journal)
+#define LOG_TOKEN_PAYLOAD_MAX   32      ///< Jeton + arguments (octets)
+
+// ============================================
+// JETONS
+// ============================================
+/**
+ * @brief Empreinte FNV-1a 32 bits d'un format (évaluée à la compilation)
+ * @param text Format
+ * @param hash Valeur initiale (récursion)
+ * @return Jeton
+ */
+constexpr uint32_t logTokenHash(const char* text, uint32_t hash = 2166136261UL) {
+  return *text ? logTokenHash(text + 1, (uint32_t)((hash ^ (uint8_t)*text) * 16777619UL))
+               : hash;
+}
+
+/**
+ * @brief Force l'évaluation du jeton à la compilation
+ *
+ * @details Le format n'est utilisé que comme argument de template :
+ * aucune copie n'est émise en flash.
+ */
+template <uint32_t TOKEN>
+struct LogToken {
+  static const uint32_t value = TOKEN;
+};
+
+#define LOG_TOKEN_ID(fmt)       (LogToken<logTokenHash(fmt)>::value)
+
+/**
+ * @class LogTokenRecord
+ * @brief Construction d'une trame de journal à jetons
+ */
+class LogTokenRecord {
+private:
+  uint8_t frame[4 + LOG_TOKEN_PAYLOAD_MAX + 3];
+  uint8_t length;                 ///< Octets de payload
+  bool overflow;                  ///< Arguments tronqués
+
+  void putByte(uint8_t value) {
+    if (length < LOG_TOKEN_PAYLOAD_MAX) {
+      frame[4 + length++] = value;
+    } else {
+      overflow = true;
+    }
+  }
+
+  void putLE(uint32_t value, uint8_t size) {
+    for (uint8_t i = 0; i < size; i++) {
+      putByte(value & 0xFF);
+      value >>= 8;
+    }
+  }
+
+public:
+  LogTokenRecord(uint8_t level, uint32_t token) : length(0), overflow(false) {
+    frame[0] = LOG_TOKEN_SYNC_1;
+    frame[1] = LOG_TOKEN_SYNC_2;
+    frame[2] = level;
+    putLE(token, 4);
+  }
+
+  // Arguments (promotions identiques à printf)
+  void put(int value)           { putLE((uint16_t)value, 2); }
+  void put(unsigned int value)  { putLE(value, 2); }
+  void put(long value)          { putLE((uint32_t)value, 4); }
+  void put(unsigned long value) { putLE(value, 4); }
+
+  void put(double value) {
+    float f = value;
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    putLE(bits, 4);
+  }
+
+  void put(const char* text) {
+    while (*text) putByte(*text++);
+    putByte(0);
+  }
+
+  void put(const __FlashStringHelper* text) {
+    PGM_P p = reinterpret_cast<PGM_P>(text);
+    uint8_t c;
+    while ((c = pgm_read_byte(p++)) != 0) putByte(c);
+    putByte(0);
+  }
+
+  void putAll() {}
+
+  template <typename T, typename... Rest>
+  void putAll(T value, Rest... rest) {
+    put(value);
+    putAll(rest...);
+  }
+
+  /**
+   * @brief Termine la trame (longueur, CRC, fin de ligne)
+   * @return Longueur totale de la trame
+   */
+  uint8_t finish() {
+    frame[3] = length;
+    uint16_t crc = dashCrc16(&frame[2], 2 + length);
+    frame[4 + length] = crc & 0xFF;
+    frame[5 + length] = crc >> 8;
+    frame[6 + length] = '\n';
+    return 7 + length;
+  }
+
+  const uint8_t* data() const {
+    return frame;
+  }
+
+  bool isTruncated() const {
+    return overflow;
+  }
+};
+
+// ============================================
+// CLASSE Logger
+// ============================================
+/**
+ * @class Logger
+ * @brief Tampon circulaire de journalisation (Print)
+ */
+class Logger : public Print {
+private:
+  char buffer[LOG_BUFFER_SIZE];   ///< Tampon circulaire
+  volatile uint16_t head;         ///< Index d'écriture
+  volatile uint16_t tail;         ///< Index de lecture
+  volatile bool discarding;       ///< Ligne en cours abandonnée (tampon plein)
+  volatile uint16_t droppedLines; ///< Lignes perdues non encore signalées
+  volatile bool truncated;        ///< Début de ligne en tampon sans fin de ligne
+  uint32_t totalDropped;          ///< Lignes perdues depuis le démarrage
+  uint16_t highWater;             ///< Remplissage maximal observé
+  uint16_t truncatedTokens;       ///< Trames à jetons aux arguments tronqués
+  Print* output;                  ///< Port de sortie (nullptr avant begin())
+  bool synchronous;               ///< Vidage bloquant si tampon plein
+
+  /**
+   * @brief Nombre d'octets en attente
+   */
+  uint16_t pending() const {
+    uint16_t h = head;
+    uint16_t t = tail;
+    return (h >= t) ? h - t : LOG_BUFFER_SIZE - t + h;
+  }
+
+  /**
+   * @brief Écrit un octet dans le tampon (interruptions masquées)
+   * @return false si tampon plein
+   */
+  bool push(uint8_t c) {
+    uint16_t next = head + 1;
+    if (next >= LOG_BUFFER_SIZE) next = 0;
+    if (next == tail) return false;
+
+    buffer[head] = c;
+    head = next;
+    return true;
+  }
+
+  /**
+   * @brief Écrit une trame binaire complète (ou l'abandonne)
+   * @param data Trame
+   * @param size Longueur
+   */
+  void writeFrame(const uint8_t* data, uint8_t size) {
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+
+    if (availableForWrite() < size && synchronous && output) {
+      SREG = oldSREG;
+      transfer(true);
+      oldSREG = SREG;
+      noInterrupts();
+    }
+
+    if (availableForWrite() < size) {
+      droppedLines++;
+      totalDropped++;
+    } else {
+      for (uint8_t i = 0; i < size; i++) push(data[i]);
+      uint16_t used = pending();
+      if (used > highWater) highWater = used;
+    }
+
+    SREG = oldSREG;
+  }
+
+  /**
+   * @brief Vide le tampon vers la sortie
+   * @param blocking true pour attendre le port série
+   */
+  void transfer(bool blocking) {
+    if (!output) return;
+
+    while (tail != head) {
+      // Bloc contigu jusqu'à head ou la fin du tampon
+      uint16_t t = tail;
+      uint16_t h = head;
+      uint16_t chunk = (h > t) ? h - t : LOG_BUFFER_SIZE - t;
+
+      if (!blocking) {
+        int room = output->availableForWrite();
+        if (room <= 0) return;
+        if (chunk > (uint16_t)room) chunk = room;
+      }
+
+      output->write((const uint8_t*)&buffer[t], chunk);
+
+      t += chunk;
+      if (t >= LOG_BUFFER_SIZE) t = 0;
+      tail = t;
+    }
+
+    // Signaler les lignes perdues une fois le tampon vide
+    if (droppedLines > 0 && !discarding) {
+      if (!blocking && output->availableForWrite() < 32) return;
+
+      uint8_t oldSREG = SREG;
+      noInterrupts();
+      uint16_t lost = droppedLines;
+      droppedLines = 0;
+      SREG = oldSREG;
+
+      if (truncated) {
+        truncated = false;
+        output->println(F("..."));
+      }
+      output->print(F("[LOG] "));
+      output->print(lost);
+      output->println(F(" ligne(s) perdue(s)"));
+    }
+  }
+
+public:
+  Logger()
+    : head(0),
+      tail(0),
+      discarding(false),
+      droppedLines(0),
+      truncated(false),
+      totalDropped(0),
+      highWater(0),
+      truncatedTokens(0),
+      output(nullptr),
+      synchronous(false)
+  {
+  }
+
+  // ============================================
+  // INITIALISATION
+  // ============================================
+
+  /**
+   * @brief Associe le port de sortie
+   * @param out Port de sortie (Serial)
+   *
+   * @details Les messages écrits avant begin() restent en tampon.
+   */
+  void begin(Print& out) {
+    output = &out;
+  }
+
+  /**
+   * @brief Active le vidage bloquant quand le tampon est plein
+   * @param enabled true pendant setup(), false ensuite
+   */
+  void setSynchronous(bool enabled) {
+    synchronous = enabled;
+  }
+
+  // ============================================
+  // ÉCRITURE (Print)
+  // ============================================
+
+  /**
+   * @brief Écrit un octet dans le journal
+   * @param c Octet
+   * @return 1 (octet accepté ou volontairement abandonné)
+   */
+  size_t write(uint8_t c) override {
+    uint8_t oldSREG = SREG;
+    noInterrupts();
+
+    if (discarding) {
+      // Fin de la ligne abandonnée
+      if (c == '\n') {
+        discarding = false;
+      }
+      SREG = oldSREG;
+      return 1;
+    }
+
+    bool stored = push(c);
+
+    if (!stored && synchronous && output) {
+      SREG = oldSREG;
+      transfer(true);
+      oldSREG = SREG;
+      noInterrupts();
+      stored = push(c);
+    }
+
+    if (!stored) {
+      // Début de ligne déjà en tampon : à terminer avant le marqueur
+      uint16_t last = (head == 0) ? LOG_BUFFER_SIZE - 1 : head - 1;
+      if (!discarding && head != tail && buffer[last] != '\n') {
+        truncated = true;
+      }
+      discarding = (c != '\n');
+      droppedLines++;
+      totalDropped++;
+    }
+
+    uint16_t used = pending();
+    if (used > highWater) highWater = used;
+
+    SREG = oldSREG;
+    return 1;
+  }
+
+  using Print::write;
+
+  /**
+   * @brief Place disponible pour l'écriture
+   * @return Octets libres dans le tampon
+   */
+  int availableForWrite() override {
+    return LOG_BUFFER_SIZE - 1 - pending();
+  }
+
+  /**
+   * @brief Écrit un message formaté (format en RAM)
+   * @param format Format printf
+   */
+  void printf(const char* format, ...) {
+    char text[LOG_FORMAT_BUFFER];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    print(text);
+  }
+
+  /**
+   * @brief Écrit un message formaté (format en flash)
+   * @param format Format printf en PROGMEM (PSTR)
+   */
+  void printf_P(PGM_P format, ...) {
+    char text[LOG_FORMAT_BUFFER];
+    va_list args;
+    va_start(args, format);
+    vsnprintf_P(text, sizeof(text), format, args);
+    va_end(args);
+    print(text);
+  }
+
+  /**
+   * @brief Écrit une trame de journal à jetons
+   * @param level Niveau (LOG_LEVEL_*)
+   * @param token Jeton du format (LOG_TOKEN_ID)
+   * @param args Arguments du format
+   *
+   * @details La trame est écrite entière ou pas du tout :
+   * tampon plein → comptée comme ligne perdue.
+   */
+  template <typename... Args>
+  void token(uint8_t level, uint32_t token, Args... args) {
+    LogTokenRecord record(level, token);
+    record.putAll(args...);
+    uint8_t size = record.finish();
+    if (record.isTruncated()) truncatedTokens++;
+    writeFrame(record.data(), size);
+  }
+
+  // ============================================
+  // VIDAGE
+  // ============================================
+
+  /**
+   * @brief Vide le tampon sans bloquer
+   *
+   * @details À appeler dans loop() : n'écrit que ce que le
+   * tampon TX matériel peut accepter immédiatement.
+   */
+  void drain() {
+    transfer(false);
+  }
+
+  /**
+   * @brief Vide entièrement le tampon (bloquant)
+   */
+  void flush() override {
+    transfer(true);
+    if (output) output->flush();
+  }
+
+  // ============================================
+  // GETTERS
+  // ============================================
+
+  /**
+   * @brief Vérifie si des messages sont en attente
+   * @return true si le tampon n'est pas vide
+   */
+  bool hasPending() const {
+    return head != tail;
+  }
+
+  /**
+   * @brief Obtient le nombre de lignes perdues depuis le démarrage
+   * @return Nombre de lignes perdues
+   */
+  uint32_t getDroppedLines() const {
+    return totalDropped;
+  }
+
+  /**
+   * @brief Obtient le remplissage maximal observé
+   * @return Octets
+   */
+  uint16_t getHighWater() const {
+    return highWater;
+  }
+
+  /**
+   * @brief Obtient le nombre de trames à jetons tronquées
+   * @return Trames dont les arguments dépassaient LOG_TOKEN_PAYLOAD_MAX
+   */
+  uint16_t getTruncatedTokens() const {
+    return truncatedTokens;
+  }
+};
+
+/// Journal global
+Logger logger;
+
+#endif // LOGGER_H
@@ -19,6 +19,7 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include <MPU6050_tockn.h>
+#include "I2CBus.h"
 
 
 // ============================================
@@ -44,6 +45,17 @@ struct MPU6050Data {
   unsigned long timestamp; ///< Timestamp de la mesure (millis)
 };
 
+/**
+ * @enum MPU6050Status
+ * @brief État du capteur
+ */
+enum class MPU6050Status {
+  NOT_INITIALIZED,   ///< Capteur non initialisé
+  READY,             ///< Capteur prêt et fonctionnel
+  ERROR_NOT_FOUND,   ///< Capteur non détecté sur I2C
+  ERROR_TIMEOUT      ///< Transaction I2C expirée (bus bloqué)
+};
+
 /**
  * @enum CalibrationStatus
  * @brief État de la calibration
@@ -88,6 +100,8 @@ private:
   unsigned long lastUpdate;       ///< Timestamp dernière MAJ
   uint16_t updateInterval;        ///< Intervalle de mise à jour (ms)
   bool initialized;               ///< État initialisation
+  MPU6050Status status;           ///< Dernier état du bus
+  uint8_t failedReads;            ///< Lectures ratées consécutives (saturé)
   
   float currentRoll;              ///< Angle Roll actuel (degrés)
   float currentPitch;             ///< Angle Pitch actuel (degrés)
@@ -110,6 +124,8 @@ public:
     lastUpdate(0),
     updateInterval(interval),
     initialized(false),
+    status(MPU6050Status::NOT_INITIALIZED),
+    failedReads(0),
     currentRoll(0.0),
     currentPitch(0.0),
     currentYaw(0.0),
@@ -126,13 +142,20 @@ public:
    */
   bool begin() {
     // Vérifier présence I2C
-    Wire.beginTransmission(MPU6050_I2C_ADDR);
-    if (Wire.endTransmission() != 0) {
+    if (!I2CBus::probe(MPU6050_I2C_ADDR)) {
+      status = MPU6050Status::ERROR_NOT_FOUND;
       return false;
     }
     
     mpu.begin();
+    if (I2CBus::takeTimeout()) {
+      status = MPU6050Status::ERROR_TIMEOUT;
+      return false;
+    }
+    
     initialized = true;
+    status = MPU6050Status::READY;
+    failedReads = 0;
     return true;
   }
 
@@ -183,6 +206,15 @@ public:
     lastUpdate = now;
     mpu.update();
     
+    // Bus expiré : conserver les dernières valeurs, réessai au prochain intervalle
+    if (I2CBus::takeTimeout()) {
+      status = MPU6050Status::ERROR_TIMEOUT;
+      if (failedReads < 0xFF) failedReads++;
+      return false;
+    }
+    status = MPU6050Status::READY;
+    failedReads = 0;
+    
     // Lecture valeurs brutes
     rawRoll = mpu.getAngleX();
     rawPitch = mpu.getAngleY();
@@ -202,6 +234,10 @@ public:
   void forceUpdate() {
     if (!initialized) return;
     mpu.update();
+    if (I2CBus::takeTimeout()) {
+      status = MPU6050Status::ERROR_TIMEOUT;
+      return;
+    }
     rawRoll = mpu.getAngleX();
     rawPitch = mpu.getAngleY();
     currentYaw = mpu.getAngleZ();
@@ -219,6 +255,8 @@ public:
   float getRawRoll() const { return rawRoll; }
   float getRawPitch() const { return rawPitch; }
   bool isInitialized() const { return initialized; }
+  MPU6050Status getStatus() const { return status; }
+  uint8_t getFailedReads() const { return failedReads; }  ///< Lectures ratées consécutives
 
   /**
    * @brief Calcule l'inclinaison totale (magnitude)
@@ -264,6 +302,12 @@ public:
     for (uint16_t i = 0; i < samples; i++) {
       mpu.update();
       
+      // Bus expiré : abandon (sinon une expiration par échantillon)
+      if (I2CBus::takeTimeout()) {
+        status = MPU6050Status::ERROR_TIMEOUT;
+        return false;
+      }
+      
       float roll = mpu.getAngleX();
       float pitch = mpu.getAngleY();
       
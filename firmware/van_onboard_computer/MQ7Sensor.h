@@ -436,6 +436,14 @@ public:
     return sampleInterval;
   }
 
+  /**
+   * @brief Retourne l'instant de la dernière tentative de lecture
+   * @return millis() du dernier échantillonnage (réussi ou non)
+   */
+  unsigned long getLastSampleTime() const {
+    return lastSample;
+  }
+
   /**
    * @brief Convertit le statut en texte
    * @param s Statut
@@ -0,0 +1,337 @@
+/**
+ * @file ProfileManager.h
+ * @brief Profils de fonctionnement ACTIVE / PARKED / NIGHT
+ * @author Frédéric BAILLON
+ * @version 0.1.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Les intervalles d'acquisition étaient fixes : MPU6050 à 500 ms van
+ * garé, LCD rafraîchi toutes les 100 ms rétro-éclairage éteint. Le
+ * profil courant multiplie les intervalles des voies non critiques :
+ * - ACTIVE : cadences du registre de paramètres
+ * - PARKED : × PROFILE_SCALE_PARKED (van immobile, personne à l'écran)
+ * - NIGHT  : × PROFILE_SCALE_NIGHT (inactivité longue, faible consommation)
+ *
+ * Voies ralenties : BME280, DS18B20, MPU6050, INA226 5V, rafraîchissement
+ * LCD. MQ7/MQ2, INA226 12V (alertes batterie sans retard), alertes,
+ * buzzer et LEDs gardent leur cadence.
+ *
+ * Sélection automatique (toutes les PROFILE_CHECK_INTERVAL ms) :
+ * - ACTIVE si alerte >= WARNING, mouvement (variation roll/pitch
+ *   MPU6050) depuis moins de PROFILE_MOTION_HOLD, ou encodeur utilisé
+ *   depuis moins de PROFILE_PARK_DELAY
+ * - NIGHT si encodeur inutilisé depuis PROFILE_NIGHT_DELAY et courant
+ *   12V sous PROFILE_NIGHT_CURRENT
+ * - PARKED sinon
+ * Le retour en ACTIVE est immédiat ; PARKED <-> NIGHT attend
+ * PROFILE_MIN_DWELL (cycles du réfrigérateur).
+ *
+ * Écran LEVEL affiché : MPU6050 à LEVEL_MPU_INTERVAL quel que soit le
+ * profil (SensorManager::setLevelling()).
+ *
+ * Bilan par profil : temps passé, accès I2C capteurs et trames LCD
+ * par minute (d'après les intervalles), activité CPU mesurée
+ * (IdleManager).
+ */
+
+#ifndef PROFILE_MANAGER_H
+#define PROFILE_MANAGER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "SystemData.h"
+#include "Settings.h"
+#include "SensorManager.h"
+#include "DisplayManager.h"
+#include "IdleManager.h"
+
+// ============================================
+// TYPES ET STRUCTURES
+// ============================================
+/**
+ * @enum OperatingProfile
+ * @brief Profil de fonctionnement
+ */
+enum class OperatingProfile : uint8_t {
+  ACTIVE,     ///< Cadences nominales
+  PARKED,     ///< Van garé
+  NIGHT,      ///< Nuit / absence
+  COUNT
+};
+
+/**
+ * @struct ProfileStats
+ * @brief Bilan d'un profil
+ */
+struct ProfileStats {
+  unsigned long timeMs;       ///< Temps passé dans le profil (ms)
+  uint16_t entries;           ///< Nombre d'entrées dans le profil
+  uint8_t cpuPercent;         ///< Activité CPU mesurée dans le profil (%, 0xFF = inconnue)
+};
+
+// ============================================
+// CLASSE ProfileManager
+// ============================================
+/**
+ * @class ProfileManager
+ * @brief Sélection du profil et ralentissement des voies non critiques
+ */
+class ProfileManager {
+private:
+  SystemState& state;
+  SensorManager& sensors;
+  DisplayManager& display;
+  IdleManager& idle;
+
+  OperatingProfile profile;
+  bool forced;                    ///< Profil imposé (console)
+
+  unsigned long lastCheck;
+  unsigned long lastSwitch;       ///< Entrée dans le profil courant (ms)
+  unsigned long lastMotion;       ///< Dernier mouvement détecté (ms)
+
+  // Dernière mesure d'horizontalité examinée
+  Timestamp16 lastLevelStamp;
+  int16_t lastRoll;
+  int16_t lastPitch;
+
+  ProfileStats stats[(uint8_t)OperatingProfile::COUNT];
+
+  /**
+   * @brief Détecte un mouvement sur une nouvelle mesure MPU6050
+   * @param now millis()
+   */
+  void detectMotion(unsigned long now) {
+    if (!state.level.valid || state.level.timestamp == lastLevelStamp) return;
+
+    long delta = labs((long)state.level.roll.raw - lastRoll) +
+                 labs((long)state.level.pitch.raw - lastPitch);
+    if (delta > PROFILE_MOTION_THRESHOLD) {
+      lastMotion = now;
+    }
+
+    lastLevelStamp = state.level.timestamp;
+    lastRoll = state.level.roll.raw;
+    lastPitch = state.level.pitch.raw;
+  }
+
+  /**
+   * @brief Profil souhaité d'après l'activité
+   * @param now millis()
+   */
+  OperatingProfile select(unsigned long now) const {
+    if (state.alerts.currentLevel >= AlertLevel::WARNING) return OperatingProfile::ACTIVE;
+    if (now - lastMotion < PROFILE_MOTION_HOLD) return OperatingProfile::ACTIVE;
+
+    unsigned long inactive = now - state.lastEncoderActivity;
+    if (inactive < PROFILE_PARK_DELAY) return OperatingProfile::ACTIVE;
+
+    if (inactive >= PROFILE_NIGHT_DELAY && state.power.voltage12VValid &&
+        abs(state.power.current12V.raw) < PROFILE_NIGHT_CURRENT / 10) {   // raw en 10 mA
+      return OperatingProfile::NIGHT;
+    }
+    return OperatingProfile::PARKED;
+  }
+
+  /**
+   * @brief Change de profil et applique les cadences
+   * @param next Nouveau profil
+   * @param now millis()
+   */
+  void apply(OperatingProfile next, unsigned long now) {
+    account(now);
+    LOG_INFO("Profil %S -> %S", profileName(profile), profileName(next));
+
+    profile = next;
+    lastSwitch = now;
+    ProfileStats& s = stats[(uint8_t)next];
+    if (s.entries < 0xFFFF) s.entries++;
+
+    uint8_t factor = scale(next);
+    sensors.setIntervalScale(factor);
+    display.setRefreshScale(factor);
+  }
+
+  /**
+   * @brief Ajoute le temps écoulé au profil courant
+   */
+  void account(unsigned long now) {
+    stats[(uint8_t)profile].timeMs += now - lastCheck;
+    lastCheck = now;
+  }
+
+  /**
+   * @brief Accès par minute pour un intervalle ralenti
+   */
+  static uint16_t perMinute(uint16_t interval, uint8_t factor) {
+    unsigned long scaled = (unsigned long)interval * factor;
+    if (scaled > 0xFFFF) scaled = 0xFFFF;
+    return scaled ? 60000UL / scaled : 0;
+  }
+
+public:
+  /**
+   * @brief Constructeur
+   * @param sysState Référence à l'état système
+   * @param sensorManager Capteurs ralentis
+   * @param displayManager Affichage ralenti
+   * @param idleManager Source de l'activité CPU mesurée, période de veille
+   */
+  ProfileManager(SystemState& sysState, SensorManager& sensorManager,
+                 DisplayManager& displayManager, IdleManager& idleManager)
+    : state(sysState),
+      sensors(sensorManager),
+      display(displayManager),
+      idle(idleManager),
+      profile(OperatingProfile::ACTIVE),
+      forced(false),
+      lastCheck(0),
+      lastSwitch(0),
+      lastMotion(0),
+      lastLevelStamp(0),
+      lastRoll(0),
+      lastPitch(0)
+  {
+    memset(stats, 0, sizeof(stats));
+    for (uint8_t i = 0; i < (uint8_t)OperatingProfile::COUNT; i++) {
+      stats[i].cpuPercent = 0xFF;
+    }
+  }
+
+  // ============================================
+  // INITIALISATION
+  // ============================================
+
+  /**
+   * @brief Démarre en ACTIVE (mise sous tension = présence)
+   */
+  void begin() {
+    unsigned long now = millis();
+    lastCheck = now;
+    lastSwitch = now;
+    lastMotion = now;
+    stats[(uint8_t)OperatingProfile::ACTIVE].entries = 1;
+  }
+
+  // ============================================
+  // MISE À JOUR
+  // ============================================
+
+  /**
+   * @brief Réévalue le profil (non-bloquant)
+   *
+   * @details Suit aussi l'écran LEVEL à chaque appel (MPU6050 rapide
+   * dès l'ouverture de l'écran, pas au prochain contrôle de profil).
+   */
+  void update() {
+    unsigned long now = millis();
+    bool levelling = display.isLevelling();
+    sensors.setLevelling(levelling);
+    idle.setLevelling(levelling);
+    detectMotion(now);
+
+    if (now - lastCheck < PROFILE_CHECK_INTERVAL) return;
+    account(now);
+
+    // Activité CPU : fenêtre IdleManager entièrement dans le profil
+    if (now - lastSwitch >= 2UL * IDLE_STATS_WINDOW) {
+      stats[(uint8_t)profile].cpuPercent = idle.getActivePercent();
+    }
+
+    #if USE_OPERATING_PROFILES
+    if (forced) return;
+
+    OperatingProfile next = select(now);
+    if (next == profile) return;
+
+    // Vers ACTIVE : immédiat ; entre profils économes : durée minimale
+    if (next != OperatingProfile::ACTIVE && profile != OperatingProfile::ACTIVE &&
+        now - lastSwitch < PROFILE_MIN_DWELL) {
+      return;
+    }
+    apply(next, now);
+    #endif
+  }
+
+  /**
+   * @brief Impose un profil (désactive la sélection automatique)
+   * @param next Profil
+   */
+  void force(OperatingProfile next) {
+    forced = true;
+    if (next != profile) apply(next, millis());
+  }
+
+  /**
+   * @brief Rétablit la sélection automatique
+   */
+  void release() {
+    forced = false;
+  }
+
+  // ============================================
+  // GETTERS
+  // ============================================
+
+  OperatingProfile getProfile() const { return profile; }
+  bool isForced() const { return forced; }
+
+  /**
+   * @brief Bilan d'un profil
+   */
+  const ProfileStats& getStats(OperatingProfile p) const {
+    return stats[(uint8_t)p];
+  }
+
+  /**
+   * @brief Multiplicateur d'intervalles d'un profil
+   */
+  static uint8_t scale(OperatingProfile p) {
+    switch (p) {
+      case OperatingProfile::PARKED: return PROFILE_SCALE_PARKED;
+      case OperatingProfile::NIGHT:  return PROFILE_SCALE_NIGHT;
+      default:                       return 1;
+    }
+  }
+
+  /**
+   * @brief Lectures I2C des capteurs par minute dans un profil
+   * @param p Profil
+   * @return Lectures/min (capteurs I2C prévus, registre courant)
+   */
+  static uint16_t getSensorReadsPerMinute(OperatingProfile p) {
+    static const SensorId i2cSensors[] = {
+      SensorId::BME280, SensorId::MPU6050, SensorId::INA226_12V, SensorId::INA226_5V
+    };
+    uint16_t total = 0;
+    for (uint8_t i = 0; i < sizeof(i2cSensors) / sizeof(i2cSensors[0]); i++) {
+      if (!SensorManager::isFitted(i2cSensors[i])) continue;
+      uint8_t factor = SensorManager::isThrottled(i2cSensors[i]) ? scale(p) : 1;
+      total += perMinute(SensorManager::getBaseInterval(i2cSensors[i]), factor);
+    }
+    return total;
+  }
+
+  /**
+   * @brief Trames LCD par minute dans un profil (rétro-éclairage allumé)
+   * @param p Profil
+   */
+  static uint16_t getLcdFramesPerMinute(OperatingProfile p) {
+    return perMinute(settings.values.intervalDisplay, scale(p));
+  }
+
+  /**
+   * @brief Nom d'un profil (flash, pour "%S")
+   */
+  static const __FlashStringHelper* profileName(OperatingProfile p) {
+    switch (p) {
+      case OperatingProfile::ACTIVE: return F("ACTIVE");
+      case OperatingProfile::PARKED: return F("PARKED");
+      case OperatingProfile::NIGHT:  return F("NIGHT");
+      default:                       return F("?");
+    }
+  }
+};
+
+#endif // PROFILE_MANAGER_H
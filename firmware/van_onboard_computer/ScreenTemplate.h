@@ -0,0 +1,364 @@
+/**
+ * @file ScreenTemplate.h
+ * @brief Écrans décrits en flash : fond fixe + champs numériques typés
+ * @author Frédéric BAILLON
+ * @version 0.1.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Les écrans de mesure (HOME, ENVIRONMENT, ENERGY, SAFETY, LEVEL)
+ * étaient construits à chaque image par snprintf("%.1f") : format non
+ * supporté par le vsnprintf d'avr-libc sans la bibliothèque flottante
+ * (~1,5 Ko), et plomberie printAt/printCenter répétée.
+ *
+ * Un écran est désormais un ScreenTemplate en PROGMEM :
+ * - Fond : LCD_ROWS × LCD_COLS caractères fixes (libellés, unités)
+ * - Champs : position, largeur, source (SlotSource), décimales,
+ *   signe forcé, unité d'un caractère
+ *
+ * ScreenRenderer copie le fond dans l'image (LCDFramebuffer) au
+ * changement d'écran, puis ne reformate à chaque image que les champs
+ * dont la valeur brute (entier Fixed16) a changé. Formatage entier
+ * uniquement (FixedFormat.h) : aucun float sur ce chemin.
+ */
+
+#ifndef SCREEN_TEMPLATE_H
+#define SCREEN_TEMPLATE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "SystemData.h"
+#include "LCDFramebuffer.h"
+#include "FixedFormat.h"
+
+// ============================================
+// CONFIGURATION
+// ============================================
+#define SCREEN_MAX_SLOTS        8       ///< Champs max par écran
+#define LCD_DEGREE              "\xDF"  ///< Symbole degré (ROM HD44780 A00)
+
+// ============================================
+// TYPES ET STRUCTURES
+// ============================================
+/**
+ * @enum SlotSource
+ * @brief Mesure affichée par un champ
+ */
+enum class SlotSource : uint8_t {
+  TEMP_INTERIOR,
+  TEMP_EXTERIOR,
+  HUMIDITY,
+  PRESSURE,
+  ROLL,
+  PITCH,
+  TOTAL_TILT,
+  VOLTAGE_12V,
+  CURRENT_12V,
+  VOLTAGE_5V,
+  CURRENT_5V,
+  POWER_TOTAL,
+  CO_PPM,
+  GPL_PPM,
+  SMOKE_PPM
+};
+
+// Options d'un champ
+#define SLOT_SIGN               FIXED_FORMAT_SIGN   ///< Signe '+' forcé pour les valeurs positives
+#define SLOT_LEFT               FIXED_FORMAT_LEFT   ///< Aligné à gauche (droite par défaut)
+
+/**
+ * @struct ScreenSlot
+ * @brief Champ numérique d'un écran (PROGMEM)
+ */
+struct ScreenSlot {
+  uint8_t col;                ///< Colonne de départ
+  uint8_t row;                ///< Ligne
+  uint8_t width;              ///< Largeur, unité comprise
+  SlotSource source;          ///< Mesure affichée
+  uint8_t decimals;           ///< Décimales affichées
+  uint8_t flags;              ///< SLOT_*
+  char unit;                  ///< Unité (0 = aucune)
+};
+
+/**
+ * @struct ScreenTemplate
+ * @brief Description complète d'un écran (PROGMEM)
+ */
+struct ScreenTemplate {
+  PGM_P text;                 ///< Fond : LCD_ROWS × LCD_COLS caractères
+  const ScreenSlot* slots;    ///< Champs (PROGMEM)
+  uint8_t slotCount;          ///< Nombre de champs
+};
+
+// ============================================
+// ÉCRANS
+// ============================================
+// Fond ligne par ligne (20 caractères chacune), champs en espaces
+
+/**
+ * ┌────────────────────┐
+ * │INT: 23° EXT: 15°   │
+ * │HUM: 65% P:1013hPa  │
+ * │X: +2.5° Y: -1.3°   │
+ * │12.3V-5.0V ████     │
+ * └────────────────────┘
+ */
+const char SCREEN_HOME_TEXT[] PROGMEM =
+  "INT:   " LCD_DEGREE " EXT:   " LCD_DEGREE "   "
+  "HUM:   % P:    hPa  "
+  "X:     " LCD_DEGREE " Y:     " LCD_DEGREE "   "
+  "     -              ";
+
+const ScreenSlot SCREEN_HOME_SLOTS[] PROGMEM = {
+  { 4, 0, 3, SlotSource::TEMP_INTERIOR, 0, 0,         0 },
+  {13, 0, 3, SlotSource::TEMP_EXTERIOR, 0, 0,         0 },
+  { 4, 1, 3, SlotSource::HUMIDITY,      0, 0,         0 },
+  {11, 1, 4, SlotSource::PRESSURE,      0, 0,         0 },
+  { 2, 2, 5, SlotSource::ROLL,          1, SLOT_SIGN, 0 },
+  {11, 2, 5, SlotSource::PITCH,         1, SLOT_SIGN, 0 },
+  { 0, 3, 5, SlotSource::VOLTAGE_12V,   1, 0,         'V' },
+  { 6, 3, 4, SlotSource::VOLTAGE_5V,    1, SLOT_LEFT, 'V' }
+};
+
+/**
+ * ┌────────────────────┐
+ * │   ENVIRONNEMENT    │
+ * │Int: 23.5°Ext: 15.2°│
+ * │Humid:  65% ▂▃▃▄▅▅▆▇│
+ * │Press: 1013 hPa     │
+ * └────────────────────┘
+ * Courbe d'humidité dessinée par DisplayManager (colonnes 12-19)
+ */
+const char SCREEN_ENVIRONMENT_TEXT[] PROGMEM =
+  "   ENVIRONNEMENT    "
+  "Int:     " LCD_DEGREE "Ext:     " LCD_DEGREE
+  "Humid:    %         "
+  "Press:      hPa     ";
+
+const ScreenSlot SCREEN_ENVIRONMENT_SLOTS[] PROGMEM = {
+  { 4, 1, 5, SlotSource::TEMP_INTERIOR, 1, 0, 0 },
+  {14, 1, 5, SlotSource::TEMP_EXTERIOR, 1, 0, 0 },
+  { 7, 2, 3, SlotSource::HUMIDITY,      0, 0, 0 },
+  { 7, 3, 4, SlotSource::PRESSURE,      0, 0, 0 }
+};
+
+/**
+ * ┌────────────────────┐
+ * │      ENERGIE       │
+ * │12V: 12.3V -   5.2A │
+ * │ 5V:  5.0V -   1.8A │
+ * │Tot:  68.5 W▇▇▆▆▅▅▄▃│
+ * └────────────────────┘
+ * Courbe de la tension 12V dessinée par DisplayManager (colonnes 12-19)
+ */
+const char SCREEN_ENERGY_TEXT[] PROGMEM =
+  "      ENERGIE       "
+  "12V:       -        "
+  " 5V:       -        "
+  "Tot:       W        ";
+
+const ScreenSlot SCREEN_ENERGY_SLOTS[] PROGMEM = {
+  { 5, 1, 5, SlotSource::VOLTAGE_12V, 1, 0, 'V' },
+  {13, 1, 6, SlotSource::CURRENT_12V, 1, 0, 'A' },
+  { 5, 2, 5, SlotSource::VOLTAGE_5V,  1, 0, 'V' },
+  {13, 2, 6, SlotSource::CURRENT_5V,  1, 0, 'A' },
+  { 4, 3, 6, SlotSource::POWER_TOTAL, 1, 0, 0 }
+};
+
+/**
+ * ┌────────────────────┐
+ * │      SECURITE      │
+ * │CO:    50 ppm [OK]  │
+ * │GPL:  150 ppm [OK]  │
+ * │Fum:   80 ppm [OK]  │
+ * └────────────────────┘
+ * Statuts [OK]/[!]/[X] dessinés par DisplayManager (colonne 14)
+ */
+const char SCREEN_SAFETY_TEXT[] PROGMEM =
+  "      SECURITE      "
+  "CO:       ppm       "
+  "GPL:      ppm       "
+  "Fum:      ppm       ";
+
+const ScreenSlot SCREEN_SAFETY_SLOTS[] PROGMEM = {
+  { 5, 1, 4, SlotSource::CO_PPM,    0, 0, 0 },
+  { 5, 2, 4, SlotSource::GPL_PPM,   0, 0, 0 },
+  { 5, 3, 4, SlotSource::SMOKE_PPM, 0, 0, 0 }
+};
+
+/**
+ * ┌────────────────────┐
+ * │         |R: +2.5°  │
+ * │   .o.   |P: -1.3°  │
+ * │    '    |Av  0  4cm│
+ * │         |Ar  2  6cm│
+ * └────────────────────┘
+ * Bulle (colonnes 0-8) et hauteurs de calage par roue (gauche, droite)
+ * dessinées par DisplayManager (BubbleLevel.h)
+ */
+const char SCREEN_LEVEL_TEXT[] PROGMEM =
+  "         |R:     " LCD_DEGREE "  "
+  "         |P:     " LCD_DEGREE "  "
+  "         |Av      cm"
+  "         |Ar      cm";
+
+const ScreenSlot SCREEN_LEVEL_SLOTS[] PROGMEM = {
+  {12, 0, 5, SlotSource::ROLL,  1, SLOT_SIGN, 0 },
+  {12, 1, 5, SlotSource::PITCH, 1, SLOT_SIGN, 0 }
+};
+
+#define SCREEN_TEMPLATE(name) \
+  { name##_TEXT, name##_SLOTS, sizeof(name##_SLOTS) / sizeof(ScreenSlot) }
+
+const ScreenTemplate SCREEN_HOME_TEMPLATE PROGMEM = SCREEN_TEMPLATE(SCREEN_HOME);
+const ScreenTemplate SCREEN_ENVIRONMENT_TEMPLATE PROGMEM = SCREEN_TEMPLATE(SCREEN_ENVIRONMENT);
+const ScreenTemplate SCREEN_ENERGY_TEMPLATE PROGMEM = SCREEN_TEMPLATE(SCREEN_ENERGY);
+const ScreenTemplate SCREEN_SAFETY_TEMPLATE PROGMEM = SCREEN_TEMPLATE(SCREEN_SAFETY);
+const ScreenTemplate SCREEN_LEVEL_TEMPLATE PROGMEM = SCREEN_TEMPLATE(SCREEN_LEVEL);
+
+// Un fond incomplet décalerait tout l'écran
+static_assert(sizeof(SCREEN_HOME_TEXT) == LCD_ROWS * LCD_COLS + 1, "SCREEN_HOME_TEXT: 4 x 20");
+static_assert(sizeof(SCREEN_ENVIRONMENT_TEXT) == LCD_ROWS * LCD_COLS + 1, "SCREEN_ENVIRONMENT_TEXT: 4 x 20");
+static_assert(sizeof(SCREEN_ENERGY_TEXT) == LCD_ROWS * LCD_COLS + 1, "SCREEN_ENERGY_TEXT: 4 x 20");
+static_assert(sizeof(SCREEN_SAFETY_TEXT) == LCD_ROWS * LCD_COLS + 1, "SCREEN_SAFETY_TEXT: 4 x 20");
+static_assert(sizeof(SCREEN_LEVEL_TEXT) == LCD_ROWS * LCD_COLS + 1, "SCREEN_LEVEL_TEXT: 4 x 20");
+
+// ============================================
+// CLASSE ScreenRenderer
+// ============================================
+/**
+ * @class ScreenRenderer
+ * @brief Rendu d'un ScreenTemplate dans l'image de l'écran
+ */
+class ScreenRenderer {
+private:
+  const ScreenTemplate* current;    ///< Écran dont le fond est en place (PROGMEM)
+  int16_t lastRaw[SCREEN_MAX_SLOTS];///< Valeur brute affichée par champ
+  uint8_t valid;                    ///< Champs à jour (1 bit chacun)
+
+  // Statistiques
+  uint32_t formatted;               ///< Champs reformatés (cumul)
+  uint32_t unchanged;               ///< Champs inchangés, non reformatés (cumul)
+
+  /**
+   * @brief Valeur brute d'une mesure et décimales de son échelle
+   * @param value Mesure Fixed16
+   * @param rawDecimals [out] Décimales déduites de SCALE
+   * @return Valeur brute (entier Fixed16)
+   */
+  template<int16_t SCALE>
+  static int16_t raw(const Fixed16<SCALE>& value, uint8_t& rawDecimals) {
+    rawDecimals = FixedFormat::scaleDecimals(SCALE);
+    return value.raw;
+  }
+
+  /**
+   * @brief Lit la valeur brute d'une source
+   * @param state État système
+   * @param source Mesure
+   * @param rawDecimals [out] Décimales de la valeur brute (échelle Fixed16)
+   * @return Valeur brute (entier Fixed16)
+   */
+  static int16_t readSource(const SystemState& state, SlotSource source, uint8_t& rawDecimals) {
+    switch (source) {
+      case SlotSource::TEMP_INTERIOR: return raw(state.environment.tempInterior, rawDecimals);
+      case SlotSource::TEMP_EXTERIOR: return raw(state.environment.tempExterior, rawDecimals);
+      case SlotSource::HUMIDITY:      return raw(state.environment.humidity, rawDecimals);
+      case SlotSource::PRESSURE:      return raw(state.environment.pressure, rawDecimals);
+      case SlotSource::ROLL:          return raw(state.level.roll, rawDecimals);
+      case SlotSource::PITCH:         return raw(state.level.pitch, rawDecimals);
+      case SlotSource::TOTAL_TILT:    return raw(state.level.totalTilt, rawDecimals);
+      case SlotSource::VOLTAGE_12V:   return raw(state.power.voltage12V, rawDecimals);
+      case SlotSource::CURRENT_12V:   return raw(state.power.current12V, rawDecimals);
+      case SlotSource::VOLTAGE_5V:    return raw(state.power.voltage5V, rawDecimals);
+      case SlotSource::CURRENT_5V:    return raw(state.power.current5V, rawDecimals);
+      case SlotSource::POWER_TOTAL:   return raw(state.power.powerTotal, rawDecimals);
+      case SlotSource::CO_PPM:        return raw(state.safety.coPPM, rawDecimals);
+      case SlotSource::GPL_PPM:       return raw(state.safety.gplPPM, rawDecimals);
+      case SlotSource::SMOKE_PPM:     return raw(state.safety.smokePPM, rawDecimals);
+      default:                        rawDecimals = 0; return 0;
+    }
+  }
+
+  /**
+   * @brief Formate un champ dans l'image (entiers uniquement)
+   * @param fb Image de l'écran
+   * @param slot Champ
+   * @param raw Valeur brute
+   * @param rawDecimals Décimales de la valeur brute
+   *
+   * @details Arrondi et débordement : voir FixedFormat.h.
+   */
+  static void formatSlot(LCDFramebuffer& fb, const ScreenSlot& slot, int16_t raw, uint8_t rawDecimals) {
+    char text[LCD_COLS + 1];
+    uint8_t width = slot.width < LCD_COLS ? slot.width : LCD_COLS;
+    FixedFormat::formatWidth(text, width, raw, rawDecimals, slot.decimals, slot.flags, slot.unit);
+    fb.print(slot.col, slot.row, text);
+  }
+
+public:
+  ScreenRenderer()
+    : current(nullptr),
+      valid(0),
+      formatted(0),
+      unchanged(0)
+  {
+  }
+
+  /**
+   * @brief Dessine un écran dans l'image
+   * @param tpl Écran (PROGMEM)
+   * @param fb Image de l'écran
+   * @param state État système
+   *
+   * @details Fond recopié seulement au changement d'écran ; champs
+   * reformatés seulement si leur valeur brute a changé.
+   */
+  void render(const ScreenTemplate* tpl, LCDFramebuffer& fb, const SystemState& state) {
+    ScreenTemplate screen;
+    memcpy_P(&screen, tpl, sizeof(screen));
+
+    if (tpl != current) {
+      PGM_P text = screen.text;
+      for (uint8_t row = 0; row < LCD_ROWS; row++) {
+        for (uint8_t col = 0; col < LCD_COLS; col++) {
+          fb.put(col, row, pgm_read_byte(text++));
+        }
+      }
+      current = tpl;
+      valid = 0;
+    }
+
+    uint8_t count = screen.slotCount < SCREEN_MAX_SLOTS ? screen.slotCount : SCREEN_MAX_SLOTS;
+    for (uint8_t i = 0; i < count; i++) {
+      ScreenSlot slot;
+      memcpy_P(&slot, &screen.slots[i], sizeof(slot));
+
+      uint8_t rawDecimals;
+      int16_t raw = readSource(state, slot.source, rawDecimals);
+      uint8_t bit = 1 << i;
+      if ((valid & bit) && lastRaw[i] == raw) {
+        unchanged++;
+        continue;
+      }
+
+      formatSlot(fb, slot, raw, rawDecimals);
+      lastRaw[i] = raw;
+      valid |= bit;
+      formatted++;
+    }
+  }
+
+  /**
+   * @brief Oublie l'écran en place (dessin hors gabarit dans l'image)
+   */
+  void reset() {
+    current = nullptr;
+    valid = 0;
+  }
+
+  uint32_t getFormattedCount() const { return formatted; }
+  uint32_t getUnchangedCount() const { return unchanged; }
+};
+
+#endif // SCREEN_TEMPLATE_H
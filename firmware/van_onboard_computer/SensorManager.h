@@ -12,6 +12,8 @@
  * - Mise à jour des données dans SystemState
  * - Gestion du pré-chauffage MQ7/MQ2
  * - Détection des capteurs présents sur I2C
+ * - Capteurs câblés fixés à la compilation (BoardProfile.h)
+ * - Suspension / ré-initialisation à la demande (HealthMonitor.h)
  */
 
 #ifndef SENSOR_MANAGER_H
@@ -21,6 +23,10 @@
 #include <Wire.h>
 #include "config.h"
 #include "SystemData.h"
+#include "Settings.h"
+#include "FixedFormat.h"
+#include "BoardProfile.h"
+#include "Watchdog.h"
 
 // Inclusion des classes capteurs
 #include "BME280Sensor.h"
@@ -30,6 +36,26 @@
 #include "MQ2Sensor.h"
 #include "INA226Sensor.h"
 
+// ============================================
+// CAPTEURS SUPERVISÉS
+// ============================================
+/**
+ * @brief Capteurs numériques susceptibles de disparaître du bus
+ *
+ * @note MQ7/MQ2 (analogiques) ne sont pas sondés par HealthMonitor :
+ * SensorManager les met hors service après GAS_MAX_READ_FAILURES
+ * lectures ratées (tension nulle, module débranché) et les remet en
+ * service à la première lecture valide.
+ */
+enum class SensorId : uint8_t {
+  BME280,
+  DS18B20,
+  MPU6050,
+  INA226_12V,
+  INA226_5V,
+  COUNT
+};
+
 // ============================================
 // CLASSE SensorManager
 // ============================================
@@ -43,14 +69,15 @@
  */
 class SensorManager {
 private:
-  // Instances des capteurs
-  BME280Sensor* bme280;
-  DS18B20Sensor* ds18b20;
-  MPU6050Sensor* mpu6050;
-  MQ7Sensor* mq7;
-  MQ2Sensor* mq2;
-  INA226Sensor* ina226_12v;
-  INA226Sensor* ina226_5v;
+  // Instances des capteurs (intervalles de config.h, puis du registre)
+  // Emplacement vide si le capteur est absent du profil (BoardProfile.h)
+  SensorSlot<BME280Sensor, BoardProfile::bme280> bme280;
+  SensorSlot<DS18B20Sensor, BoardProfile::ds18b20> ds18b20;
+  SensorSlot<MPU6050Sensor, BoardProfile::mpu6050> mpu6050;
+  SensorSlot<MQ7Sensor, BoardProfile::mq7> mq7;
+  SensorSlot<MQ2Sensor, BoardProfile::mq2> mq2;
+  SensorSlot<INA226Sensor, BoardProfile::ina226_12v> ina226_12v;
+  SensorSlot<INA226Sensor, BoardProfile::ina226_5v> ina226_5v;
   
   // Référence à l'état système
   SystemState& state;
@@ -62,6 +89,43 @@ private:
   // Flags d'initialisation
   bool initialized;
   
+  // Ralentissement des voies non critiques (profil de fonctionnement)
+  uint8_t intervalScale;
+  
+  // Écran LEVEL affiché : MPU6050 à LEVEL_MPU_INTERVAL
+  bool levelling;
+  
+  // Dernière tentative gaz signalée au watchdog
+  uint8_t reportedGasSeq;
+  
+  // Lectures MQ7/MQ2 ratées consécutives
+  uint8_t mq7Failures;
+  uint8_t mq2Failures;
+  
+  /**
+   * @brief Applique le ralentissement du profil à un intervalle
+   * @param interval Intervalle du registre (ms)
+   * @return Intervalle multiplié, saturé à 65535 ms
+   */
+  uint16_t scaleInterval(uint16_t interval) const {
+    uint32_t scaled = (uint32_t)interval * intervalScale;
+    return scaled > 0xFFFF ? 0xFFFF : (uint16_t)scaled;
+  }
+  
+  /**
+   * @brief Met à jour le flag de présence d'un capteur
+   */
+  void setOnline(SensorId id, bool online) {
+    switch (id) {
+      case SensorId::BME280:     state.sensors.bme280 = online; break;
+      case SensorId::DS18B20:    state.sensors.ds18b20 = online; break;
+      case SensorId::MPU6050:    state.sensors.mpu6050 = online; break;
+      case SensorId::INA226_12V: state.sensors.ina226_12v = online; break;
+      case SensorId::INA226_5V:  state.sensors.ina226_5v = online; break;
+      default:                   break;
+    }
+  }
+  
 public:
   /**
    * @brief Constructeur
@@ -69,32 +133,24 @@ public:
    */
   SensorManager(SystemState& sysState) 
     : state(sysState),
-      bme280(nullptr),
-      ds18b20(nullptr),
-      mpu6050(nullptr),
-      mq7(nullptr),
-      mq2(nullptr),
-      ina226_12v(nullptr),
-      ina226_5v(nullptr),
+      bme280(I2C_BME280, INTERVAL_BME280),
+      ds18b20(PIN_DS18B20, INTERVAL_DS18B20),
+      mpu6050(Wire, INTERVAL_MPU6050),
+      mq7(PIN_MQ7, MQ_LOAD_RESISTOR, INTERVAL_MQ7),
+      mq2(PIN_MQ2, MQ_LOAD_RESISTOR, INTERVAL_MQ2),
+      ina226_12v(PowerRailType::RAIL_12V, I2C_INA226_12V, INTERVAL_INA226),
+      ina226_5v(PowerRailType::RAIL_5V, I2C_INA226_5V, INTERVAL_INA226),
       preheatStartTime(0),
       preheatComplete(false),
-      initialized(false)
+      initialized(false),
+      intervalScale(1),
+      levelling(false),
+      reportedGasSeq(0),
+      mq7Failures(0),
+      mq2Failures(0)
   {
   }
   
-  /**
-   * @brief Destructeur - libère la mémoire
-   */
-  ~SensorManager() {
-    if (bme280) delete bme280;
-    if (ds18b20) delete ds18b20;
-    if (mpu6050) delete mpu6050;
-    if (mq7) delete mq7;
-    if (mq2) delete mq2;
-    if (ina226_12v) delete ina226_12v;
-    if (ina226_5v) delete ina226_5v;
-  }
-  
   // ============================================
   // INITIALISATION
   // ============================================
@@ -115,70 +171,77 @@ public:
     // Scanner I2C pour détecter périphériques
     scanI2C();
     
+    // Intervalles et seuils du registre (EEPROM chargée)
+    applySettings();
+    
+    // Capteurs absents du profil : blocs éliminés à la compilation,
+    // state.sensors.* reste à false
+    
     // Initialiser BME280 (température/humidité intérieur)
-    bme280 = new BME280Sensor(I2C_BME280, INTERVAL_BME280);
-    if (bme280->begin()) {
-      state.sensors.bme280 = true;
-      DEBUG_PRINTLN(F("[OK] BME280 initialise"));
-    } else {
-      DEBUG_PRINTLN(F("[ECHEC] BME280 non detecte"));
-      state.sensors.bme280 = false;
+    if (bme280) {
+      state.sensors.bme280 = bme280->begin();
+      if (state.sensors.bme280) {
+        LOG_INFO("BME280 initialise");
+      } else {
+        LOG_WARN("BME280 non detecte");
+      }
     }
     
     // Initialiser DS18B20 (température extérieur)
-    ds18b20 = new DS18B20Sensor(PIN_DS18B20, INTERVAL_DS18B20);
-    if (ds18b20->begin()) {
-      state.sensors.ds18b20 = true;
-      DEBUG_PRINTF("[OK] DS18B20 initialise (%d capteur(s))\n", ds18b20->getSensorCount());
-    } else {
-      DEBUG_PRINTLN(F("[ECHEC] DS18B20 non detecte"));
-      state.sensors.ds18b20 = false;
+    if (ds18b20) {
+      state.sensors.ds18b20 = ds18b20->begin();
+      if (state.sensors.ds18b20) {
+        LOG_INFO("DS18B20 initialise (%d capteur(s))", ds18b20->getSensorCount());
+      } else {
+        LOG_WARN("DS18B20 non detecte");
+      }
     }
     
     // Initialiser MPU6050 (horizontalité)
-    mpu6050 = new MPU6050Sensor(Wire, INTERVAL_MPU6050);
-    if (mpu6050->begin()) {
-      state.sensors.mpu6050 = true;
-      DEBUG_PRINTLN(F("[OK] MPU6050 initialise"));
-    } else {
-      DEBUG_PRINTLN(F("[ECHEC] MPU6050 non detecte"));
-      state.sensors.mpu6050 = false;
+    if (mpu6050) {
+      state.sensors.mpu6050 = mpu6050->begin();
+      if (state.sensors.mpu6050) {
+        LOG_INFO("MPU6050 initialise");
+        if (settings.hasLevelCalibration()) {
+          setMPU6050Offsets(settings.values.levelRollOffset, settings.values.levelPitchOffset);
+        }
+      } else {
+        LOG_WARN("MPU6050 non detecte");
+      }
     }
     
     // Initialiser MQ7 (CO)
-    mq7 = new MQ7Sensor(PIN_MQ7, INTERVAL_MQ7);
-    mq7->begin();
-    state.sensors.mq7 = true;
-    DEBUG_PRINTLN(F("[OK] MQ7 initialise (pre-chauffe requise)"));
+    if (mq7) {
+      mq7->begin();
+      state.sensors.mq7 = true;
+      LOG_INFO("MQ7 initialise (pre-chauffe requise)");
+    }
     
     // Initialiser MQ2 (GPL/fumée)
-    mq2 = new MQ2Sensor(PIN_MQ2, INTERVAL_MQ2);
-    mq2->begin();
-    state.sensors.mq2 = true;
-    DEBUG_PRINTLN(F("[OK] MQ2 initialise (pre-chauffe requise)"));
+    if (mq2) {
+      mq2->begin();
+      state.sensors.mq2 = true;
+      LOG_INFO("MQ2 initialise (pre-chauffe requise)");
+    }
     
     // Initialiser INA226 12V
-    ina226_12v = new INA226Sensor(PowerRailType::RAIL_12V, I2C_INA226_12V, INTERVAL_INA226);
-    if (ina226_12v->begin()) {
-      ina226_12v->setVoltageThresholds(VOLTAGE_12V_MIN, VOLTAGE_12V_MAX);
-      ina226_12v->setCurrentThreshold(CURRENT_12V_MAX);
-      state.sensors.ina226_12v = true;
-      DEBUG_PRINTLN(F("[OK] INA226 12V initialise"));
-    } else {
-      DEBUG_PRINTLN(F("[ECHEC] INA226 12V non detecte"));
-      state.sensors.ina226_12v = false;
+    if (ina226_12v) {
+      state.sensors.ina226_12v = ina226_12v->begin();
+      if (state.sensors.ina226_12v) {
+        LOG_INFO("INA226 12V initialise");
+      } else {
+        LOG_WARN("INA226 12V non detecte");
+      }
     }
     
     // Initialiser INA226 5V
-    ina226_5v = new INA226Sensor(PowerRailType::RAIL_5V, I2C_INA226_5V, INTERVAL_INA226);
-    if (ina226_5v->begin()) {
-      ina226_5v->setVoltageThresholds(VOLTAGE_5V_MIN, VOLTAGE_5V_MAX);
-      ina226_5v->setCurrentThreshold(CURRENT_5V_MAX);
-      state.sensors.ina226_5v = true;
-      DEBUG_PRINTLN(F("[OK] INA226 5V initialise"));
-    } else {
-      DEBUG_PRINTLN(F("[ECHEC] INA226 5V non detecte"));
-      state.sensors.ina226_5v = false;
+    if (ina226_5v) {
+      state.sensors.ina226_5v = ina226_5v->begin();
+      if (state.sensors.ina226_5v) {
+        LOG_INFO("INA226 5V initialise");
+      } else {
+        LOG_WARN("INA226 5V non detecte");
+      }
     }
     
     // Démarrer pré-chauffage capteurs gaz
@@ -187,8 +250,8 @@ public:
     state.mode = SystemMode::MODE_PREHEAT;
     
     DEBUG_PRINTLN(F("=== PRE-CHAUFFE EN COURS ==="));
-    DEBUG_PRINTF("MQ7: %d secondes\n", PREHEAT_MQ7_TIME / 1000);
-    DEBUG_PRINTF("MQ2: %d secondes\n", PREHEAT_MQ2_TIME / 1000);
+    LOG_INFO("MQ7: %ld secondes", PREHEAT_MQ7_TIME / 1000);
+    LOG_INFO("MQ2: %ld secondes", PREHEAT_MQ2_TIME / 1000);
     
     initialized = true;
     return (state.sensors.bme280 || state.sensors.ds18b20 || 
@@ -196,6 +259,66 @@ public:
             state.sensors.ina226_5v);
   }
   
+  /**
+   * @brief Applique les paramètres modifiés à chaud (settings.values)
+   *
+   * @details Recopie les intervalles et les seuils INA226 dans les
+   * capteurs ; les autres modules lisent directement le registre.
+   * Les intervalles MQ7/MQ2 ne sont jamais ralentis (sécurité gaz).
+   */
+  void applySettings() {
+    const RuntimeSettings& values = settings.values;
+
+    if (bme280) bme280->setSampleInterval(scaleInterval(values.intervalBME280));
+    if (ds18b20) ds18b20->setUpdateInterval(scaleInterval(values.intervalDS18B20));
+    if (mpu6050) mpu6050->setUpdateInterval(getSampleInterval(SensorId::MPU6050));
+    if (mq7) mq7->setSampleInterval(values.intervalMQ7);
+    if (mq2) mq2->setSampleInterval(values.intervalMQ2);
+
+    if (ina226_12v) {
+      ina226_12v->setUpdateInterval(getSampleInterval(SensorId::INA226_12V));
+      ina226_12v->setVoltageThresholds(values.voltage12VMin, values.voltage12VMax);
+      ina226_12v->setCurrentThreshold(values.current12VMax);
+    }
+    if (ina226_5v) {
+      ina226_5v->setUpdateInterval(getSampleInterval(SensorId::INA226_5V));
+      ina226_5v->setVoltageThresholds(values.voltage5VMin, values.voltage5VMax);
+      ina226_5v->setCurrentThreshold(values.current5VMax);
+    }
+  }
+
+  /**
+   * @brief Ralentit les capteurs non critiques (profil de fonctionnement)
+   * @param scale Multiplicateur des intervalles (1 = registre)
+   *
+   * @details BME280, DS18B20, MPU6050 et INA226 uniquement.
+   */
+  void setIntervalScale(uint8_t scale) {
+    intervalScale = scale ? scale : 1;
+    applySettings();
+  }
+  
+  /**
+   * @brief Accélère le MPU6050 pendant la mise à niveau
+   * @param active true tant que l'écran LEVEL est affiché
+   *
+   * @details LEVEL_MPU_INTERVAL ms au lieu de l'intervalle du
+   * registre, quel que soit le profil : la bulle suit le calage.
+   */
+  void setLevelling(bool active) {
+    if (active == levelling) return;
+    levelling = active;
+    applySettings();
+    LOG_INFO("MPU6050 toutes les %u ms", (unsigned)getSampleInterval(SensorId::MPU6050));
+  }
+  
+  /**
+   * @brief Multiplicateur d'intervalles courant
+   */
+  uint8_t getIntervalScale() const {
+    return intervalScale;
+  }
+
   /**
    * @brief Scanne le bus I2C et affiche les périphériques détectés
    */
@@ -206,15 +329,15 @@ public:
     for (byte addr = 1; addr < 127; addr++) {
       Wire.beginTransmission(addr);
       if (Wire.endTransmission() == 0) {
-        DEBUG_PRINTF("  -> 0x%02X detecte\n", addr);
+        LOG_INFO("I2C 0x%02X detecte", addr);
         count++;
       }
     }
     
     if (count == 0) {
-      DEBUG_PRINTLN(F("Aucun peripherique I2C detecte!"));
+      LOG_WARN("Aucun peripherique I2C detecte!");
     } else {
-      DEBUG_PRINTF("Total: %d peripherique(s) I2C\n", count);
+      LOG_INFO("Total: %d peripherique(s) I2C", count);
     }
   }
   
@@ -242,9 +365,56 @@ public:
     updateMPU6050();
     updateMQ7();
     updateMQ2();
+    reportGasProgress();
     updateINA226();
   }
   
+  /**
+   * @brief Signale au watchdog une tentative de lecture MQ7/MQ2
+   * 
+   * @details Tentative = state.safety.sampleSeq avancé, que la lecture
+   * ait réussi ou non : un module débranché ne provoque pas de reset.
+   * Tâche GAS non surveillée sans capteur gaz en service (absent du
+   * profil ou hors service après lectures ratées).
+   */
+  void reportGasProgress() {
+    bool mq7Active = mq7 && state.sensors.mq7;
+    bool mq2Active = mq2 && state.sensors.mq2;
+    watchdog.setMonitored(WatchdogTask::GAS, mq7Active || mq2Active);
+    
+    if (state.safety.sampleSeq != reportedGasSeq) {
+      reportedGasSeq = state.safety.sampleSeq;
+      watchdog.checkIn(WatchdogTask::GAS);
+    }
+  }
+  
+  /**
+   * @brief Comptabilise une lecture gaz
+   * @param ok Lecture réussie
+   * @param failures Lectures ratées consécutives du capteur
+   * @param online Capteur en service
+   * @param name Nom du capteur (flash, pour "%S")
+   * @return Nouvel état de service
+   * 
+   * @details Hors service après GAS_MAX_READ_FAILURES échecs, de
+   * nouveau en service à la première lecture réussie.
+   */
+  static bool trackGasRead(bool ok, uint8_t& failures, bool online,
+                           const __FlashStringHelper* name) {
+    if (ok) {
+      if (!online) LOG_INFO("%S: lectures retablies", name);
+      failures = 0;
+      return true;
+    }
+    
+    if (failures < 0xFF) failures++;
+    if (online && failures >= GAS_MAX_READ_FAILURES) {
+      LOG_ERROR("%S: %u lectures ratees, hors service", name, failures);
+      return false;
+    }
+    return online;
+  }
+  
   /**
    * @brief Gère le pré-chauffage des capteurs MQ
    */
@@ -256,13 +426,13 @@ public:
     // Vérifier MQ2 (1 minute)
     if (!state.safety.mq2Preheated && elapsed >= PREHEAT_MQ2_TIME) {
       state.safety.mq2Preheated = true;
-      DEBUG_PRINTLN(F("[OK] MQ2 pre-chauffe terminee"));
+      LOG_INFO("MQ2 pre-chauffe terminee");
     }
     
     // Vérifier MQ7 (3 minutes)
     if (!state.safety.mq7Preheated && elapsed >= PREHEAT_MQ7_TIME) {
       state.safety.mq7Preheated = true;
-      DEBUG_PRINTLN(F("[OK] MQ7 pre-chauffe terminee"));
+      LOG_INFO("MQ7 pre-chauffe terminee");
     }
     
     // Pré-chauffage complet ?
@@ -278,7 +448,7 @@ public:
    * @brief Met à jour BME280 (température/humidité intérieur)
    */
   void updateBME280() {
-    if (!state.sensors.bme280 || !bme280) return;
+    if (!bme280 || !state.sensors.bme280) return;
     
     if (bme280->update()) {
       BME280Data data = bme280->getData();
@@ -287,7 +457,7 @@ public:
       state.environment.humidity = data.humidity;
       state.environment.pressure = data.pressure;
       state.environment.dewPoint = bme280->getDewPoint();
-      state.environment.tempIntTimestamp = data.timestamp;
+      state.environment.tempIntTimestamp = toTimestamp16(data.timestamp);
       
       state.environment.tempIntValid = isValidTemperature(data.temperature);
       state.environment.humidityValid = isValidHumidity(data.humidity);
@@ -299,12 +469,12 @@ public:
    * @brief Met à jour DS18B20 (température extérieur)
    */
   void updateDS18B20() {
-    if (!state.sensors.ds18b20 || !ds18b20) return;
+    if (!ds18b20 || !state.sensors.ds18b20) return;
     
     if (ds18b20->update()) {
       float temp = ds18b20->getTemperature(0);
       state.environment.tempExterior = temp;
-      state.environment.tempExtTimestamp = millis();
+      state.environment.tempExtTimestamp = toTimestamp16(millis());
       state.environment.tempExtValid = isValidTemperature(temp);
     }
   }
@@ -313,7 +483,7 @@ public:
    * @brief Met à jour MPU6050 (horizontalité)
    */
   void updateMPU6050() {
-    if (!state.sensors.mpu6050 || !mpu6050) return;
+    if (!mpu6050 || !state.sensors.mpu6050) return;
     
     if (mpu6050->update()) {
       state.level.roll = mpu6050->getRoll();
@@ -323,37 +493,67 @@ public:
       state.level.rawPitch = mpu6050->getRawPitch();
       state.level.totalTilt = mpu6050->getTotalTilt();
       state.level.temperature = mpu6050->getTemperature();
-      state.level.timestamp = millis();
+      state.level.timestamp = toTimestamp16(millis());
       state.level.valid = true;
     }
   }
   
   /**
    * @brief Met à jour MQ7 (CO)
+   * 
+   * @details Appelé même hors service : update() pilote les phases de
+   * chauffe et une lecture valide remet le capteur en service.
    */
   void updateMQ7() {
-    if (!state.sensors.mq7 || !mq7) return;
-    
-    if (mq7->update()) {
-      state.safety.coPPM = mq7->getPPM();
-      state.safety.coTimestamp = millis();
-      state.safety.coValid = state.safety.mq7Preheated && isValidPPM(state.safety.coPPM);
+    if (!mq7) return;
+    
+    unsigned long previous = mq7->getLastSampleTime();
+    bool ok = mq7->update();
+    if (mq7->getLastSampleTime() == previous) return;   // Pas de tentative
+    
+    state.safety.sampleSeq++;
+    state.sensors.mq7 = trackGasRead(ok, mq7Failures, state.sensors.mq7, F("MQ7"));
+    state.safety.mq7Fault = !state.sensors.mq7;
+    if (!state.sensors.mq7) state.safety.coValid = false;
+    
+    if (ok) {
+      float co = mq7->getPPM();
+      state.safety.coPPM = co;
+      state.safety.coTimestamp = toTimestamp16(millis());
+      state.safety.coValid = state.safety.mq7Preheated && isValidPPM(co);
     }
   }
   
   /**
    * @brief Met à jour MQ2 (GPL/fumée)
+   * 
+   * @details Appelé même hors service (voir updateMQ7()).
    */
   void updateMQ2() {
-    if (!state.sensors.mq2 || !mq2) return;
+    if (!mq2) return;
+    
+    unsigned long previous = mq2->getLastSampleTime();
+    bool ok = mq2->update();
+    if (mq2->getLastSampleTime() == previous) return;   // Pas de tentative
+    
+    state.safety.sampleSeq++;
+    state.sensors.mq2 = trackGasRead(ok, mq2Failures, state.sensors.mq2, F("MQ2"));
+    state.safety.mq2Fault = !state.sensors.mq2;
+    if (!state.sensors.mq2) {
+      state.safety.gplValid = false;
+      state.safety.smokeValid = false;
+    }
     
-    if (mq2->update()) {
-      state.safety.gplPPM = mq2->getLPG();
-      state.safety.smokePPM = mq2->getSmoke();
-      state.safety.gplTimestamp = millis();
-      state.safety.smokeTimestamp = millis();
-      state.safety.gplValid = state.safety.mq2Preheated && isValidPPM(state.safety.gplPPM);
-      state.safety.smokeValid = state.safety.mq2Preheated && isValidPPM(state.safety.smokePPM);
+    if (ok) {
+      float gpl = mq2->getLPG();
+      float smoke = mq2->getSmoke();
+      Timestamp16 now = toTimestamp16(millis());
+      state.safety.gplPPM = gpl;
+      state.safety.smokePPM = smoke;
+      state.safety.gplTimestamp = now;
+      state.safety.smokeTimestamp = now;
+      state.safety.gplValid = state.safety.mq2Preheated && isValidPPM(gpl);
+      state.safety.smokeValid = state.safety.mq2Preheated && isValidPPM(smoke);
     }
   }
   
@@ -362,31 +562,212 @@ public:
    */
   void updateINA226() {
     // INA226 12V
-    if (state.sensors.ina226_12v && ina226_12v) {
+    if (ina226_12v && state.sensors.ina226_12v) {
       if (ina226_12v->update()) {
         INA226Data data = ina226_12v->getData();
         state.power.voltage12V = data.busVoltage;
         state.power.current12V = data.current;
         state.power.power12V = data.power;
-        state.power.voltage12VTimestamp = data.timestamp;
+        state.power.voltage12VTimestamp = toTimestamp16(data.timestamp);
         state.power.voltage12VValid = data.valid && isValidVoltage(data.busVoltage);
       }
     }
     
     // INA226 5V
-    if (state.sensors.ina226_5v && ina226_5v) {
+    if (ina226_5v && state.sensors.ina226_5v) {
       if (ina226_5v->update()) {
         INA226Data data = ina226_5v->getData();
         state.power.voltage5V = data.busVoltage;
         state.power.current5V = data.current;
         state.power.power5V = data.power;
-        state.power.voltage5VTimestamp = data.timestamp;
+        state.power.voltage5VTimestamp = toTimestamp16(data.timestamp);
         state.power.voltage5VValid = data.valid && isValidVoltage(data.busVoltage);
       }
     }
     
     // Calculer puissance totale
-    state.power.powerTotal = state.power.power12V + state.power.power5V;
+    state.power.powerTotal = (float)state.power.power12V + (float)state.power.power5V;
+  }
+  
+  // ============================================
+  // SUPERVISION (HealthMonitor.h)
+  // ============================================
+  
+  /**
+   * @brief Vérifie si un capteur est prévu par le profil matériel
+   * @param id Capteur
+   * @return true si câblé (BoardProfile.h)
+   */
+  static bool isFitted(SensorId id) {
+    switch (id) {
+      case SensorId::BME280:     return BoardProfile::bme280;
+      case SensorId::DS18B20:    return BoardProfile::ds18b20;
+      case SensorId::MPU6050:    return BoardProfile::mpu6050;
+      case SensorId::INA226_12V: return BoardProfile::ina226_12v;
+      case SensorId::INA226_5V:  return BoardProfile::ina226_5v;
+      default:                   return false;
+    }
+  }
+  
+  /**
+   * @brief Adresse I2C d'un capteur
+   * @param id Capteur
+   * @return Adresse 7 bits, 0 si hors bus I2C (DS18B20)
+   */
+  static uint8_t getAddress(SensorId id) {
+    switch (id) {
+      case SensorId::BME280:     return I2C_BME280;
+      case SensorId::MPU6050:    return I2C_MPU6050;
+      case SensorId::INA226_12V: return I2C_INA226_12V;
+      case SensorId::INA226_5V:  return I2C_INA226_5V;
+      default:                   return 0;
+    }
+  }
+  
+  /**
+   * @brief Vérifie si un capteur est en service
+   * @param id Capteur
+   * @return true si lu par update()
+   */
+  bool isOnline(SensorId id) const {
+    switch (id) {
+      case SensorId::BME280:     return state.sensors.bme280;
+      case SensorId::DS18B20:    return state.sensors.ds18b20;
+      case SensorId::MPU6050:    return state.sensors.mpu6050;
+      case SensorId::INA226_12V: return state.sensors.ina226_12v;
+      case SensorId::INA226_5V:  return state.sensors.ina226_5v;
+      default:                   return false;
+    }
+  }
+  
+  /**
+   * @brief Lectures ratées consécutives d'un capteur (timeout, valeur invalide)
+   * @param id Capteur
+   * @return Compteur du capteur, remis à zéro par une lecture réussie
+   */
+  uint8_t getFailedReads(SensorId id) const {
+    switch (id) {
+      case SensorId::BME280:     return bme280 ? bme280->getFailedReads() : 0;
+      case SensorId::DS18B20:    return ds18b20 ? ds18b20->getFailedReads() : 0;
+      case SensorId::MPU6050:    return mpu6050 ? mpu6050->getFailedReads() : 0;
+      case SensorId::INA226_12V: return ina226_12v ? ina226_12v->getFailedReads() : 0;
+      case SensorId::INA226_5V:  return ina226_5v ? ina226_5v->getFailedReads() : 0;
+      default:                   return 0;
+    }
+  }
+  
+  /**
+   * @brief Âge de la dernière mesure d'un capteur
+   * @param id Capteur
+   * @return Âge en ms (résolution 256 ms, SystemData.h)
+   */
+  unsigned long getSampleAge(SensorId id) const {
+    switch (id) {
+      case SensorId::BME280:     return timestamp16Age(state.environment.tempIntTimestamp);
+      case SensorId::DS18B20:    return timestamp16Age(state.environment.tempExtTimestamp);
+      case SensorId::MPU6050:    return timestamp16Age(state.level.timestamp);
+      case SensorId::INA226_12V: return timestamp16Age(state.power.voltage12VTimestamp);
+      case SensorId::INA226_5V:  return timestamp16Age(state.power.voltage5VTimestamp);
+      default:                   return 0;
+    }
+  }
+  
+  /**
+   * @brief Intervalle d'acquisition du registre pour un capteur
+   * @param id Capteur
+   * @return Intervalle en ms (registre de paramètres, sans profil)
+   */
+  static uint16_t getBaseInterval(SensorId id) {
+    const RuntimeSettings& values = settings.values;
+    switch (id) {
+      case SensorId::BME280:     return values.intervalBME280;
+      case SensorId::DS18B20:    return values.intervalDS18B20;
+      case SensorId::MPU6050:    return values.intervalMPU6050;
+      case SensorId::INA226_12V:
+      case SensorId::INA226_5V:  return values.intervalINA226;
+      default:                   return 0;
+    }
+  }
+  
+  /**
+   * @brief Capteur ralenti par le profil de fonctionnement
+   * @param id Capteur
+   * @return false pour l'INA226 12V : alertes batterie (tension,
+   * surintensité) à la cadence du registre dans tous les profils
+   */
+  static bool isThrottled(SensorId id) {
+    return id != SensorId::INA226_12V;
+  }
+
+  /**
+   * @brief Intervalle d'acquisition courant d'un capteur
+   * @param id Capteur
+   * @return Intervalle en ms (registre × ralentissement du profil,
+   * LEVEL_MPU_INTERVAL pour le MPU6050 pendant le calage)
+   */
+  unsigned long getSampleInterval(SensorId id) const {
+    if (levelling && id == SensorId::MPU6050) return LEVEL_MPU_INTERVAL;
+    if (!isThrottled(id)) return getBaseInterval(id);
+    return scaleInterval(getBaseInterval(id));
+  }
+  
+  /**
+   * @brief Invalide les mesures d'un capteur (données périmées)
+   * @param id Capteur
+   */
+  void invalidate(SensorId id) {
+    switch (id) {
+      case SensorId::BME280:
+        state.environment.tempIntValid = false;
+        state.environment.humidityValid = false;
+        state.environment.pressureValid = false;
+        break;
+      case SensorId::DS18B20:
+        state.environment.tempExtValid = false;
+        break;
+      case SensorId::MPU6050:
+        state.level.valid = false;
+        break;
+      case SensorId::INA226_12V:
+        state.power.voltage12VValid = false;
+        break;
+      case SensorId::INA226_5V:
+        state.power.voltage5VValid = false;
+        break;
+      default:
+        break;
+    }
+  }
+  
+  /**
+   * @brief Met un capteur hors service (plus lu par update())
+   * @param id Capteur
+   */
+  void suspend(SensorId id) {
+    invalidate(id);
+    setOnline(id, false);
+  }
+  
+  /**
+   * @brief Ré-initialise un capteur (begin())
+   * @param id Capteur
+   * @return true si le capteur répond et est remis en service
+   *
+   * @details Intervalles, seuils et offsets sont conservés par les
+   * objets capteurs : seule la configuration matérielle est refaite.
+   */
+  bool restart(SensorId id) {
+    bool ok = false;
+    switch (id) {
+      case SensorId::BME280:     if (bme280) ok = bme280->begin(); break;
+      case SensorId::DS18B20:    if (ds18b20) ok = ds18b20->begin(); break;
+      case SensorId::MPU6050:    if (mpu6050) ok = mpu6050->begin(); break;
+      case SensorId::INA226_12V: if (ina226_12v) ok = ina226_12v->begin(); break;
+      case SensorId::INA226_5V:  if (ina226_5v) ok = ina226_5v->begin(); break;
+      default:                   break;
+    }
+    setOnline(id, ok);
+    return ok;
   }
   
   // ============================================
@@ -399,7 +780,7 @@ public:
    * @return true si succès
    */
   bool calibrateMPU6050(void (*progressCallback)(uint16_t current, uint16_t total) = nullptr) {
-    if (!state.sensors.mpu6050 || !mpu6050) return false;
+    if (!mpu6050 || !state.sensors.mpu6050) return false;
     
     DEBUG_PRINTLN(F("Calibration MPU6050..."));
     
@@ -409,7 +790,12 @@ public:
       mpu6050->setOffsets(rollOffset, pitchOffset);
       state.level.calibrated = true;
       
-      DEBUG_PRINTF("Offsets calcules: Roll=%.2f, Pitch=%.2f\n", rollOffset, pitchOffset);
+      #if USE_SERIAL_DEBUG
+      char rollText[FIXED_FORMAT_MAX], pitchText[FIXED_FORMAT_MAX];
+      FixedFormat::formatFloat(rollText, rollOffset, 2);
+      FixedFormat::formatFloat(pitchText, pitchOffset, 2);
+      DEBUG_PRINTF("Offsets calcules: Roll=%s, Pitch=%s\n", rollText, pitchText);
+      #endif
       return true;
     }
     
@@ -0,0 +1,546 @@
+/**
+ * @file SerialConsole.h
+ * @brief Console de commande série (réglages à chaud)
+ * @author Frédéric BAILLON
+ * @version 0.1.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Analyseur de lignes incrémental : update() lit au plus
+ * CONSOLE_BYTES_PER_UPDATE octets par appel, la commande est exécutée
+ * à la fin de ligne. Aucune attente dans loop().
+ *
+ * Commandes :
+ * - help                   : liste des commandes
+ * - list                   : tous les paramètres et leurs bornes
+ * - get <nom>              : lit un paramètre
+ * - set <nom> <valeur>     : modifie un paramètre (appliqué immédiatement)
+ * - save / load / defaults : EEPROM / EEPROM / valeurs de config.h
+ * - alerts                 : alertes actives
+ * - health                 : santé des capteurs (HealthMonitor.h)
+ * - wdt [gas|alerts|loop] : état du chien de garde / faute simulée
+ * - profile [auto|active|parked|night] : bilan des profils / profil imposé
+ * - calib                  : calibration MPU6050 (offsets à enregistrer par save)
+ * - bench [fmt]            : coût d'accès au registre / du formatage des nombres
+ *
+ * Les réponses passent par le journal (Logger.h) : elles sont
+ * vidées sans bloquer comme le reste du texte de debug.
+ */
+
+#ifndef SERIAL_CONSOLE_H
+#define SERIAL_CONSOLE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "SystemData.h"
+#include "Settings.h"
+#include "SensorManager.h"
+#include "HealthMonitor.h"
+#include "Watchdog.h"
+#include "ProfileManager.h"
+#include "FixedFormat.h"
+
+// ============================================
+// CONFIGURATION
+// ============================================
+#define CONSOLE_LINE_LENGTH       40    ///< Longueur max d'une commande
+#define CONSOLE_BYTES_PER_UPDATE  16    ///< Octets traités par update()
+#define CONSOLE_BENCH_LOOPS       1000  ///< Accès mesurés par la commande bench
+#define CONSOLE_BENCH_FORMATS     100   ///< Conversions mesurées par "bench fmt"
+
+// ============================================
+// CLASSE SerialConsole
+// ============================================
+/**
+ * @class SerialConsole
+ * @brief Console de réglage sur le port série de debug
+ */
+class SerialConsole {
+private:
+  // Ports
+  Stream& input;
+  Print& output;
+
+  // Références
+  SystemState& state;
+  SensorManager* sensors;
+  HealthMonitor* health;
+  ProfileManager* profiles;
+
+  // Ligne en cours
+  char line[CONSOLE_LINE_LENGTH];
+  uint8_t length;
+  bool overflow;              ///< Ligne trop longue : ignorée jusqu'à la fin
+
+  /**
+   * @brief Affiche un paramètre : nom = valeur
+   * @param index Index dans SETTINGS_TABLE
+   * @param withRange true pour ajouter les bornes
+   */
+  void printSetting(uint8_t index, bool withRange) {
+    SettingInfo info;
+    settings.getInfo(index, info);
+    bool integer = settings.isInteger(index);
+
+    output.print(info.name);
+    output.print(settings.isDefault(index) ? F(" = ") : F(" * "));
+    printValue(settings.get(index), integer);
+
+    if (withRange) {
+      output.print(F("  ["));
+      printValue(info.minValue, integer);
+      output.print(F(" .. "));
+      printValue(info.maxValue, integer);
+      output.print(']');
+    }
+    output.println();
+  }
+
+  void printValue(float value, bool integer) {
+    if (integer) {
+      output.print((uint32_t)value);
+    } else {
+      output.print(value, 2);
+    }
+  }
+
+  /**
+   * @brief Recherche un paramètre, message d'erreur si inconnu
+   * @return Index, -1 si inconnu
+   */
+  int8_t findSetting(const char* name) {
+    int8_t index = name ? settings.find(name) : -1;
+    if (index < 0) {
+      output.print(F("Parametre inconnu: "));
+      output.println(name ? name : "");
+    }
+    return index;
+  }
+
+  // ============================================
+  // COMMANDES
+  // ============================================
+
+  void commandHelp() {
+    output.println(F("Commandes: help, list, get <nom>, set <nom> <valeur>,"));
+    output.println(F("           save, load, defaults, alerts, health, wdt [tache],"));
+    output.println(F("           profile [auto|active|parked|night], calib, bench [fmt]"));
+    output.println(F("(* = valeur modifiee)"));
+  }
+
+  void commandList() {
+    for (uint8_t i = 0; i < SETTINGS_COUNT; i++) {
+      printSetting(i, true);
+    }
+  }
+
+  void commandGet(const char* name) {
+    int8_t index = findSetting(name);
+    if (index >= 0) printSetting(index, false);
+  }
+
+  void commandSet(const char* name, const char* value) {
+    int8_t index = findSetting(name);
+    if (index < 0) return;
+
+    if (!value) {
+      output.println(F("Valeur manquante"));
+      return;
+    }
+
+    char* end;
+    float parsed = strtod(value, &end);
+    if (end == value || *end != '\0' || !settings.set(index, parsed)) {
+      output.print(F("Valeur refusee: "));
+      printSetting(index, true);
+      return;
+    }
+
+    if (sensors) sensors->applySettings();
+    printSetting(index, false);
+  }
+
+  void commandAlerts() {
+    uint8_t count = state.alerts.activeAlertCount;
+    output.print(F("Alertes actives: "));
+    output.println(count);
+
+    for (uint8_t i = 0; i < count; i++) {
+      const Alert& alert = state.alerts.alerts[i];
+      output.print(F("  niveau "));
+      output.print((uint8_t)alert.level);
+      output.print(F(" type "));
+      output.print((uint8_t)alert.type);
+      output.print(F(" valeur "));
+      output.print(alertValue(alert), 2);
+      output.print(F(" seuil "));
+      output.print(alertThreshold(alert), 2);
+      output.print(F(" depuis "));
+      output.print(timestamp16Age(alert.timestamp) / 1000);
+      output.print(F("s "));
+      output.println(alertMessage(alert));
+    }
+  }
+
+  void commandHealth() {
+    if (!sensors || !health) return;
+
+    for (uint8_t i = 0; i < (uint8_t)SensorId::COUNT; i++) {
+      SensorId id = (SensorId)i;
+      if (!SensorManager::isFitted(id)) continue;
+
+      const DeviceHealth& info = health->getHealth(id);
+      output.print(HealthMonitor::sensorName(id));
+      output.print(sensors->isOnline(id) ? F(": OK") : F(": HORS SERVICE"));
+      output.print(F(" - erreurs "));
+      output.print(info.errors);
+      output.print(F(" lectures "));
+      output.print(info.readFaults);
+      output.print(F(" perimes "));
+      output.print(info.staleCount);
+      output.print(F(" relances "));
+      output.print(info.restarts);
+      output.print(F(" - mesure il y a "));
+      output.print(sensors->getSampleAge(id) / 1000);
+      output.println('s');
+    }
+    output.print(F("Bus I2C: expirations "));
+    output.print(I2CBus::getTimeoutCount());
+    output.print(F(" deblocages "));
+    output.println(I2CBus::getRecoveryCount());
+  }
+
+  /**
+   * @brief État du chien de garde, ou injection d'une faute
+   * @param task nullptr, "gas", "alerts" ou "loop"
+   *
+   * @details La tâche désignée cesse de se signaler : le WDT n'est
+   * plus réarmé et la carte redémarre ; la trace est rapportée au boot.
+   */
+  void commandWatchdog(const char* task) {
+    if (!task) {
+      output.print(F("Watchdog: "));
+      output.print(watchdog.isRunning() ? F("actif") : F("inactif"));
+      output.print(F(" - cause du dernier reset: "));
+      output.print(Watchdog::causeName(watchdog.getResetCause()));
+      output.print(F(" - resets watchdog: "));
+      output.println(watchdog.getResetCount());
+      return;
+    }
+
+    // Sans WDT armé, une faute bloquerait la carte définitivement
+    if (!watchdog.isRunning()) {
+      output.println(F("Watchdog inactif (USE_WATCHDOG)"));
+      return;
+    }
+
+    if (strcmp_P(task, PSTR("gas")) == 0) {
+      watchdog.inject(WatchdogTask::GAS);
+    } else if (strcmp_P(task, PSTR("alerts")) == 0) {
+      watchdog.inject(WatchdogTask::ALERTS);
+    } else if (strcmp_P(task, PSTR("loop")) == 0) {
+      output.println(F("Blocage de loop()..."));
+      logger.flush();
+      watchdog.hang();
+    } else {
+      output.print(F("Tache inconnue: "));
+      output.println(task);
+      return;
+    }
+    output.println(F("Faute injectee, reset attendu"));
+  }
+
+  /**
+   * @brief Bilan des profils de fonctionnement, ou profil imposé
+   * @param name nullptr, "auto", "active", "parked" ou "night"
+   *
+   * @details Lectures I2C et trames LCD par minute d'après les
+   * intervalles ; activité CPU mesurée lors du dernier séjour.
+   */
+  void commandProfile(const char* name) {
+    if (!profiles) return;
+
+    if (name) {
+      if (strcmp_P(name, PSTR("auto")) == 0) {
+        profiles->release();
+      } else if (strcmp_P(name, PSTR("active")) == 0) {
+        profiles->force(OperatingProfile::ACTIVE);
+      } else if (strcmp_P(name, PSTR("parked")) == 0) {
+        profiles->force(OperatingProfile::PARKED);
+      } else if (strcmp_P(name, PSTR("night")) == 0) {
+        profiles->force(OperatingProfile::NIGHT);
+      } else {
+        output.print(F("Profil inconnu: "));
+        output.println(name);
+        return;
+      }
+    }
+
+    output.print(F("Profil: "));
+    output.print(ProfileManager::profileName(profiles->getProfile()));
+    output.println(profiles->isForced() ? F(" (impose)") : F(" (auto)"));
+
+    uint16_t activeReads = ProfileManager::getSensorReadsPerMinute(OperatingProfile::ACTIVE);
+    for (uint8_t i = 0; i < (uint8_t)OperatingProfile::COUNT; i++) {
+      OperatingProfile p = (OperatingProfile)i;
+      const ProfileStats& info = profiles->getStats(p);
+      uint16_t reads = ProfileManager::getSensorReadsPerMinute(p);
+
+      output.print(ProfileManager::profileName(p));
+      output.print(F(": x"));
+      output.print(ProfileManager::scale(p));
+      output.print(F(" - I2C capteurs "));
+      output.print(reads);
+      output.print(F("/min (-"));
+      output.print(activeReads ? 100 - (uint32_t)reads * 100 / activeReads : 0);
+      output.print(F("%) - LCD "));
+      output.print(ProfileManager::getLcdFramesPerMinute(p));
+      output.print(F(" trames/min - CPU "));
+      if (info.cpuPercent == 0xFF) {
+        output.print('?');
+      } else {
+        output.print(info.cpuPercent);
+      }
+      output.print(F("% - "));
+      output.print(info.timeMs / 1000);
+      output.println('s');
+    }
+  }
+
+  void commandCalibrate() {
+    if (!state.sensors.mpu6050) {
+      output.println(F("MPU6050 absent"));
+      return;
+    }
+    state.calibrationMode = true;
+    output.println(F("Calibration MPU6050 lancee (save pour enregistrer)"));
+  }
+
+  /**
+   * @brief Mesure le coût d'une lecture du registre
+   *
+   * @details Compare une constante (ancien #define), un champ de
+   * settings.values et la recherche par index (console). La barrière
+   * mémoire empêche le compilateur de sortir la lecture de la boucle.
+   */
+  void commandBench() {
+    volatile uint16_t sink;
+    unsigned long start;
+
+    start = micros();
+    for (uint16_t i = 0; i < CONSOLE_BENCH_LOOPS; i++) {
+      sink = CO_THRESHOLD_WARNING;
+      asm volatile("" ::: "memory");
+    }
+    unsigned long constantUs = micros() - start;
+
+    start = micros();
+    for (uint16_t i = 0; i < CONSOLE_BENCH_LOOPS; i++) {
+      sink = settings.values.coWarning;
+      asm volatile("" ::: "memory");
+    }
+    unsigned long fieldUs = micros() - start;
+
+    start = micros();
+    for (uint16_t i = 0; i < CONSOLE_BENCH_LOOPS; i++) {
+      sink = settings.get(1);
+      asm volatile("" ::: "memory");
+    }
+    unsigned long lookupUs = micros() - start;
+    (void)sink;
+
+    output.print(F("Pour "));
+    output.print(CONSOLE_BENCH_LOOPS);
+    output.println(F(" lectures (us):"));
+    output.print(F("  constante      : "));
+    output.println(constantUs);
+    output.print(F("  settings.values: "));
+    output.println(fieldUs);
+    output.print(F("  par index      : "));
+    output.println(lookupUs);
+    output.print(F("Surcout champ: "));
+    output.print((float)((long)fieldUs - (long)constantUs) * (F_CPU / 1000000UL) / CONSOLE_BENCH_LOOPS, 1);
+    output.println(F(" cycle(s)/lecture"));
+  }
+
+  /**
+   * @brief Mesure le coût du formatage d'une mesure (12.34 V, 2 décimales)
+   *
+   * @details Compare dtostrf() (avr-libc, émulation flottante),
+   * FixedFormat::formatFloat() (une multiplication flottante) et
+   * FixedFormat::format() sur la valeur brute Fixed16, chemin des
+   * écrans et des statistiques.
+   */
+  void commandBenchFormat() {
+    char buffer[FIXED_FORMAT_MAX];
+    volatile float value = 12.34;
+    volatile int16_t raw = 1234;
+    unsigned long start;
+
+    start = micros();
+    for (uint16_t i = 0; i < CONSOLE_BENCH_FORMATS; i++) {
+      dtostrf(value, 0, 2, buffer);
+      asm volatile("" ::: "memory");
+    }
+    unsigned long dtostrfUs = micros() - start;
+
+    start = micros();
+    for (uint16_t i = 0; i < CONSOLE_BENCH_FORMATS; i++) {
+      FixedFormat::formatFloat(buffer, value, 2);
+      asm volatile("" ::: "memory");
+    }
+    unsigned long floatUs = micros() - start;
+
+    start = micros();
+    for (uint16_t i = 0; i < CONSOLE_BENCH_FORMATS; i++) {
+      FixedFormat::format(buffer, raw, 2, 2);
+      asm volatile("" ::: "memory");
+    }
+    unsigned long fixedUs = micros() - start;
+
+    output.print(F("Pour "));
+    output.print(CONSOLE_BENCH_FORMATS);
+    output.print(F(" conversions de "));
+    output.print(buffer);
+    output.println(F(" (us):"));
+    output.print(F("  dtostrf          : "));
+    output.println(dtostrfUs);
+    output.print(F("  FixedFormat float: "));
+    output.println(floatUs);
+    output.print(F("  FixedFormat brut : "));
+    output.println(fixedUs);
+    if (fixedUs) {
+      output.print(F("Gain: x"));
+      output.println(dtostrfUs / fixedUs);
+    }
+  }
+
+  /**
+   * @brief Exécute la ligne reçue
+   */
+  void execute() {
+    char* command = strtok(line, " \t");
+    if (!command) return;
+    char* arg1 = strtok(nullptr, " \t");
+    char* arg2 = strtok(nullptr, " \t");
+
+    if (strcmp_P(command, PSTR("help")) == 0) {
+      commandHelp();
+    } else if (strcmp_P(command, PSTR("list")) == 0) {
+      commandList();
+    } else if (strcmp_P(command, PSTR("get")) == 0) {
+      commandGet(arg1);
+    } else if (strcmp_P(command, PSTR("set")) == 0) {
+      commandSet(arg1, arg2);
+    } else if (strcmp_P(command, PSTR("save")) == 0) {
+      output.print(settings.save());
+      output.println(F(" parametre(s) modifie(s) enregistre(s)"));
+    } else if (strcmp_P(command, PSTR("load")) == 0) {
+      // Toujours appliquer : les valeurs ont changé dans tous les cas
+      SettingsLoad result = settings.load();
+      if (sensors) sensors->applySettings();
+      switch (result) {
+        case SettingsLoad::LOADED:
+          output.println(F("Parametres recharges"));
+          break;
+        case SettingsLoad::REPAIRED:
+          output.println(F("Parametres recharges avec corrections (valeurs rejetees remises par defaut)"));
+          break;
+        default:
+          output.println(F("EEPROM vide ou invalide : valeurs par defaut restaurees"));
+          break;
+      }
+    } else if (strcmp_P(command, PSTR("defaults")) == 0) {
+      settings.setDefaults();
+      if (sensors) sensors->applySettings();
+      output.println(F("Valeurs par defaut (save pour enregistrer)"));
+    } else if (strcmp_P(command, PSTR("alerts")) == 0) {
+      commandAlerts();
+    } else if (strcmp_P(command, PSTR("health")) == 0) {
+      commandHealth();
+    } else if (strcmp_P(command, PSTR("wdt")) == 0) {
+      commandWatchdog(arg1);
+    } else if (strcmp_P(command, PSTR("profile")) == 0) {
+      commandProfile(arg1);
+    } else if (strcmp_P(command, PSTR("calib")) == 0) {
+      commandCalibrate();
+    } else if (strcmp_P(command, PSTR("bench")) == 0) {
+      if (arg1 && strcmp_P(arg1, PSTR("fmt")) == 0) {
+        commandBenchFormat();
+      } else {
+        commandBench();
+      }
+    } else {
+      output.print(F("Commande inconnue: "));
+      output.println(command);
+    }
+  }
+
+public:
+  /**
+   * @brief Constructeur
+   * @param in Port d'entrée (Serial)
+   * @param out Sortie des réponses (journal)
+   * @param sysState Référence à l'état système
+   * @param sensorManager Gestionnaire capteurs (application des intervalles)
+   * @param healthMonitor Superviseur capteurs (commande health)
+   * @param profileManager Profils de fonctionnement (commande profile)
+   */
+  SerialConsole(Stream& in, Print& out, SystemState& sysState, SensorManager* sensorManager,
+                HealthMonitor* healthMonitor, ProfileManager* profileManager)
+    : input(in),
+      output(out),
+      state(sysState),
+      sensors(sensorManager),
+      health(healthMonitor),
+      profiles(profileManager),
+      length(0),
+      overflow(false)
+  {
+  }
+
+  // ============================================
+  // MISE À JOUR
+  // ============================================
+
+  /**
+   * @brief Lit les octets disponibles (non-bloquant)
+   */
+  void update() {
+    for (uint8_t i = 0; i < CONSOLE_BYTES_PER_UPDATE && input.available() > 0; i++) {
+      feed(input.read());
+    }
+  }
+
+  /**
+   * @brief Traite un octet reçu
+   * @param c Caractère
+   */
+  void feed(char c) {
+    if (c == '\r' || c == '\n') {
+      if (overflow) {
+        output.println(F("Commande trop longue"));
+      } else if (length > 0) {
+        line[length] = '\0';
+        execute();
+      }
+      length = 0;
+      overflow = false;
+      return;
+    }
+
+    // Retour arrière (terminal)
+    if (c == '\b' || c == 0x7F) {
+      if (length > 0) length--;
+      return;
+    }
+
+    if (length < CONSOLE_LINE_LENGTH - 1) {
+      line[length++] = c;
+    } else {
+      overflow = true;
+    }
+  }
+};
+
+#endif // SERIAL_CONSOLE_H
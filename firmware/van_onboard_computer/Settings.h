@@ -0,0 +1,514 @@
+/**
+ * @file Settings.h
+ * @brief Registre des paramètres (seuils, intervalles), modifiables à chaud
+ * @author Frédéric BAILLON
+ * @version 0.2.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Source unique des seuils et intervalles utilisés par les modules :
+ * - Valeurs courantes : struct RuntimeSettings en RAM (settings.values)
+ * - Description en PROGMEM : nom, type, bornes, valeur par défaut (config.h)
+ * - EEPROM : uniquement les paramètres différents de leur valeur par défaut
+ *   [magic][version][nombre][index, valeur]...[CRC16]
+ *
+ * Coût d'accès : settings est un objet global d'adresse fixe,
+ * settings.values.xxx se compile en un chargement direct (LDS), comme
+ * une variable globale. La recherche par nom (get/set/find) est réservée
+ * à la console. Mesure sur cible : commande "bench" de la console.
+ *
+ * Seuils liés toujours ordonnés (set() et load()) : info < warning <
+ * danger pour CO/GPL/fumée, v12_min < v12_warn. Un seuil inversé
+ * désactiverait silencieusement un niveau d'alerte.
+ *
+ * @note Les index de SETTINGS_TABLE sont enregistrés en EEPROM :
+ *       ajouter les nouveaux paramètres en fin de table.
+ */
+
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "config.h"
+#include "DashboardProtocol.h"
+
+// ============================================
+// CONFIGURATION
+// ============================================
+#define SETTINGS_EEPROM_ADDRESS 0       ///< Début de l'image en EEPROM
+#define SETTINGS_MAGIC          0x5653  ///< "VS"
+#define SETTINGS_VERSION        2       ///< Format de l'image EEPROM
+#define SETTINGS_NAME_LENGTH    16      ///< Longueur max d'un nom (zéro inclus)
+
+// ============================================
+// TYPES ET STRUCTURES
+// ============================================
+/**
+ * @struct RuntimeSettings
+ * @brief Valeurs courantes des paramètres modifiables
+ */
+struct RuntimeSettings {
+  // Seuils gaz (ppm)
+  uint16_t coInfo;
+  uint16_t coWarning;
+  uint16_t coDanger;
+  uint16_t gplInfo;
+  uint16_t gplWarning;
+  uint16_t gplDanger;
+  uint16_t smokeInfo;
+  uint16_t smokeWarning;
+  uint16_t smokeDanger;
+
+  // Seuils électriques (V)
+  float voltage12VMin;
+  float voltage12VMax;
+  float voltage5VMin;
+  float voltage5VMax;
+
+  // Intervalles d'acquisition (ms)
+  uint16_t intervalBME280;
+  uint16_t intervalDS18B20;
+  uint16_t intervalMPU6050;
+  uint16_t intervalINA226;
+  uint16_t intervalMQ7;
+  uint16_t intervalMQ2;
+
+  // Affichage
+  uint32_t backlightTimeout;    ///< ms (0 = désactivé)
+
+  // Calibration MPU6050 (0/0 = non calibré)
+  float levelRollOffset;        ///< °
+  float levelPitchOffset;       ///< °
+
+  // Seuils électriques complémentaires
+  float voltage12VWarning;      ///< V - batterie faible
+  float voltage12VNominal;      ///< V - au repos
+  float voltage12VCharging;     ///< V - en charge
+  float voltage5VNominal;       ///< V
+  float current12VMax;          ///< A
+  float current5VMax;           ///< A
+
+  // Seuils environnement
+  float tempWarning;            ///< °C - chaleur excessive
+  float tempFreeze;             ///< °C - risque de gel
+  float humidityWarning;        ///< % - risque condensation
+  float tiltWarning;            ///< ° - inclinaison notable
+
+  // Intervalles et délais d'interface
+  uint16_t intervalDisplay;     ///< ms - rafraîchissement LCD
+  uint16_t intervalLeds;        ///< ms - rafraîchissement LEDs
+  uint32_t screenTimeout;       ///< ms - retour écran d'accueil
+
+  // Géométrie du véhicule (calage)
+  uint16_t wheelbase;           ///< cm - empattement
+  uint16_t track;               ///< cm - voie
+};
+
+/**
+ * @enum SettingType
+ * @brief Type d'un champ de RuntimeSettings
+ */
+enum class SettingType : uint8_t {
+  U16,
+  U32,
+  FLOAT
+};
+
+/**
+ * @enum SettingsLoad
+ * @brief Issue du chargement EEPROM (Settings::load())
+ */
+enum class SettingsLoad : uint8_t {
+  LOADED,     ///< Image valide, appliquée telle quelle
+  REPAIRED,   ///< Image valide, enregistrements rejetés ou seuils remis par défaut
+  DEFAULTS    ///< Image absente ou invalide : valeurs par défaut seules
+};
+
+/**
+ * @struct SettingInfo
+ * @brief Description d'un paramètre (PROGMEM)
+ */
+struct SettingInfo {
+  char name[SETTINGS_NAME_LENGTH];  ///< Nom utilisé par la console
+  uint8_t offset;                   ///< offsetof(RuntimeSettings, ...)
+  SettingType type;                 ///< Type du champ
+  float minValue;                   ///< Borne basse acceptée
+  float maxValue;                   ///< Borne haute acceptée
+  float defaultValue;               ///< Valeur de config.h
+};
+
+#define SETTING(name, field, type, min, max, def) \
+  { name, offsetof(RuntimeSettings, field), SettingType::type, min, max, def }
+
+const SettingInfo SETTINGS_TABLE[] PROGMEM = {
+  SETTING("co_info",        coInfo,             U16,   10,    1000,    CO_THRESHOLD_INFO),
+  SETTING("co_warn",        coWarning,          U16,   10,    1000,    CO_THRESHOLD_WARNING),
+  SETTING("co_danger",      coDanger,           U16,   10,    1000,    CO_THRESHOLD_DANGER),
+  SETTING("gpl_info",       gplInfo,            U16,   100,   10000,   GPL_THRESHOLD_INFO),
+  SETTING("gpl_warn",       gplWarning,         U16,   100,   10000,   GPL_THRESHOLD_WARNING),
+  SETTING("gpl_danger",     gplDanger,          U16,   100,   10000,   GPL_THRESHOLD_DANGER),
+  SETTING("smoke_info",     smokeInfo,          U16,   100,   10000,   SMOKE_THRESHOLD_INFO),
+  SETTING("smoke_warn",     smokeWarning,       U16,   100,   10000,   SMOKE_THRESHOLD_WARNING),
+  SETTING("smoke_danger",   smokeDanger,        U16,   100,   10000,   SMOKE_THRESHOLD_DANGER),
+  SETTING("v12_min",        voltage12VMin,      FLOAT, 9.0,   13.0,    VOLTAGE_12V_MIN),
+  SETTING("v12_max",        voltage12VMax,      FLOAT, 13.0,  16.0,    VOLTAGE_12V_MAX),
+  SETTING("v5_min",         voltage5VMin,       FLOAT, 4.0,   5.0,     VOLTAGE_5V_MIN),
+  SETTING("v5_max",         voltage5VMax,       FLOAT, 5.0,   6.0,     VOLTAGE_5V_MAX),
+  SETTING("t_bme280",       intervalBME280,     U16,   1000,  60000,   INTERVAL_BME280),
+  SETTING("t_ds18b20",      intervalDS18B20,    U16,   1000,  60000,   INTERVAL_DS18B20),
+  SETTING("t_mpu6050",      intervalMPU6050,    U16,   100,   10000,   INTERVAL_MPU6050),
+  SETTING("t_ina226",       intervalINA226,     U16,   200,   60000,   INTERVAL_INA226),
+  SETTING("t_mq7",          intervalMQ7,        U16,   500,   60000,   INTERVAL_MQ7),
+  SETTING("t_mq2",          intervalMQ2,        U16,   500,   60000,   INTERVAL_MQ2),
+  SETTING("lcd_timeout",    backlightTimeout,   U32,   0,     3600000, LCD_BACKLIGHT_TIMEOUT),
+  SETTING("roll_off",       levelRollOffset,    FLOAT, -30.0, 30.0,    0.0),
+  SETTING("pitch_off",      levelPitchOffset,   FLOAT, -30.0, 30.0,    0.0),
+  SETTING("v12_warn",       voltage12VWarning,  FLOAT, 10.0,  13.0,    VOLTAGE_12V_WARNING),
+  SETTING("v12_nominal",    voltage12VNominal,  FLOAT, 11.0,  13.0,    VOLTAGE_12V_NOMINAL),
+  SETTING("v12_charging",   voltage12VCharging, FLOAT, 12.5,  15.0,    VOLTAGE_12V_CHARGING),
+  SETTING("v5_nominal",     voltage5VNominal,   FLOAT, 4.5,   5.5,     VOLTAGE_5V_NOMINAL),
+  SETTING("i12_max",        current12VMax,      FLOAT, 1.0,   40.0,    CURRENT_12V_MAX),
+  SETTING("i5_max",         current5VMax,       FLOAT, 0.5,   8.0,     CURRENT_5V_MAX),
+  SETTING("temp_warn",      tempWarning,        FLOAT, 20.0,  60.0,    TEMP_WARNING),
+  SETTING("temp_freeze",    tempFreeze,         FLOAT, -20.0, 10.0,    TEMP_FREEZE),
+  SETTING("hum_warn",       humidityWarning,    FLOAT, 40.0,  100.0,   HUMIDITY_WARNING),
+  SETTING("tilt_warn",      tiltWarning,        FLOAT, 1.0,   30.0,    TILT_WARNING),
+  SETTING("t_display",      intervalDisplay,    U16,   20,    1000,    INTERVAL_DISPLAY),
+  SETTING("t_leds",         intervalLeds,       U16,   20,    1000,    INTERVAL_LEDS),
+  SETTING("screen_timeout", screenTimeout,      U32,   10000, 3600000, ENCODER_TIMEOUT),
+  SETTING("wheelbase",      wheelbase,          U16,   150,   600,     LEVEL_WHEELBASE),
+  SETTING("track",          track,              U16,   100,   250,     LEVEL_TRACK),
+};
+
+#undef SETTING
+
+#define SETTINGS_COUNT          (sizeof(SETTINGS_TABLE) / sizeof(SETTINGS_TABLE[0]))
+
+// ============================================
+// CLASSE Settings
+// ============================================
+/**
+ * @class Settings
+ * @brief Paramètres modifiables à chaud
+ */
+class Settings {
+private:
+  /**
+   * @struct Header
+   * @brief En-tête de l'image EEPROM
+   */
+  struct Header {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t count;              ///< Paramètres enregistrés
+  };
+
+  /**
+   * @struct Override
+   * @brief Paramètre différent de sa valeur par défaut
+   */
+  struct __attribute__((packed)) Override {
+    uint8_t index;
+    float value;
+  };
+
+  /**
+   * @brief Adresse d'un champ dans values
+   */
+  uint8_t* fieldAddress(const SettingInfo& info) {
+    return reinterpret_cast<uint8_t*>(&values) + info.offset;
+  }
+
+  /**
+   * @brief Écrit un champ sans contrôle de bornes
+   */
+  void store(const SettingInfo& info, float value) {
+    uint8_t* field = fieldAddress(info);
+
+    switch (info.type) {
+      case SettingType::U16: {
+        uint16_t v = (uint16_t)(value + 0.5);
+        memcpy(field, &v, sizeof(v));
+        break;
+      }
+      case SettingType::U32: {
+        uint32_t v = (uint32_t)(value + 0.5);
+        memcpy(field, &v, sizeof(v));
+        break;
+      }
+      default:
+        memcpy(field, &value, sizeof(value));
+        break;
+    }
+  }
+
+  /**
+   * @brief Vérifie un triplet de seuils info < warning < danger
+   */
+  static bool increasing(uint16_t info, uint16_t warning, uint16_t danger) {
+    return info < warning && warning < danger;
+  }
+
+  /**
+   * @brief Vérifie l'ordre de tous les seuils liés
+   */
+  bool ordered() const {
+    return increasing(values.coInfo, values.coWarning, values.coDanger) &&
+           increasing(values.gplInfo, values.gplWarning, values.gplDanger) &&
+           increasing(values.smokeInfo, values.smokeWarning, values.smokeDanger) &&
+           values.voltage12VMin < values.voltage12VWarning;
+  }
+
+  /**
+   * @brief Remet à leur valeur par défaut les groupes de seuils désordonnés
+   * @return false si un groupe a été réinitialisé
+   */
+  bool repairOrder() {
+    bool ok = true;
+    if (!increasing(values.coInfo, values.coWarning, values.coDanger)) {
+      values.coInfo = CO_THRESHOLD_INFO;
+      values.coWarning = CO_THRESHOLD_WARNING;
+      values.coDanger = CO_THRESHOLD_DANGER;
+      ok = false;
+    }
+    if (!increasing(values.gplInfo, values.gplWarning, values.gplDanger)) {
+      values.gplInfo = GPL_THRESHOLD_INFO;
+      values.gplWarning = GPL_THRESHOLD_WARNING;
+      values.gplDanger = GPL_THRESHOLD_DANGER;
+      ok = false;
+    }
+    if (!increasing(values.smokeInfo, values.smokeWarning, values.smokeDanger)) {
+      values.smokeInfo = SMOKE_THRESHOLD_INFO;
+      values.smokeWarning = SMOKE_THRESHOLD_WARNING;
+      values.smokeDanger = SMOKE_THRESHOLD_DANGER;
+      ok = false;
+    }
+    if (!(values.voltage12VMin < values.voltage12VWarning)) {
+      values.voltage12VMin = VOLTAGE_12V_MIN;
+      values.voltage12VWarning = VOLTAGE_12V_WARNING;
+      ok = false;
+    }
+    return ok;
+  }
+
+  /**
+   * @brief Écrit un champ après contrôle de ses bornes seules
+   * @return false si hors bornes
+   */
+  bool storeChecked(uint8_t index, float value) {
+    SettingInfo info;
+    getInfo(index, info);
+    if (value < info.minValue || value > info.maxValue) return false;
+
+    store(info, value);
+    return true;
+  }
+
+  /**
+   * @brief Adresse EEPROM d'un enregistrement
+   */
+  static int overrideAddress(uint8_t slot) {
+    return SETTINGS_EEPROM_ADDRESS + sizeof(Header) + slot * sizeof(Override);
+  }
+
+public:
+  RuntimeSettings values;       ///< Valeurs courantes (lecture directe)
+
+  Settings() {
+    setDefaults();
+  }
+
+  // ============================================
+  // VALEURS PAR DÉFAUT / EEPROM
+  // ============================================
+
+  /**
+   * @brief Recharge les valeurs par défaut (table PROGMEM)
+   */
+  void setDefaults() {
+    SettingInfo info;
+    for (uint8_t i = 0; i < SETTINGS_COUNT; i++) {
+      getInfo(i, info);
+      store(info, info.defaultValue);
+    }
+  }
+
+  /**
+   * @brief Charge les valeurs par défaut puis les paramètres de l'EEPROM
+   * @return DEFAULTS si image absente ou invalide, REPAIRED si des
+   *         enregistrements ont été ignorés ou des seuils remis par défaut
+   *
+   * @details Un enregistrement hors bornes ou d'index inconnu est ignoré.
+   * L'ordre des seuils est vérifié une fois tous les enregistrements
+   * appliqués ; un groupe désordonné reprend ses valeurs par défaut.
+   */
+  SettingsLoad load() {
+    setDefaults();
+
+    Header header;
+    EEPROM.get(SETTINGS_EEPROM_ADDRESS, header);
+    if (header.magic != SETTINGS_MAGIC ||
+        header.version != SETTINGS_VERSION ||
+        header.count > SETTINGS_COUNT) {
+      return SettingsLoad::DEFAULTS;
+    }
+
+    // Vérifier le CRC avant d'appliquer quoi que ce soit
+    uint16_t crc = 0xFFFF;
+    Override entry;
+    for (uint8_t i = 0; i < header.count; i++) {
+      EEPROM.get(overrideAddress(i), entry);
+      crc = dashCrc16(reinterpret_cast<const uint8_t*>(&entry), sizeof(entry), crc);
+    }
+    uint16_t storedCrc;
+    EEPROM.get(overrideAddress(header.count), storedCrc);
+    if (crc != storedCrc) return SettingsLoad::DEFAULTS;
+
+    bool repaired = false;
+    for (uint8_t i = 0; i < header.count; i++) {
+      EEPROM.get(overrideAddress(i), entry);
+      if (entry.index >= SETTINGS_COUNT || !storeChecked(entry.index, entry.value)) {
+        repaired = true;
+      }
+    }
+    if (!repairOrder()) repaired = true;
+
+    return repaired ? SettingsLoad::REPAIRED : SettingsLoad::LOADED;
+  }
+
+  /**
+   * @brief Enregistre en EEPROM les paramètres modifiés
+   * @return Nombre de paramètres enregistrés
+   *
+   * @details EEPROM.put() n'écrit que les octets modifiés (usure limitée).
+   */
+  uint8_t save() {
+    uint16_t crc = 0xFFFF;
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < SETTINGS_COUNT; i++) {
+      if (isDefault(i)) continue;
+
+      Override entry = { i, get(i) };
+      EEPROM.put(overrideAddress(count++), entry);
+      crc = dashCrc16(reinterpret_cast<const uint8_t*>(&entry), sizeof(entry), crc);
+    }
+
+    Header header = { SETTINGS_MAGIC, SETTINGS_VERSION, count };
+    EEPROM.put(overrideAddress(count), crc);
+    EEPROM.put(SETTINGS_EEPROM_ADDRESS, header);
+    return count;
+  }
+
+  // ============================================
+  // ACCÈS PAR NOM (console)
+  // ============================================
+
+  /**
+   * @brief Recherche un paramètre par nom
+   * @param name Nom
+   * @return Index dans SETTINGS_TABLE, -1 si inconnu
+   */
+  int8_t find(const char* name) const {
+    for (uint8_t i = 0; i < SETTINGS_COUNT; i++) {
+      if (strcmp_P(name, SETTINGS_TABLE[i].name) == 0) return i;
+    }
+    return -1;
+  }
+
+  /**
+   * @brief Lit la description d'un paramètre
+   * @param index Index dans SETTINGS_TABLE
+   * @param info [out] Description
+   */
+  void getInfo(uint8_t index, SettingInfo& info) const {
+    memcpy_P(&info, &SETTINGS_TABLE[index], sizeof(SettingInfo));
+  }
+
+  /**
+   * @brief Lit un paramètre
+   * @param index Index dans SETTINGS_TABLE
+   * @return Valeur (convertie en float)
+   */
+  float get(uint8_t index) {
+    SettingInfo info;
+    getInfo(index, info);
+    const uint8_t* field = fieldAddress(info);
+
+    switch (info.type) {
+      case SettingType::U16: {
+        uint16_t v;
+        memcpy(&v, field, sizeof(v));
+        return v;
+      }
+      case SettingType::U32: {
+        uint32_t v;
+        memcpy(&v, field, sizeof(v));
+        return v;
+      }
+      default: {
+        float v;
+        memcpy(&v, field, sizeof(v));
+        return v;
+      }
+    }
+  }
+
+  /**
+   * @brief Modifie un paramètre (en RAM uniquement)
+   * @param index Index dans SETTINGS_TABLE
+   * @param value Nouvelle valeur
+   * @return false si hors bornes ou si l'ordre des seuils serait rompu
+   *
+   * @details Pour déplacer un groupe de seuils, modifier d'abord celui
+   * qui s'éloigne des autres (ex. co_danger avant co_warn en hausse).
+   */
+  bool set(uint8_t index, float value) {
+    float previous = get(index);
+    if (!storeChecked(index, value)) return false;
+
+    if (!ordered()) {
+      storeChecked(index, previous);
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Vérifie si un paramètre a sa valeur par défaut
+   * @param index Index dans SETTINGS_TABLE
+   * @return true si inchangé
+   */
+  bool isDefault(uint8_t index) {
+    SettingInfo info;
+    getInfo(index, info);
+
+    // Comparaison après arrondi dans le type du champ (cf. store())
+    float def = info.defaultValue;
+    if (info.type != SettingType::FLOAT) def = (uint32_t)(def + 0.5);
+    return get(index) == def;
+  }
+
+  /**
+   * @brief Vérifie si un paramètre est entier
+   * @param index Index dans SETTINGS_TABLE
+   * @return true si U16/U32
+   */
+  bool isInteger(uint8_t index) const {
+    return pgm_read_byte(&SETTINGS_TABLE[index].type) != (uint8_t)SettingType::FLOAT;
+  }
+
+  /**
+   * @brief Vérifie si une calibration MPU6050 est enregistrée
+   * @return true si offsets non nuls
+   */
+  bool hasLevelCalibration() const {
+    return values.levelRollOffset != 0.0 || values.levelPitchOffset != 0.0;
+  }
+};
+
+/// Paramètres globaux
+Settings settings;
+
+#endif // SETTINGS_H
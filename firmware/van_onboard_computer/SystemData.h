@@ -11,6 +11,27 @@
  * - Structures de données consolidées
  * - Niveaux d'alerte et types d'alertes
  * - État global du système
+ *
+ * Empreinte mémoire (ATmega2560, 8 Ko de SRAM) :
+ * - Mesures en entiers 16 bits à l'échelle fixe (Fixed16), converties
+ *   en float à la lecture : 2 octets au lieu de 4
+ * - Horodatages relatifs 16 bits (Timestamp16, pas de 256 ms)
+ * - Drapeaux de validité en champs de bits, énumérations sur 8 bits
+ * - Alertes sans pointeur de message (alertMessage() en PROGMEM)
+ *
+ * | Structure       | Avant | Après |
+ * |-----------------|-------|-------|
+ * | EnvironmentData |    32 |    15 |
+ * | PowerData       |    38 |    19 |
+ * | SafetyData      |    29 |    13 |
+ * | LevelData       |    34 |    17 |
+ * | Alert           |    19 |     9 |
+ * | AlertState      |   201 |    94 |
+ * | SensorStatus    |    11 |     2 |
+ * | SystemState     |   366 |   176 |
+ *
+ * Les tailles réelles sont affichées au démarrage et vérifiées à la
+ * compilation (SYSTEM_STATE_MAX_SIZE).
  */
 
 #ifndef SYSTEM_DATA_H
@@ -27,7 +48,7 @@
  * @enum SystemMode
  * @brief Mode de fonctionnement du système
  */
-enum class SystemMode {
+enum class SystemMode : uint8_t {
   MODE_PREHEAT,     ///< Pré-chauffage capteurs MQ (3 min)
   MODE_NORMAL,      ///< Fonctionnement normal
   MODE_SETTINGS,    ///< Menu paramètres (appui long encodeur)
@@ -38,7 +59,7 @@ enum class SystemMode {
  * @enum Screen
  * @brief Écrans disponibles dans l'interface
  */
-enum class Screen {
+enum class Screen : uint8_t {
   SCREEN_HOME,        ///< Écran accueil (températures + tensions + horizontalité)
   SCREEN_ENVIRONMENT, ///< Détails environnement (temp/humidité/pression/point de rosée)
   SCREEN_ENERGY,      ///< Détails énergie (12V/5V détaillés, courants, puissance)
@@ -55,7 +76,7 @@ enum class Screen {
  * @enum AlertLevel
  * @brief Niveau de gravité d'une alerte
  */
-enum class AlertLevel {
+enum class AlertLevel : uint8_t {
   NONE = 0,         ///< Aucune alerte
   INFO = 1,         ///< Information (icône uniquement)
   WARNING = 2,      ///< Avertissement (icône + bip lent)
@@ -67,7 +88,7 @@ enum class AlertLevel {
  * @enum AlertType
  * @brief Type d'alerte détecté
  */
-enum class AlertType {
+enum class AlertType : uint8_t {
   NONE,             ///< Aucune alerte
   CO_HIGH,          ///< CO élevé
   GPL_HIGH,         ///< GPL élevé
@@ -81,9 +102,79 @@ enum class AlertType {
   TEMP_HIGH,        ///< Température élevée
   TEMP_LOW,         ///< Température basse
   HUMIDITY_HIGH,    ///< Humidité élevée
-  TILT_HIGH         ///< Inclinaison importante
+  TILT_HIGH,        ///< Inclinaison importante
+  GAS_SENSOR_FAULT  ///< Capteur gaz hors service (lectures ratées)
 };
 
+// ============================================
+// TYPES COMPACTS
+// ============================================
+#define SYSTEM_STATE_MAX_SIZE   192     ///< Budget SRAM de SystemState (octets)
+#define ALERT_MAX_COUNT         10      ///< Alertes simultanées
+#define TIMESTAMP16_SHIFT       8       ///< Pas de 256 ms, bouclage après ~4,6 h
+
+/**
+ * @brief Met une valeur à l'échelle en int16 (arrondie, saturée)
+ * @param value Valeur physique
+ * @param factor Facteur d'échelle
+ * @return Valeur entière, 0 si NaN
+ */
+inline int16_t toFixed16(float value, float factor) {
+  if (isnan(value)) return 0;
+  float scaled = value * factor;
+  if (scaled > 32767.0) return 32767;
+  if (scaled < -32768.0) return -32768;
+  return (int16_t)(scaled + (scaled >= 0 ? 0.5 : -0.5));
+}
+
+/**
+ * @struct Fixed16
+ * @brief Mesure stockée en int16 à l'échelle SCALE
+ *
+ * @details S'affecte et se lit comme un float (conversion implicite).
+ * Caster en (float) pour les fonctions variadiques (printf).
+ * @tparam SCALE Unités par unité physique (100 = centièmes)
+ */
+template<int16_t SCALE>
+struct Fixed16 {
+  int16_t raw;              ///< Valeur × SCALE
+
+  Fixed16& operator=(float value) {
+    raw = toFixed16(value, SCALE);
+    return *this;
+  }
+
+  operator float() const {
+    return (float)raw / SCALE;
+  }
+};
+
+/**
+ * @brief Horodatage relatif 16 bits (millis() >> TIMESTAMP16_SHIFT)
+ *
+ * @details Les âges sont exacts tant qu'ils restent inférieurs à la
+ * période de bouclage (65536 pas).
+ */
+typedef uint16_t Timestamp16;
+
+/**
+ * @brief Convertit un instant millis() en horodatage 16 bits
+ * @param ms Instant en millisecondes
+ * @return Horodatage compact
+ */
+inline Timestamp16 toTimestamp16(unsigned long ms) {
+  return (Timestamp16)(ms >> TIMESTAMP16_SHIFT);
+}
+
+/**
+ * @brief Âge d'un horodatage 16 bits
+ * @param stamp Horodatage
+ * @return Temps écoulé en millisecondes
+ */
+inline unsigned long timestamp16Age(Timestamp16 stamp) {
+  return (unsigned long)(Timestamp16)(toTimestamp16(millis()) - stamp) << TIMESTAMP16_SHIFT;
+}
+
 // ============================================
 // STRUCTURES - DONNÉES CAPTEURS
 // ============================================
@@ -94,23 +185,23 @@ enum class AlertType {
  */
 struct EnvironmentData {
   // Températures
-  float tempInterior;       ///< Température intérieure (°C) - BME280
-  float tempExterior;       ///< Température extérieure (°C) - DS18B20
+  Fixed16<100> tempInterior;    ///< Température intérieure (°C) - BME280
+  Fixed16<100> tempExterior;    ///< Température extérieure (°C) - DS18B20
   
   // Humidité et pression
-  float humidity;           ///< Humidité relative (%) - BME280
-  float pressure;           ///< Pression atmosphérique (hPa) - BME280
-  float dewPoint;           ///< Point de rosée calculé (°C)
+  Fixed16<100> humidity;        ///< Humidité relative (%) - BME280
+  Fixed16<10> pressure;         ///< Pression atmosphérique (hPa) - BME280
+  Fixed16<100> dewPoint;        ///< Point de rosée calculé (°C)
   
   // Timestamps
-  unsigned long tempIntTimestamp;
-  unsigned long tempExtTimestamp;
+  Timestamp16 tempIntTimestamp;
+  Timestamp16 tempExtTimestamp;
   
   // Validité
-  bool tempIntValid;
-  bool tempExtValid;
-  bool humidityValid;
-  bool pressureValid;
+  bool tempIntValid : 1;
+  bool tempExtValid : 1;
+  bool humidityValid : 1;
+  bool pressureValid : 1;
 };
 
 /**
@@ -119,25 +210,25 @@ struct EnvironmentData {
  */
 struct PowerData {
   // Rail 12V
-  float voltage12V;         ///< Tension 12V (V)
-  float current12V;         ///< Courant 12V (A)
-  float power12V;           ///< Puissance 12V (W)
+  Fixed16<1000> voltage12V;     ///< Tension 12V (V, pas 1 mV)
+  Fixed16<100> current12V;      ///< Courant 12V (A, pas 10 mA, jusqu'à 40 A)
+  Fixed16<10> power12V;         ///< Puissance 12V (W)
   
   // Rail 5V
-  float voltage5V;          ///< Tension 5V (V)
-  float current5V;          ///< Courant 5V (A)
-  float power5V;            ///< Puissance 5V (W)
+  Fixed16<1000> voltage5V;      ///< Tension 5V (V, pas 1 mV)
+  Fixed16<1000> current5V;      ///< Courant 5V (A, pas 1 mA)
+  Fixed16<100> power5V;         ///< Puissance 5V (W)
   
   // Puissance totale
-  float powerTotal;         ///< Puissance totale (W)
+  Fixed16<10> powerTotal;       ///< Puissance totale (W)
   
   // Timestamps
-  unsigned long voltage12VTimestamp;
-  unsigned long voltage5VTimestamp;
+  Timestamp16 voltage12VTimestamp;
+  Timestamp16 voltage5VTimestamp;
   
   // Validité
-  bool voltage12VValid;
-  bool voltage5VValid;
+  bool voltage12VValid : 1;
+  bool voltage5VValid : 1;
 };
 
 /**
@@ -146,23 +237,28 @@ struct PowerData {
  */
 struct SafetyData {
   // Concentrations en ppm
-  float coPPM;              ///< Monoxyde de carbone (ppm) - MQ7
-  float gplPPM;             ///< GPL/Méthane (ppm) - MQ2
-  float smokePPM;           ///< Fumée (ppm) - MQ2
+  Fixed16<1> coPPM;             ///< Monoxyde de carbone (ppm) - MQ7
+  Fixed16<1> gplPPM;            ///< GPL/Méthane (ppm) - MQ2
+  Fixed16<1> smokePPM;          ///< Fumée (ppm) - MQ2
   
   // Timestamps
-  unsigned long coTimestamp;
-  unsigned long gplTimestamp;
-  unsigned long smokeTimestamp;
+  Timestamp16 coTimestamp;
+  Timestamp16 gplTimestamp;
+  Timestamp16 smokeTimestamp;
+  uint8_t sampleSeq;            ///< Tentatives de lecture MQ7/MQ2 (rebouclant, watchdog)
   
   // Validité
-  bool coValid;
-  bool gplValid;
-  bool smokeValid;
+  bool coValid : 1;
+  bool gplValid : 1;
+  bool smokeValid : 1;
   
   // État pré-chauffage
-  bool mq7Preheated;
-  bool mq2Preheated;
+  bool mq7Preheated : 1;
+  bool mq2Preheated : 1;
+  
+  // Lectures ratées répétées (GAS_MAX_READ_FAILURES)
+  bool mq7Fault : 1;
+  bool mq2Fault : 1;
 };
 
 /**
@@ -171,26 +267,26 @@ struct SafetyData {
  */
 struct LevelData {
   // Angles calibrés
-  float roll;               ///< Angle Roll (°) - inclinaison latérale
-  float pitch;              ///< Angle Pitch (°) - inclinaison avant/arrière
-  float yaw;                ///< Angle Yaw (°) - rotation
+  Fixed16<100> roll;            ///< Angle Roll (°) - inclinaison latérale
+  Fixed16<100> pitch;           ///< Angle Pitch (°) - inclinaison avant/arrière
+  Fixed16<100> yaw;             ///< Angle Yaw (°) - rotation
   
   // Angles bruts (avant calibration)
-  float rawRoll;
-  float rawPitch;
+  Fixed16<100> rawRoll;
+  Fixed16<100> rawPitch;
   
   // Inclinaison totale
-  float totalTilt;          ///< Magnitude inclinaison (°)
+  Fixed16<100> totalTilt;       ///< Magnitude inclinaison (°)
   
   // Température du capteur
-  float temperature;        ///< Température MPU6050 (°C)
+  Fixed16<100> temperature;     ///< Température MPU6050 (°C)
   
   // Timestamp
-  unsigned long timestamp;
+  Timestamp16 timestamp;
   
   // Validité
-  bool valid;
-  bool calibrated;
+  bool valid : 1;
+  bool calibrated : 1;
 };
 
 // ============================================
@@ -200,15 +296,18 @@ struct LevelData {
 /**
  * @struct Alert
  * @brief Structure d'une alerte active
+ *
+ * @details Valeur et seuil sont à l'échelle alertScale(type) :
+ * les lire par alertValue() / alertThreshold(). Le message est
+ * déduit du type et du niveau (alertMessage()).
  */
 struct Alert {
   AlertType type;           ///< Type d'alerte
   AlertLevel level;         ///< Niveau de gravité
-  float value;              ///< Valeur ayant déclenché l'alerte
-  float threshold;          ///< Seuil déclenché
-  unsigned long timestamp;  ///< Moment déclenchement (millis)
   bool active;              ///< Alerte active ou non
-  const char* message;      ///< Message descriptif
+  Timestamp16 timestamp;    ///< Moment déclenchement
+  int16_t value;            ///< Valeur ayant déclenché l'alerte (× alertScale)
+  int16_t threshold;        ///< Seuil déclenché (× alertScale)
 };
 
 /**
@@ -219,10 +318,9 @@ struct AlertState {
   AlertLevel currentLevel;      ///< Niveau le plus élevé actif
   AlertType primaryAlert;       ///< Alerte prioritaire
   uint8_t activeAlertCount;     ///< Nombre d'alertes actives
-  Alert alerts[10];             ///< Tableau des alertes (max 10)
-  bool buzzerActive;            ///< Buzzer activé ou non
-  bool blockNavigation;         ///< Navigation bloquée (DANGER/CRITICAL)
-  unsigned long lastBuzzerToggle; ///< Pour gestion bips
+  Alert alerts[ALERT_MAX_COUNT]; ///< Tableau des alertes
+  bool buzzerActive : 1;        ///< Buzzer activé ou non
+  bool blockNavigation : 1;     ///< Navigation bloquée (DANGER/CRITICAL)
 };
 
 // ============================================
@@ -234,17 +332,17 @@ struct AlertState {
  * @brief État des capteurs
  */
 struct SensorStatus {
-  bool bme280;              ///< BME280 disponible
-  bool ds18b20;             ///< DS18B20 disponible
-  bool mpu6050;             ///< MPU6050 disponible
-  bool mq7;                 ///< MQ7 disponible
-  bool mq2;                 ///< MQ2 disponible
-  bool ina226_12v;          ///< INA226 12V disponible
-  bool ina226_5v;           ///< INA226 5V disponible
-  bool lcd;                 ///< LCD disponible
-  bool encoder;             ///< Encodeur disponible
-  bool leds;                ///< LEDs WS2812B disponibles
-  bool buzzer;              ///< Buzzer disponible
+  bool bme280 : 1;          ///< BME280 disponible
+  bool ds18b20 : 1;         ///< DS18B20 disponible
+  bool mpu6050 : 1;         ///< MPU6050 disponible
+  bool mq7 : 1;             ///< MQ7 disponible
+  bool mq2 : 1;             ///< MQ2 disponible
+  bool ina226_12v : 1;      ///< INA226 12V disponible
+  bool ina226_5v : 1;       ///< INA226 5V disponible
+  bool lcd : 1;             ///< LCD disponible
+  bool encoder : 1;         ///< Encodeur disponible
+  bool leds : 1;            ///< LEDs WS2812B disponibles
+  bool buzzer : 1;          ///< Buzzer disponible
 };
 
 /**
@@ -275,11 +373,16 @@ struct SystemState {
   unsigned long uptime;               ///< Temps depuis démarrage (s)
   
   // Flags
-  bool initialized;             ///< Système initialisé
-  bool backlightOn;             ///< Rétro-éclairage LCD actif
-  bool calibrationMode;         ///< Mode calibration MPU6050
+  bool initialized : 1;         ///< Système initialisé
+  bool backlightOn : 1;         ///< Rétro-éclairage LCD actif
+  bool calibrationMode : 1;     ///< Mode calibration MPU6050
 };
 
+#if defined(__AVR__)
+static_assert(sizeof(SystemState) <= SYSTEM_STATE_MAX_SIZE,
+              "SystemState depasse son budget SRAM");
+#endif
+
 // ============================================
 // FONCTIONS UTILITAIRES - CONVERSIONS
 // ============================================
@@ -321,10 +424,103 @@ inline const char* alertTypeToShortString(AlertType type) {
     case AlertType::TEMP_LOW:         return "TEMP BASSE";
     case AlertType::HUMIDITY_HIGH:    return "HUMID HAUTE";
     case AlertType::TILT_HIGH:        return "INCLINAISON";
+    case AlertType::GAS_SENSOR_FAULT: return "CAPTEUR GAZ";
     default:                          return "INCONNU";
   }
 }
 
+/**
+ * @brief Échelle de stockage de la valeur et du seuil d'une alerte
+ * @param type Type d'alerte
+ * @return Facteur d'échelle (gaz : 1, électrique : 100, autres : 10)
+ */
+inline float alertScale(AlertType type) {
+  switch (type) {
+    case AlertType::CO_HIGH:
+    case AlertType::GPL_HIGH:
+    case AlertType::SMOKE_HIGH:
+    case AlertType::GAS_SENSOR_FAULT: return 1.0;
+    case AlertType::VOLTAGE_12V_LOW:
+    case AlertType::VOLTAGE_12V_HIGH:
+    case AlertType::VOLTAGE_5V_LOW:
+    case AlertType::VOLTAGE_5V_HIGH:
+    case AlertType::CURRENT_12V_HIGH:
+    case AlertType::CURRENT_5V_HIGH:  return 100.0;
+    default:                          return 10.0;
+  }
+}
+
+/**
+ * @brief Décimales de la valeur stockée d'une alerte (log10 de alertScale())
+ * @param type Type d'alerte
+ * @return 0, 1 ou 2 (pour FixedFormat)
+ */
+inline uint8_t alertDecimals(AlertType type) {
+  switch (type) {
+    case AlertType::CO_HIGH:
+    case AlertType::GPL_HIGH:
+    case AlertType::SMOKE_HIGH:
+    case AlertType::GAS_SENSOR_FAULT: return 0;
+    case AlertType::VOLTAGE_12V_LOW:
+    case AlertType::VOLTAGE_12V_HIGH:
+    case AlertType::VOLTAGE_5V_LOW:
+    case AlertType::VOLTAGE_5V_HIGH:
+    case AlertType::CURRENT_12V_HIGH:
+    case AlertType::CURRENT_5V_HIGH:  return 2;
+    default:                          return 1;
+  }
+}
+
+/**
+ * @brief Valeur ayant déclenché une alerte
+ * @param alert Alerte
+ * @return Valeur physique
+ */
+inline float alertValue(const Alert& alert) {
+  return alert.value / alertScale(alert.type);
+}
+
+/**
+ * @brief Seuil franchi par une alerte
+ * @param alert Alerte
+ * @return Seuil physique
+ */
+inline float alertThreshold(const Alert& alert) {
+  return alert.threshold / alertScale(alert.type);
+}
+
+/**
+ * @brief Message descriptif d'une alerte (PROGMEM)
+ * @param alert Alerte
+ * @return Message selon le type et le niveau
+ */
+inline const __FlashStringHelper* alertMessage(const Alert& alert) {
+  bool severe = alert.level >= AlertLevel::DANGER;
+  bool warning = alert.level == AlertLevel::WARNING;
+
+  switch (alert.type) {
+    case AlertType::CO_HIGH:
+      return severe ? F("CO CRITIQUE!") : warning ? F("CO eleve") : F("CO detecte");
+    case AlertType::GPL_HIGH:
+      return severe ? F("GPL CRITIQUE!") : warning ? F("GPL eleve") : F("GPL detecte");
+    case AlertType::SMOKE_HIGH:
+      return severe ? F("FUMEE DANGER!") : warning ? F("Fumee detectee") : F("Fumee legere");
+    case AlertType::VOLTAGE_12V_LOW:
+      return severe ? F("BATTERIE CRITIQUE!") : F("Batterie faible");
+    case AlertType::VOLTAGE_12V_HIGH: return F("Surtension 12V");
+    case AlertType::VOLTAGE_5V_LOW:   return F("5V CRITIQUE!");
+    case AlertType::VOLTAGE_5V_HIGH:  return F("Surtension 5V");
+    case AlertType::CURRENT_12V_HIGH: return F("Surintensite 12V");
+    case AlertType::CURRENT_5V_HIGH:  return F("Surintensite 5V");
+    case AlertType::TEMP_HIGH:        return F("Temp elevee");
+    case AlertType::TEMP_LOW:         return F("Temp basse");
+    case AlertType::HUMIDITY_HIGH:    return F("Humidite haute");
+    case AlertType::TILT_HIGH:        return F("Inclinaison");
+    case AlertType::GAS_SENSOR_FAULT: return F("Capteur gaz HS");
+    default:                          return F("");
+  }
+}
+
 /**
  * @brief Convertit un mode système en texte
  * @param mode Mode système
@@ -442,6 +638,9 @@ inline void initSystemState(SystemState& state) {
   state.safety.smokeValid = false;
   state.safety.mq7Preheated = false;
   state.safety.mq2Preheated = false;
+  state.safety.mq7Fault = false;
+  state.safety.mq2Fault = false;
+  state.safety.sampleSeq = 0;
   
   // Horizontalité
   state.level.roll = 0.0;
@@ -460,10 +659,9 @@ inline void initSystemState(SystemState& state) {
   state.alerts.activeAlertCount = 0;
   state.alerts.buzzerActive = false;
   state.alerts.blockNavigation = false;
-  state.alerts.lastBuzzerToggle = 0;
   
   // Initialiser tableau alertes
-  for (uint8_t i = 0; i < 10; i++) {
+  for (uint8_t i = 0; i < ALERT_MAX_COUNT; i++) {
     state.alerts.alerts[i].active = false;
     state.alerts.alerts[i].type = AlertType::NONE;
     state.alerts.alerts[i].level = AlertLevel::NONE;
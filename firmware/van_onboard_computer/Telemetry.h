@@ -0,0 +1,313 @@
+/**
+ * @file Telemetry.h
+ * @brief Flux de télémétrie binaire sur le port série de debug
+ * @author Frédéric BAILLON
+ * @version 0.1.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Remplace displayStats() quand USE_SERIAL_TELEMETRY est actif :
+ * - Instantané compact de SystemState + compteurs de profilage de loop()
+ * - Trame : [0xA5][0x5A][version][longueur][instantané][CRC16 LSB][CRC16 MSB]
+ * - Trame construite en une fois dans un tampon statique, puis vidée
+ *   par morceaux selon Serial.availableForWrite() : aucune attente
+ *
+ * Le texte de debug peut être entrelacé : le décodeur hôte
+ * (tools/scripts/telemetry_decoder.py) resynchronise sur l'en-tête
+ * et valide chaque trame par CRC.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "SystemData.h"
+#include "DashboardProtocol.h"
+
+// ============================================
+// CONFIGURATION
+// ============================================
+#define TELEMETRY_SYNC_1        0xA5    ///< Premier octet d'en-tête
+#define TELEMETRY_SYNC_2        0x5A    ///< Second octet d'en-tête
+#define TELEMETRY_VERSION       1       ///< Version du format d'instantané
+#define TELEMETRY_MAX_ALERTS    4       ///< Types d'alertes transmis
+
+// ============================================
+// TYPES ET STRUCTURES
+// ============================================
+/**
+ * @struct TelemetrySnapshot
+ * @brief Instantané transmis (little-endian, sans bourrage)
+ *
+ * @note Toute modification impose d'incrémenter TELEMETRY_VERSION
+ *       et de mettre à jour SNAPSHOT_FORMAT dans telemetry_decoder.py
+ */
+struct __attribute__((packed)) TelemetrySnapshot {
+  // Système
+  uint32_t uptime;            ///< Secondes depuis démarrage
+  uint8_t mode;               ///< SystemMode
+  uint8_t screen;             ///< Screen
+  uint16_t flags;             ///< Bits de validité (DASH_FLAG_*)
+
+  // Environnement
+  int16_t tempInterior;       ///< °C x10
+  int16_t tempExterior;       ///< °C x10
+  int16_t humidity;           ///< % x10
+  int16_t pressure;           ///< hPa x10
+
+  // Énergie
+  int16_t voltage12V;         ///< V x100
+  int16_t current12V;         ///< A x100
+  int16_t power12V;           ///< W x10
+  int16_t voltage5V;          ///< V x100
+  int16_t current5V;          ///< mA
+  int16_t power5V;            ///< W x100
+  int16_t powerTotal;         ///< W x10
+
+  // Sécurité
+  int16_t coPPM;              ///< ppm
+  int16_t gplPPM;             ///< ppm
+  int16_t smokePPM;           ///< ppm
+
+  // Horizontalité
+  int16_t roll;               ///< ° x10
+  int16_t pitch;              ///< ° x10
+  int16_t totalTilt;          ///< ° x10
+
+  // Alertes
+  uint8_t alertLevel;         ///< AlertLevel
+  uint8_t alertCount;         ///< Alertes actives
+  uint8_t alertTypes[TELEMETRY_MAX_ALERTS];  ///< AlertType des premières alertes
+
+  // Profilage (depuis l'instantané précédent)
+  uint32_t loopCount;         ///< Itérations de loop() depuis le démarrage
+  uint32_t loopAvgUs;         ///< Durée moyenne de loop() (µs)
+  uint32_t loopMaxUs;         ///< Durée max de loop() (µs)
+  uint16_t slowLoops;         ///< Itérations > 100 ms
+  uint16_t freeRam;           ///< RAM libre (octets)
+  uint16_t ledShowsPerMin;    ///< FastLED.show() par minute
+  uint16_t droppedSnapshots;  ///< Instantanés abandonnés (tampon occupé)
+};
+
+/**
+ * @struct TelemetryCounters
+ * @brief Compteurs fournis par le programme principal à chaque instantané
+ */
+struct TelemetryCounters {
+  uint16_t freeRam;           ///< RAM libre (octets)
+  uint16_t ledShowsPerMin;    ///< FastLED.show() par minute
+};
+
+#define TELEMETRY_FRAME_SIZE    (4 + sizeof(TelemetrySnapshot) + 2)
+
+// ============================================
+// CLASSE Telemetry
+// ============================================
+/**
+ * @class Telemetry
+ * @brief Émetteur de la télémétrie binaire
+ */
+class Telemetry {
+private:
+  // Référence à l'état système
+  SystemState& state;
+
+  // Port série
+  Print& port;
+
+  // Tampon d'émission
+  uint8_t frame[TELEMETRY_FRAME_SIZE];  ///< Trame en cours d'émission
+  uint8_t frameSent;                    ///< Octets déjà écrits
+  uint8_t frameLength;                  ///< Longueur de la trame (0 = aucune)
+
+  // Profilage
+  uint32_t loopCount;
+  uint32_t loopSumUs;
+  uint16_t loopSamples;
+  uint32_t loopMaxUs;
+  uint16_t slowLoops;
+  uint16_t droppedSnapshots;
+
+  /**
+   * @brief Met une valeur à l'échelle en int16 (saturée)
+   */
+  static int16_t scale(float value, float factor) {
+    float scaled = value * factor;
+    if (scaled > 32767.0) return 32767;
+    if (scaled < -32768.0) return -32768;
+    return (int16_t)(scaled + (scaled >= 0 ? 0.5 : -0.5));
+  }
+
+  /**
+   * @brief Remplit l'instantané à partir de l'état système
+   * @param snap [out] Instantané
+   * @param counters Compteurs du programme principal
+   */
+  void fillSnapshot(TelemetrySnapshot& snap, const TelemetryCounters& counters) {
+    snap.uptime = state.uptime;
+    snap.mode = (uint8_t)state.mode;
+    snap.screen = (uint8_t)state.currentScreen;
+
+    uint16_t flags = 0;
+    if (state.environment.tempIntValid)  flags |= DASH_FLAG_TEMP_INT;
+    if (state.environment.tempExtValid)  flags |= DASH_FLAG_TEMP_EXT;
+    if (state.environment.humidityValid) flags |= DASH_FLAG_HUMIDITY;
+    if (state.environment.pressureValid) flags |= DASH_FLAG_PRESSURE;
+    if (state.power.voltage12VValid)     flags |= DASH_FLAG_12V;
+    if (state.power.voltage5VValid)      flags |= DASH_FLAG_5V;
+    if (state.safety.mq7Preheated)       flags |= DASH_FLAG_MQ7_READY;
+    if (state.safety.mq2Preheated)       flags |= DASH_FLAG_MQ2_READY;
+    if (state.level.valid)               flags |= DASH_FLAG_LEVEL;
+    snap.flags = flags;
+
+    snap.tempInterior = scale(state.environment.tempInterior, 10);
+    snap.tempExterior = scale(state.environment.tempExterior, 10);
+    snap.humidity     = scale(state.environment.humidity, 10);
+    snap.pressure     = scale(state.environment.pressure, 10);
+
+    snap.voltage12V = scale(state.power.voltage12V, 100);
+    snap.current12V = scale(state.power.current12V, 100);
+    snap.power12V   = scale(state.power.power12V, 10);
+    snap.voltage5V  = scale(state.power.voltage5V, 100);
+    snap.current5V  = scale(state.power.current5V, 1000);
+    snap.power5V    = scale(state.power.power5V, 100);
+    snap.powerTotal = scale(state.power.powerTotal, 10);
+
+    snap.coPPM    = scale(state.safety.coPPM, 1);
+    snap.gplPPM   = scale(state.safety.gplPPM, 1);
+    snap.smokePPM = scale(state.safety.smokePPM, 1);
+
+    snap.roll      = scale(state.level.roll, 10);
+    snap.pitch     = scale(state.level.pitch, 10);
+    snap.totalTilt = scale(state.level.totalTilt, 10);
+
+    snap.alertLevel = (uint8_t)state.alerts.currentLevel;
+    snap.alertCount = state.alerts.activeAlertCount;
+    for (uint8_t i = 0; i < TELEMETRY_MAX_ALERTS; i++) {
+      snap.alertTypes[i] = (i < state.alerts.activeAlertCount) ?
+                           (uint8_t)state.alerts.alerts[i].type : 0;
+    }
+
+    snap.loopCount = loopCount;
+    snap.loopAvgUs = loopSamples ? loopSumUs / loopSamples : 0;
+    snap.loopMaxUs = loopMaxUs;
+    snap.slowLoops = slowLoops;
+    snap.freeRam = counters.freeRam;
+    snap.ledShowsPerMin = counters.ledShowsPerMin;
+    snap.droppedSnapshots = droppedSnapshots;
+  }
+
+public:
+  /**
+   * @brief Constructeur
+   * @param sysState Référence à l'état système
+   * @param output Port de sortie (Serial)
+   */
+  Telemetry(SystemState& sysState, Print& output)
+    : state(sysState),
+      port(output),
+      frameSent(0),
+      frameLength(0),
+      loopCount(0),
+      loopSumUs(0),
+      loopSamples(0),
+      loopMaxUs(0),
+      slowLoops(0),
+      droppedSnapshots(0)
+  {
+  }
+
+  // ============================================
+  // PROFILAGE
+  // ============================================
+
+  /**
+   * @brief Enregistre la durée d'une itération de loop()
+   * @param durationUs Durée (µs)
+   */
+  void recordLoop(uint32_t durationUs) {
+    loopCount++;
+    if (loopSamples < 0xFFFF) {
+      loopSumUs += durationUs;
+      loopSamples++;
+    }
+    if (durationUs > loopMaxUs) loopMaxUs = durationUs;
+    if (durationUs > 100000UL) slowLoops++;
+  }
+
+  // ============================================
+  // ÉMISSION
+  // ============================================
+
+  /**
+   * @brief Construit un instantané et le place en file d'émission
+   * @param counters Compteurs du programme principal
+   * @return false si la trame précédente n'est pas encore émise
+   */
+  bool send(const TelemetryCounters& counters) {
+    if (frameLength != 0) {
+      droppedSnapshots++;
+      return false;
+    }
+
+    TelemetrySnapshot snap;
+    fillSnapshot(snap, counters);
+
+    frame[0] = TELEMETRY_SYNC_1;
+    frame[1] = TELEMETRY_SYNC_2;
+    frame[2] = TELEMETRY_VERSION;
+    frame[3] = sizeof(TelemetrySnapshot);
+    memcpy(&frame[4], &snap, sizeof(TelemetrySnapshot));
+
+    uint16_t crc = dashCrc16(&frame[2], 2 + sizeof(TelemetrySnapshot));
+    frame[4 + sizeof(TelemetrySnapshot)] = crc & 0xFF;
+    frame[5 + sizeof(TelemetrySnapshot)] = crc >> 8;
+
+    frameSent = 0;
+    frameLength = TELEMETRY_FRAME_SIZE;
+
+    // Nouvelle fenêtre de profilage
+    loopSumUs = 0;
+    loopSamples = 0;
+    loopMaxUs = 0;
+    slowLoops = 0;
+
+    update();
+    return true;
+  }
+
+  /**
+   * @brief Vide la trame en cours sans bloquer
+   *
+   * @details À appeler à chaque loop() : n'écrit que ce que le
+   * tampon TX matériel peut accepter immédiatement.
+   */
+  void update() {
+    if (frameLength == 0) return;
+
+    int room = port.availableForWrite();
+    if (room <= 0) return;
+
+    uint8_t chunk = frameLength - frameSent;
+    if (chunk > room) chunk = room;
+
+    port.write(&frame[frameSent], chunk);
+    frameSent += chunk;
+
+    if (frameSent >= frameLength) {
+      frameLength = 0;
+      frameSent = 0;
+    }
+  }
+
+  /**
+   * @brief Vérifie si une trame est en cours d'émission
+   * @return true si des octets restent à émettre
+   */
+  bool isBusy() const {
+    return frameLength != 0;
+  }
+};
+
+#endif // TELEMETRY_H
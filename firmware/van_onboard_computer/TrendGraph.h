@@ -0,0 +1,205 @@
+/**
+ * @file TrendGraph.h
+ * @brief Historique des mesures et courbes de tendance sur le LCD 20x4
+ * @author Frédéric BAILLON
+ * @version 0.1.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Les écrans n'affichent que la valeur courante : impossible de voir
+ * si la batterie se vide ou si l'humidité monte.
+ *
+ * TrendHistory conserve TREND_SAMPLES échantillons par série, un toutes
+ * les TREND_SAMPLE_INTERVAL ms (valeur brute Fixed16, TREND_NO_SAMPLE
+ * si la mesure était invalide). Échantillonnage indépendant de
+ * l'affichage : il continue écran en veille.
+ *
+ * TrendGraph dessine une série dans l'image (LCDFramebuffer), une
+ * cellule par échantillon, le plus récent à droite. Chaque cellule est
+ * une barre verticale à 8 niveaux :
+ * - niveaux 1 à 7 : motifs GlyphId::BAR_1..BAR_7 (GlyphCache.h)
+ * - niveau 8 : bloc plein de la ROM HD44780 (0xFF), sans CGRAM
+ * Échelle automatique sur les échantillons affichés, étendue minimale
+ * par série (une variation de bruit ne remplit pas la hauteur).
+ *
+ * Seuls les niveaux présents occupent un emplacement CGRAM ; un motif
+ * n'est renvoyé que si son emplacement a été réattribué entre-temps.
+ *
+ * Mémoire : TREND_SAMPLES × 2 octets par série.
+ */
+
+#ifndef TREND_GRAPH_H
+#define TREND_GRAPH_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "SystemData.h"
+#include "LCDFramebuffer.h"
+
+// ============================================
+// CONFIGURATION
+// ============================================
+#define TREND_NO_SAMPLE         INT16_MIN   ///< Mesure invalide à l'échantillonnage
+#define TREND_LEVELS            8           ///< Hauteurs de barre par cellule
+#define TREND_FULL_BLOCK        ((char)0xFF) ///< Bloc plein (ROM HD44780 A00)
+
+// ============================================
+// TYPES ET STRUCTURES
+// ============================================
+/**
+ * @enum TrendSeries
+ * @brief Mesures historisées
+ */
+enum class TrendSeries : uint8_t {
+  VOLTAGE_12V,    ///< Tension batterie (écran ENERGY)
+  HUMIDITY,       ///< Humidité intérieure (écran ENVIRONMENT)
+  COUNT
+};
+
+// ============================================
+// CLASSE TrendHistory
+// ============================================
+/**
+ * @class TrendHistory
+ * @brief Tampon circulaire des derniers échantillons de chaque série
+ */
+class TrendHistory {
+private:
+  int16_t samples[(uint8_t)TrendSeries::COUNT][TREND_SAMPLES];
+  uint8_t head;                 ///< Prochain emplacement écrit
+  uint8_t count;                ///< Échantillons conservés
+  unsigned long lastSample;
+
+  /**
+   * @brief Valeur brute courante d'une série
+   */
+  static int16_t read(const SystemState& state, TrendSeries series) {
+    switch (series) {
+      case TrendSeries::VOLTAGE_12V:
+        return state.power.voltage12VValid ? state.power.voltage12V.raw : TREND_NO_SAMPLE;
+      case TrendSeries::HUMIDITY:
+        return state.environment.humidityValid ? state.environment.humidity.raw : TREND_NO_SAMPLE;
+      default:
+        return TREND_NO_SAMPLE;
+    }
+  }
+
+  /**
+   * @brief Enregistre un échantillon de chaque série
+   */
+  void record(const SystemState& state) {
+    for (uint8_t s = 0; s < (uint8_t)TrendSeries::COUNT; s++) {
+      samples[s][head] = read(state, (TrendSeries)s);
+    }
+    head = (head + 1) % TREND_SAMPLES;
+    if (count < TREND_SAMPLES) count++;
+  }
+
+public:
+  TrendHistory()
+    : head(0),
+      count(0),
+      lastSample(0)
+  {
+  }
+
+  /**
+   * @brief Échantillonne si l'intervalle est écoulé (non-bloquant)
+   * @param state État système
+   * @param now millis()
+   *
+   * @details Premier échantillon dès qu'une série est valide (pas
+   * d'écran vide pendant le premier intervalle).
+   */
+  void update(const SystemState& state, unsigned long now) {
+    if (count == 0) {
+      bool any = false;
+      for (uint8_t s = 0; s < (uint8_t)TrendSeries::COUNT; s++) {
+        any |= read(state, (TrendSeries)s) != TREND_NO_SAMPLE;
+      }
+      if (!any) return;
+    } else if (now - lastSample < TREND_SAMPLE_INTERVAL) {
+      return;
+    }
+    lastSample = now;
+    record(state);
+  }
+
+  /**
+   * @brief Échantillon d'une série
+   * @param series Série
+   * @param index 0 = plus ancien, getCount() - 1 = plus récent
+   * @return Valeur brute, TREND_NO_SAMPLE si invalide ou hors plage
+   */
+  int16_t get(TrendSeries series, uint8_t index) const {
+    if (index >= count) return TREND_NO_SAMPLE;
+    uint8_t slot = (head + TREND_SAMPLES - count + index) % TREND_SAMPLES;
+    return samples[(uint8_t)series][slot];
+  }
+
+  uint8_t getCount() const { return count; }
+};
+
+// ============================================
+// CLASSE TrendGraph
+// ============================================
+/**
+ * @class TrendGraph
+ * @brief Courbe d'une série en barres verticales (une ligne LCD)
+ */
+class TrendGraph {
+public:
+  /**
+   * @brief Dessine une série dans l'image
+   * @param fb Image de l'écran
+   * @param col Colonne de départ
+   * @param row Ligne
+   * @param width Nombre de cellules (échantillons affichés)
+   * @param history Historique
+   * @param series Série
+   * @param minSpan Étendue minimale de l'échelle (unités brutes)
+   *
+   * @details Cellules sans échantillon : espace.
+   */
+  static void draw(LCDFramebuffer& fb, uint8_t col, uint8_t row, uint8_t width,
+                   const TrendHistory& history, TrendSeries series, int16_t minSpan) {
+    uint8_t shown = history.getCount() < width ? history.getCount() : width;
+    uint8_t first = history.getCount() - shown;
+
+    // Échelle : min/max des échantillons affichés, étendue minimale centrée
+    int16_t low = INT16_MAX;
+    int16_t high = INT16_MIN;
+    for (uint8_t i = 0; i < shown; i++) {
+      int16_t value = history.get(series, first + i);
+      if (value == TREND_NO_SAMPLE) continue;
+      if (value < low) low = value;
+      if (value > high) high = value;
+    }
+    int32_t base = low;
+    int32_t span = (int32_t)high - low;
+    if (span < minSpan) {
+      base -= (minSpan - span) / 2;
+      span = minSpan;
+    }
+
+    // Cellules vides à gauche tant que l'historique est incomplet
+    fb.fill(col, row, width - shown);
+    col += width - shown;
+
+    for (uint8_t i = 0; i < shown; i++) {
+      int16_t value = history.get(series, first + i);
+      if (value == TREND_NO_SAMPLE || span <= 0) {
+        fb.put(col + i, row, ' ');
+        continue;
+      }
+      uint8_t level = 1 + ((value - base) * (TREND_LEVELS - 1) + span / 2) / span;
+      if (level >= TREND_LEVELS) {
+        fb.put(col + i, row, TREND_FULL_BLOCK);
+      } else {
+        fb.put(col + i, row, fb.glyph((GlyphId)((uint8_t)GlyphId::BAR_1 + level - 1)));
+      }
+    }
+  }
+};
+
+#endif // TREND_GRAPH_H
@@ -0,0 +1,340 @@
+/**
+ * @file Watchdog.h
+ * @brief Chien de garde matériel (WDT AVR) avec contrôle par tâche
+ * @author Frédéric BAILLON
+ * @version 0.1.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Le WDT n'est réarmé que si chaque tâche critique a progressé
+ * (checkIn()) dans son délai :
+ * - GAS    : une lecture MQ7/MQ2 a été tentée, réussie ou non
+ *   (SensorManager ; les échecs répétés mettent le capteur hors service)
+ * - ALERTS : une passe d'évaluation a traité la dernière tentative
+ *   gaz (AlertSystem::checkAlerts())
+ * Le buzzer n'est pas une tâche : il est séquencé par l'interruption
+ * Timer0, qui cadence aussi millis().
+ *
+ * Délai d'une tâche : intervalle MQ7/MQ2 le plus long du registre +
+ * WDT_DEADLINE_*. Au-delà, le WDT n'est plus réarmé et la carte
+ * redémarre WDT_TIMEOUT plus tard. Une tâche sans objet (aucun capteur
+ * gaz en service, ou tous hors service) n'est pas surveillée (setMonitored()). Un blocage
+ * complet de loop() est couvert par le WDT lui-même.
+ *
+ * Trace post-mortem en RAM .noinit (conservée au reset) :
+ * - Dernière étape de loop() commencée (mark())
+ * - Masque des tâches en retard, millis() au dernier passage
+ * - Nombre de resets watchdog
+ * MCUSR est lu en .init3, avant l'initialisation C et avant que le
+ * WDT encore actif ne relance la carte en boucle. Rapport au boot
+ * suivant par begin().
+ *
+ * Injection de fautes : console série, commande "wdt <tache>".
+ *
+ * @warning Nécessite un bootloader Mega qui désactive le WDT
+ * (stk500v2 livré depuis 2012) ; l'ancien bouclait au reset.
+ * @note Avec certains bootloaders MCUSR est déjà effacé : la cause
+ * affichée est alors « inconnue », la trace .noinit reste valable.
+ */
+
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+#include <Arduino.h>
+#include <avr/wdt.h>
+#include "config.h"
+#include "Settings.h"
+
+// ============================================
+// CONFIGURATION
+// ============================================
+#define WATCHDOG_MAGIC          0x5744  ///< "WD" : trace .noinit valide
+
+#if defined(__AVR__)
+  #define WATCHDOG_NOINIT       __attribute__((section(".noinit")))
+#else
+  #define WATCHDOG_NOINIT
+#endif
+
+// ============================================
+// TYPES ET STRUCTURES
+// ============================================
+/**
+ * @enum WatchdogTask
+ * @brief Tâches critiques surveillées (un bit chacune)
+ */
+enum class WatchdogTask : uint8_t {
+  GAS,        ///< Acquisition gaz
+  ALERTS,     ///< Évaluation des alertes
+  COUNT
+};
+
+/**
+ * @enum LoopStage
+ * @brief Étapes de loop() (fil d'Ariane)
+ */
+enum class LoopStage : uint8_t {
+  SETUP,
+  SENSORS,
+  HEALTH,
+  ALERTS,
+  LEDS,
+  DISPLAY,
+  DASHBOARD,
+  CALIBRATION,
+  CONSOLE,
+  STATS,
+  LOG,
+  IDLE
+};
+
+/**
+ * @struct WatchdogRecord
+ * @brief Trace conservée à travers un reset (.noinit)
+ */
+struct WatchdogRecord {
+  uint16_t magic;           ///< WATCHDOG_MAGIC si la trace est valide
+  uint8_t stage;            ///< Dernière étape commencée (LoopStage)
+  uint8_t overdue;          ///< Tâches en retard (masque) au refus de réarmement
+  uint32_t uptime;          ///< millis() au dernier passage dans update()
+  uint16_t resetCount;      ///< Resets watchdog depuis la mise sous tension
+};
+
+// ============================================
+// ZONE .noinit ET CAPTURE DE MCUSR
+// ============================================
+uint8_t watchdogMcusr WATCHDOG_NOINIT;          ///< MCUSR au démarrage
+WatchdogRecord watchdogRecord WATCHDOG_NOINIT;  ///< Trace post-mortem
+
+#if defined(__AVR__)
+/**
+ * @brief Lit puis efface MCUSR et coupe le WDT, avant main()
+ *
+ * @details WDRF doit être effacé pour pouvoir désactiver le WDT ; sans
+ * cela, il reste actif (15 ms) après un reset watchdog.
+ */
+void watchdogEarlyInit() __attribute__((naked, used, section(".init3")));
+void watchdogEarlyInit() {
+  watchdogMcusr = MCUSR;
+  MCUSR = 0;
+  wdt_disable();
+}
+#endif
+
+// ============================================
+// CLASSE Watchdog
+// ============================================
+/**
+ * @class Watchdog
+ * @brief Superviseur du WDT : réarmement conditionné aux tâches
+ */
+class Watchdog {
+private:
+  unsigned long lastCheckIn[(uint8_t)WatchdogTask::COUNT];
+  uint8_t injected;         ///< Tâches en panne simulée (masque)
+  uint8_t monitored;        ///< Tâches surveillées (masque)
+  uint8_t resetCause;       ///< Copie de MCUSR
+  bool running;
+
+  /**
+   * @brief Délai maximal entre deux signalements d'une tâche
+   */
+  static unsigned long deadline(uint8_t task) {
+    const RuntimeSettings& values = settings.values;
+    unsigned long gasInterval = max(values.intervalMQ7, values.intervalMQ2);
+
+    switch ((WatchdogTask)task) {
+      case WatchdogTask::GAS:    return gasInterval + WDT_DEADLINE_GAS;
+      case WatchdogTask::ALERTS: return gasInterval + WDT_DEADLINE_ALERTS;
+      default:                   return 0;
+    }
+  }
+
+public:
+  Watchdog()
+    : injected(0),
+      monitored((1 << (uint8_t)WatchdogTask::COUNT) - 1),
+      resetCause(0),
+      running(false)
+  {
+    memset(lastCheckIn, 0, sizeof(lastCheckIn));
+  }
+
+  // ============================================
+  // INITIALISATION
+  // ============================================
+
+  /**
+   * @brief Rapporte la cause du reset et arme le WDT
+   *
+   * @details À appeler en fin de setup() : l'initialisation (délais
+   * d'affichage, scan I2C) dépasse WDT_TIMEOUT.
+   */
+  void begin() {
+    resetCause = watchdogMcusr;
+
+    if (watchdogRecord.magic != WATCHDOG_MAGIC || (resetCause & _BV(PORF))) {
+      // Mise sous tension : .noinit aléatoire
+      memset(&watchdogRecord, 0, sizeof(watchdogRecord));
+      watchdogRecord.magic = WATCHDOG_MAGIC;
+    } else if (resetCause & _BV(WDRF)) {
+      watchdogRecord.resetCount++;
+      LOG_ERROR("Reset watchdog #%u: etape %S, taches en retard 0x%02X, apres %lu ms",
+                watchdogRecord.resetCount, stageName(watchdogRecord.stage),
+                watchdogRecord.overdue, (unsigned long)watchdogRecord.uptime);
+    }
+    LOG_INFO("Cause du reset: %S", causeName(resetCause));
+
+    watchdogRecord.stage = (uint8_t)LoopStage::SETUP;
+    watchdogRecord.overdue = 0;
+
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < (uint8_t)WatchdogTask::COUNT; i++) {
+      lastCheckIn[i] = now;
+    }
+
+    #if USE_WATCHDOG
+    wdt_enable(WDT_TIMEOUT);
+    running = true;
+    #endif
+  }
+
+  // ============================================
+  // SIGNALEMENTS
+  // ============================================
+
+  /**
+   * @brief Signale qu'une tâche critique a progressé
+   * @param task Tâche
+   */
+  void checkIn(WatchdogTask task) {
+    uint8_t bit = 1 << (uint8_t)task;
+    if (injected & bit) return;
+    lastCheckIn[(uint8_t)task] = millis();
+  }
+
+  /**
+   * @brief Active ou suspend la surveillance d'une tâche
+   * @param task Tâche
+   * @param active false si la tâche est sans objet (capteurs absents)
+   *
+   * @details À la reprise, le délai repart de maintenant.
+   */
+  void setMonitored(WatchdogTask task, bool active) {
+    uint8_t bit = 1 << (uint8_t)task;
+    if (active == ((monitored & bit) != 0)) return;
+
+    if (active) {
+      monitored |= bit;
+      lastCheckIn[(uint8_t)task] = millis();
+    } else {
+      monitored &= ~bit;
+    }
+  }
+
+  /**
+   * @brief Enregistre l'étape de loop() en cours (.noinit)
+   * @param stage Étape
+   */
+  void mark(LoopStage stage) {
+    watchdogRecord.stage = (uint8_t)stage;
+  }
+
+  /**
+   * @brief Réarme le WDT si toutes les tâches sont dans leur délai
+   *
+   * @details Appelé une fois par loop(). En cas de retard, le WDT
+   * n'est plus réarmé : le reset intervient WDT_TIMEOUT plus tard.
+   */
+  void update() {
+    unsigned long now = millis();
+    uint8_t overdue = 0;
+
+    for (uint8_t i = 0; i < (uint8_t)WatchdogTask::COUNT; i++) {
+      if (!(monitored & (1 << i))) continue;
+      if (now - lastCheckIn[i] > deadline(i)) {
+        overdue |= 1 << i;
+      }
+    }
+
+    watchdogRecord.uptime = now;
+
+    if (overdue) {
+      if (watchdogRecord.overdue != overdue) {
+        LOG_ERROR("Watchdog: taches en retard 0x%02X, reset imminent", overdue);
+      }
+      watchdogRecord.overdue = overdue;
+      return;
+    }
+
+    watchdogRecord.overdue = 0;
+    if (running) wdt_reset();
+  }
+
+  // ============================================
+  // INJECTION DE FAUTES
+  // ============================================
+
+  /**
+   * @brief Simule une tâche bloquée : ses signalements sont ignorés
+   * @param task Tâche
+   */
+  void inject(WatchdogTask task) {
+    injected |= 1 << (uint8_t)task;
+  }
+
+  /**
+   * @brief Simule un blocage complet de loop()
+   */
+  void hang() {
+    for (;;) {
+    }
+  }
+
+  // ============================================
+  // GETTERS
+  // ============================================
+
+  bool isRunning() const { return running; }
+  uint8_t getResetCause() const { return resetCause; }
+  uint16_t getResetCount() const { return watchdogRecord.resetCount; }
+
+  /**
+   * @brief Nom d'une étape de loop() (flash, pour "%S")
+   */
+  static const __FlashStringHelper* stageName(uint8_t stage) {
+    switch ((LoopStage)stage) {
+      case LoopStage::SETUP:       return F("setup");
+      case LoopStage::SENSORS:     return F("capteurs");
+      case LoopStage::HEALTH:      return F("supervision");
+      case LoopStage::ALERTS:      return F("alertes");
+      case LoopStage::LEDS:        return F("LEDs");
+      case LoopStage::DISPLAY:     return F("affichage");
+      case LoopStage::DASHBOARD:   return F("tableau de bord");
+      case LoopStage::CALIBRATION: return F("calibration");
+      case LoopStage::CONSOLE:     return F("console");
+      case LoopStage::STATS:       return F("statistiques");
+      case LoopStage::LOG:         return F("journal");
+      case LoopStage::IDLE:        return F("veille");
+      default:                     return F("?");
+    }
+  }
+
+  /**
+   * @brief Cause d'un reset d'après MCUSR (flash, pour "%S")
+   */
+  static const __FlashStringHelper* causeName(uint8_t mcusr) {
+    if (mcusr & _BV(WDRF))  return F("watchdog");
+    if (mcusr & _BV(BORF))  return F("baisse de tension");
+    if (mcusr & _BV(EXTRF)) return F("bouton reset");
+    if (mcusr & _BV(PORF))  return F("mise sous tension");
+    return F("inconnue (bootloader)");
+  }
+};
+
+// ============================================
+// INSTANCE GLOBALE
+// ============================================
+Watchdog watchdog;
+
+#endif // WATCHDOG_H
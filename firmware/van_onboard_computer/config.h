@@ -12,6 +12,10 @@
  * - Seuils d'alerte (CO, GPL, tensions, températures)
  * - Intervalles d'acquisition
  * - Paramètres d'affichage
+ *
+ * Les seuils et intervalles ne sont que des valeurs par défaut :
+ * les modules lisent le registre de paramètres (Settings.h),
+ * modifiable à chaud depuis la console série.
  */
 
 #ifndef CONFIG_H
@@ -33,6 +37,8 @@
 #define I2C_INA226_12V          0x40    ///< Surveillance rail 12V
 #define I2C_INA226_5V           0x41    ///< Surveillance rail 5V
 #define I2C_LCD                 0x27    ///< Écran LCD 20x4
+#define I2C_CLOCK_SPEED         400000  ///< I2C Fast Mode (Hz)
+#define I2C_TIMEOUT_US          2000    ///< Durée max d'une transaction I2C (µs, I2CBus.h)
 
 // ============================================
 // CONFIGURATION MATÉRIELLE - PINS GPIO
@@ -51,9 +57,10 @@
 #define PIN_BUZZER              25      ///< Buzzer piézoélectrique
 #define PIN_WS2812B             6       ///< Bandeau LED WS2812B
 
-// LCD déporté (optionnel, non implémenté v1.0)
-#define PIN_DASHBOARD_TX        18      ///< UART2 TX vers Arduino Nano
-#define PIN_DASHBOARD_RX        19      ///< UART2 RX depuis Arduino Nano
+// LCD déporté (optionnel, voir USE_DASHBOARD_LCD)
+#define PIN_DASHBOARD_TX        18      ///< TX1 (Serial1) vers Arduino Nano
+#define PIN_DASHBOARD_RX        19      ///< RX1 (Serial1) depuis Arduino Nano
+#define DASHBOARD_SERIAL        Serial1 ///< Port matériel des broches 18/19
 
 // ============================================
 // CONFIGURATION WS2812B
@@ -87,6 +94,10 @@
 #define SMOKE_THRESHOLD_WARNING 1500    ///< Warning : attention nécessaire (ppm)
 #define SMOKE_THRESHOLD_DANGER  2000    ///< Danger : évacuation immédiate (ppm)
 
+// Modules MQ7/MQ2
+#define MQ_LOAD_RESISTOR        10.0    ///< Résistance de charge RL des modules (kΩ)
+#define GAS_MAX_READ_FAILURES   5       ///< Lectures ratées consécutives avant capteur gaz hors service
+
 // ============================================
 // SEUILS ALERTES - ÉLECTRIQUES
 // ============================================
@@ -114,6 +125,7 @@
 #define TEMP_COMFORT_MIN        15      ///< Confort minimum (°C)
 #define TEMP_COMFORT_MAX        25      ///< Confort maximum (°C)
 #define TEMP_WARNING            35      ///< Warning : chaleur excessive (°C)
+#define TEMP_FREEZE             0       ///< Warning : risque de gel (°C)
 #define TEMP_MAX                45      ///< Maximum absolu (°C)
 
 // Humidité
@@ -138,6 +150,7 @@
 #define INTERVAL_MQ2            2000    ///< 2s - Détection GPL/fumée
 #define INTERVAL_DISPLAY        100     ///< 100ms - Rafraîchissement LCD
 #define INTERVAL_LEDS           50      ///< 50ms - Rafraîchissement LEDs
+#define INTERVAL_DASHBOARD      100     ///< 100ms - Émission tableau de bord (10 Hz)
 
 // ============================================
 // TIMING SYSTÈME
@@ -148,6 +161,46 @@
 #define ALERT_BLINK_INTERVAL    500     ///< 500ms - Clignotement LED alerte
 #define BUZZER_BEEP_DURATION    100     ///< 100ms - Durée bip court
 
+// ============================================
+// SUPERVISION CAPTEURS (HealthMonitor.h)
+// ============================================
+#define HEALTH_CHECK_INTERVAL   500     ///< 500ms - Contrôle d'un capteur (chacun à tour de rôle)
+#define HEALTH_STALE_FACTOR     3       ///< Mesure périmée après N intervalles d'acquisition
+#define HEALTH_STALE_MIN        5000    ///< 5s - Âge minimal avant péremption (ms)
+#define HEALTH_MAX_ERRORS       3       ///< Sondages I2C ou lectures ratés consécutifs avant mise hors service
+#define HEALTH_RETRY_MIN        1000    ///< 1s - Première tentative de ré-initialisation (ms)
+#define HEALTH_RETRY_MAX        64000   ///< 64s - Plafond du délai exponentiel (ms)
+
+// ============================================
+// VEILLE CPU (IdleManager.h)
+// ============================================
+// Ordres de grandeur ATmega2560 seul à 16 MHz / 5 V (datasheet)
+#define IDLE_CURRENT_ACTIVE_MA  20      ///< Courant CPU actif (mA)
+#define IDLE_CURRENT_SLEEP_MA   8       ///< Courant CPU en veille IDLE (mA)
+
+// ============================================
+// PROFILS DE FONCTIONNEMENT (ProfileManager.h)
+// ============================================
+// ACTIVE : cadences du registre / PARKED, NIGHT : voies non critiques
+// ralenties (BME280, DS18B20, MPU6050, INA226 5V, LCD). MQ7/MQ2 et
+// INA226 12V jamais.
+#define PROFILE_CHECK_INTERVAL  1000    ///< 1s - Réévaluation du profil (ms)
+#define PROFILE_MOTION_THRESHOLD 50     ///< Variation roll+pitch entre deux mesures = mouvement (0,01°)
+#define PROFILE_MOTION_HOLD     120000  ///< 2 min - Maintien en ACTIVE après un mouvement (ms)
+#define PROFILE_PARK_DELAY      300000  ///< 5 min - Inactivité encodeur avant PARKED (ms)
+#define PROFILE_NIGHT_DELAY     1800000 ///< 30 min - Inactivité encodeur avant NIGHT (ms)
+#define PROFILE_NIGHT_CURRENT   1500    ///< Courant 12V max en NIGHT (mA)
+#define PROFILE_MIN_DWELL       60000   ///< 1 min - Durée min avant un passage PARKED <-> NIGHT (ms)
+#define PROFILE_SCALE_PARKED    4       ///< Multiplicateur des intervalles en PARKED
+#define PROFILE_SCALE_NIGHT     10      ///< Multiplicateur des intervalles en NIGHT
+
+// ============================================
+// CHIEN DE GARDE (Watchdog.h)
+// ============================================
+#define WDT_TIMEOUT             WDTO_4S ///< Reset si non réarmé (calibration MPU ~1,2 s)
+#define WDT_DEADLINE_GAS        2000    ///< Marge au-delà de l'intervalle MQ7/MQ2 : échantillon gaz (ms)
+#define WDT_DEADLINE_ALERTS     2000    ///< Marge au-delà de l'intervalle MQ7/MQ2 : évaluation des alertes (ms)
+
 // ============================================
 // CONFIGURATION INA226
 // ============================================
@@ -162,41 +215,153 @@
 #define LCD_COLS                20      ///< 20 colonnes
 #define LCD_ROWS                4       ///< 4 lignes
 #define LCD_BACKLIGHT_TIMEOUT   600000  ///< 10 min - Extinction auto (0=désactivé)
+#define LCD_MESSAGE_QUEUE_SIZE  4       ///< Messages temporaires en attente (surimpression)
+#define LCD_RETRY_INTERVAL      5000    ///< 5s - Ré-initialisation LCD après perte du bus (ms)
+
+// Courbes de tendance (TrendGraph.h)
+#define TREND_SAMPLES           8       ///< Échantillons conservés (= largeur des courbes)
+#define TREND_SAMPLE_INTERVAL   450000  ///< 7,5 min - Courbe de 8 échantillons = 1 h (ms)
+#define TREND_SPAN_12V          200     ///< Échelle minimale 12V : 0,2 V (millivolts)
+#define TREND_SPAN_HUMIDITY     500     ///< Échelle minimale humidité : 5 % (centièmes)
+
+// ============================================
+// CONFIGURATION TABLEAU DE BORD (Nano)
+// ============================================
+#define DASHBOARD_BAUD_RATE     19200   ///< Vitesse liaison Serial1
+#define DASHBOARD_KEYFRAME_INTERVAL 5000 ///< 5s - Image complète périodique (ms)
+#define DASHBOARD_ACK_TIMEOUT   50      ///< Attente ACK avant retransmission (ms)
+#define DASHBOARD_MAX_RETRIES   3       ///< Retransmissions avant perte de liaison
 
 // ============================================
 // CONFIGURATION MPU6050
 // ============================================
 #define MPU6050_CALIBRATION_SAMPLES  100  ///< Échantillons pour calibration
 
+// Écran d'horizontalité / calage (BubbleLevel.h)
+#define LEVEL_MPU_INTERVAL      50      ///< Acquisition MPU6050 pendant le calage (ms)
+#define LEVEL_BUBBLE_RANGE      300     ///< Bulle en butée verticale à 3° (centièmes de degré)
+#define LEVEL_GUIDE_MAX_TILT    2000    ///< Calage calculé jusqu'à 20° (centièmes de degré)
+#define LEVEL_WHEELBASE         350     ///< Empattement (cm, paramètre "wheelbase")
+#define LEVEL_TRACK             165     ///< Voie (cm, paramètre "track")
+#define LEVEL_ROLL_SIGN         1       ///< 1 : roll > 0 = côté droit bas (-1 selon le montage)
+#define LEVEL_PITCH_SIGN        1       ///< 1 : pitch > 0 = avant haut (-1 selon le montage)
+
+// ============================================
+// PROFIL MATÉRIEL (BoardProfile.h)
+// ============================================
+// Profil choisi à la compilation (-DBOARD_PROFILE=n) ; tailles et
+// temps de boucle de chaque profil : tools/scripts/profile_sizes.py
+#define BOARD_PROFILE_VAN       0       ///< Câblage du van (drapeaux ci-dessous)
+#define BOARD_PROFILE_NO_AUX    1       ///< Sans DS18B20 ni INA226 5V
+#define BOARD_PROFILE_SAFETY    2       ///< MQ7, MQ2 et INA226 12V seuls
+
+#ifndef BOARD_PROFILE
+#define BOARD_PROFILE           BOARD_PROFILE_VAN
+#endif
+
+// Capteur à false : ni instance, ni code, ni test dans loop()
+#if BOARD_PROFILE == BOARD_PROFILE_NO_AUX
+#define BOARD_HAS_BME280        true
+#define BOARD_HAS_DS18B20       false
+#define BOARD_HAS_MPU6050       true
+#define BOARD_HAS_MQ7           true
+#define BOARD_HAS_MQ2           true
+#define BOARD_HAS_INA226_12V    true
+#define BOARD_HAS_INA226_5V     false
+#elif BOARD_PROFILE == BOARD_PROFILE_SAFETY
+#define BOARD_HAS_BME280        false
+#define BOARD_HAS_DS18B20       false
+#define BOARD_HAS_MPU6050       false
+#define BOARD_HAS_MQ7           true
+#define BOARD_HAS_MQ2           true
+#define BOARD_HAS_INA226_12V    true
+#define BOARD_HAS_INA226_5V     false
+#else
+#define BOARD_HAS_BME280        true    ///< Température/humidité intérieure
+#define BOARD_HAS_DS18B20       true    ///< Température extérieure
+#define BOARD_HAS_MPU6050       true    ///< Horizontalité
+#define BOARD_HAS_MQ7           true    ///< CO (sécurité)
+#define BOARD_HAS_MQ2           true    ///< GPL/fumée (sécurité)
+#define BOARD_HAS_INA226_12V    true    ///< Surveillance rail 12V
+#define BOARD_HAS_INA226_5V     true    ///< Surveillance rail 5V
+#endif
+
 // ============================================
 // FONCTIONNALITÉS OPTIONNELLES
 // ============================================
-#define USE_DASHBOARD_LCD       false   ///< LCD déporté (non implémenté v1.0)
+#define USE_DASHBOARD_LCD       false   ///< LCD déporté sur Arduino Nano (Serial1)
 #define USE_SERIAL_DEBUG        true    ///< Sortie debug sur Serial
+#ifndef USE_SERIAL_TELEMETRY
+#define USE_SERIAL_TELEMETRY    false   ///< Télémétrie binaire sur Serial (remplace les statistiques texte)
+#endif
+#define INTERVAL_TELEMETRY      1000    ///< 1s - Émission d'un instantané de télémétrie (ms)
+#define USE_SERIAL_CONSOLE      true    ///< Console de réglage sur Serial (nécessite USE_SERIAL_DEBUG)
+#define USE_WATCHDOG            true    ///< Chien de garde matériel (reset si tâche critique bloquée)
+#define USE_IDLE_SLEEP          true    ///< Veille IDLE du CPU entre deux échéances (IdleManager.h)
+#define USE_OPERATING_PROFILES  true    ///< Profils ACTIVE/PARKED/NIGHT automatiques (ProfileManager.h)
 #define SERIAL_BAUD_RATE        115200  ///< Vitesse Serial
 
+// Journal de debug (Logger.h)
+#define LOG_LEVEL_NONE          0       ///< Aucun message
+#define LOG_LEVEL_ERROR         1       ///< Erreurs uniquement
+#define LOG_LEVEL_WARN          2       ///< + avertissements
+#define LOG_LEVEL_INFO          3       ///< + informations
+#define LOG_LEVEL_DEBUG         4       ///< + détails de mise au point
+#define LOG_LEVEL               LOG_LEVEL_INFO  ///< Niveau compilé (les autres sont retirés de la flash)
+#define LOG_BUFFER_SIZE         512     ///< Tampon circulaire du journal (octets)
+#define USE_LOG_TOKENS          false   ///< LOG_* émis en jetons binaires (tools/scripts/log_detokenizer.py)
+
+#if USE_SERIAL_CONSOLE && !USE_SERIAL_DEBUG
+  #error "USE_SERIAL_CONSOLE necessite USE_SERIAL_DEBUG (reponses via le journal)"
+#endif
+
 // ============================================
 // MACROS UTILITAIRES
 // ============================================
-// Macros pour debug conditionnel
+// Macros pour debug conditionnel (bufferisé, voir Logger.h)
 #if USE_SERIAL_DEBUG
-  #define DEBUG_PRINT(x)        Serial.print(x)
-  #define DEBUG_PRINTLN(x)      Serial.println(x)
-  // Fonction helper pour printf-like sur Arduino
-  inline void DEBUG_PRINTF(const char* format, ...) {
-    char buffer[128];
-    va_list args;
-    va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);
-    va_end(args);
-    Serial.print(buffer);
-  }
+  #include "Logger.h"
+  #define DEBUG_PRINT(x)        logger.print(x)
+  #define DEBUG_PRINTLN(x)      logger.println(x)
+  #define DEBUG_PRINTF(...)     logger.printf(__VA_ARGS__)
 #else
   #define DEBUG_PRINT(x)
   #define DEBUG_PRINTLN(x)
   #define DEBUG_PRINTF(...)
 #endif
 
+// Macros de journal par niveau (filtrées à la compilation)
+// Texte : format en flash ; jetons : seul le jeton 32 bits est compilé
+#if USE_LOG_TOKENS
+  #define LOG_EMIT(level, prefix, fmt, ...)  logger.token(level, LOG_TOKEN_ID(fmt), ##__VA_ARGS__)
+#else
+  #define LOG_EMIT(level, prefix, fmt, ...)  logger.printf_P(PSTR(prefix fmt "\n"), ##__VA_ARGS__)
+#endif
+
+#if USE_SERIAL_DEBUG && LOG_LEVEL >= LOG_LEVEL_ERROR
+  #define LOG_ERROR(fmt, ...)   LOG_EMIT(LOG_LEVEL_ERROR, "[ERREUR] ", fmt, ##__VA_ARGS__)
+#else
+  #define LOG_ERROR(fmt, ...)   ((void)0)
+#endif
+#if USE_SERIAL_DEBUG && LOG_LEVEL >= LOG_LEVEL_WARN
+  #define LOG_WARN(fmt, ...)    LOG_EMIT(LOG_LEVEL_WARN, "[WARNING] ", fmt, ##__VA_ARGS__)
+#else
+  #define LOG_WARN(fmt, ...)    ((void)0)
+#endif
+#if USE_SERIAL_DEBUG && LOG_LEVEL >= LOG_LEVEL_INFO
+  #define LOG_INFO(fmt, ...)    LOG_EMIT(LOG_LEVEL_INFO, "[INFO] ", fmt, ##__VA_ARGS__)
+#else
+  #define LOG_INFO(fmt, ...)    ((void)0)
+#endif
+#if USE_SERIAL_DEBUG && LOG_LEVEL >= LOG_LEVEL_DEBUG
+  #define LOG_DEBUG(fmt, ...)   LOG_EMIT(LOG_LEVEL_DEBUG, "[DEBUG] ", fmt, ##__VA_ARGS__)
+#else
+  #define LOG_DEBUG(fmt, ...)   ((void)0)
+#endif
+
+// Statut capteur pour "%S" (chaîne en flash)
+#define SENSOR_STATUS(ok)     ((ok) ? F("OK") : F("ABSENT"))
+
 // Macros de conversion
 #define PPM_TO_PERCENT(ppm, max)  ((ppm * 100.0) / max)
 #define PERCENT_TO_PPM(pct, max)  ((pct * max) / 100.0)
@@ -207,41 +372,8 @@
 // ============================================
 // CARACTÈRES PERSONNALISÉS LCD
 // ============================================
-// Symbole degré (°)
-const uint8_t CHAR_DEGREE[8] = {
-  0b00110,
-  0b01001,
-  0b01001,
-  0b00110,
-  0b00000,
-  0b00000,
-  0b00000,
-  0b00000
-};
-
-// Symbole alerte (!)
-const uint8_t CHAR_ALERT[8] = {
-  0b00100,
-  0b00100,
-  0b00100,
-  0b00100,
-  0b00100,
-  0b00000,
-  0b00100,
-  0b00000
-};
-
-// Symbole batterie
-const uint8_t CHAR_BATTERY[8] = {
-  0b01110,
-  0b11111,
-  0b11111,
-  0b11111,
-  0b11111,
-  0b11111,
-  0b11111,
-  0b00000
-};
+// Motifs en flash et attribution des 8 emplacements CGRAM à la
+// demande : voir GlyphCache.h
 
 // ============================================
 // NOTES IMPORTANTES
@@ -17,12 +17,18 @@
  * - Alertes hiérarchisées avec buzzer
  * - Affichage LCD 20x4 + Navigation encodeur
  * - Bandeau LED WS2812B (8 LEDs)
+ * - Tableau de bord déporté (Arduino Nano, optionnel)
  * 
  * Modules :
  * - SensorManager : Acquisition capteurs
+ * - HealthMonitor : Supervision capteurs (péremption, ré-initialisation)
  * - AlertSystem : Gestion alertes
  * - LEDManager : Affichage LEDs
  * - DisplayManager : Affichage LCD + Navigation
+ * - DashboardLink : Liaison série tableau de bord
+ * - Watchdog : Chien de garde (tâches gaz, alertes)
+ * - IdleManager : Veille CPU entre deux échéances
+ * - ProfileManager : Profils ACTIVE/PARKED/NIGHT (cadences non critiques)
  * 
  * @warning Priorité absolue à la sécurité (CO, GPL)
  * @note Pré-chauffage requis : MQ7 (3 min), MQ2 (1 min)
@@ -34,10 +40,25 @@
 #include <Wire.h>
 #include "config.h"
 #include "SystemData.h"
+#include "FixedFormat.h"
 #include "SensorManager.h"
+#include "HealthMonitor.h"
 #include "AlertSystem.h"
 #include "LEDManager.h"
 #include "DisplayManager.h"
+#if USE_DASHBOARD_LCD
+#include "DashboardLink.h"
+#endif
+#if USE_SERIAL_TELEMETRY
+#include "Telemetry.h"
+#endif
+#include "Settings.h"
+#include "Watchdog.h"
+#include "IdleManager.h"
+#include "ProfileManager.h"
+#if USE_SERIAL_CONSOLE
+#include "SerialConsole.h"
+#endif
 
 // ============================================
 // ÉTAT SYSTÈME GLOBAL
@@ -47,10 +68,27 @@ SystemState systemState;
 // ============================================
 // GESTIONNAIRES
 // ============================================
-SensorManager* sensorManager = nullptr;
-AlertSystem* alertSystem = nullptr;
-LEDManager* ledManager = nullptr;
-DisplayManager* displayManager = nullptr;
+// Allocation statique : capteurs, LCD, encodeur et buzzer sont des
+// membres des gestionnaires, la carte mémoire complète est connue à
+// l'édition de liens (aucun new, tas inutilisé). Les constructeurs
+// n'accèdent pas au matériel : tout passe par begin() dans setup().
+SensorManager sensorManager(systemState);
+HealthMonitor healthMonitor(sensorManager);
+AlertSystem alertSystem(systemState);
+LEDManager ledManager(systemState);
+DisplayManager displayManager(systemState);
+#if USE_DASHBOARD_LCD
+DashboardLink dashboardLink(systemState, DASHBOARD_SERIAL);
+#endif
+#if USE_SERIAL_TELEMETRY
+Telemetry telemetry(systemState, Serial);
+#endif
+IdleManager idleManager(idleWork, wakePending);
+ProfileManager profileManager(systemState, sensorManager, displayManager, idleManager);
+#if USE_SERIAL_CONSOLE
+SerialConsole serialConsole(Serial, logger, systemState, &sensorManager, &healthMonitor,
+                            &profileManager);
+#endif
 
 // ============================================
 // TIMING
@@ -59,12 +97,17 @@ unsigned long loopStartTime = 0;
 unsigned long loopCount = 0;
 unsigned long lastStatsDisplay = 0;
 
+// ============================================
+// CALIBRATION
+// ============================================
+bool calibrationPending = false;  ///< Calibration MPU6050 en attente (messages LCD)
+
 // ============================================
 // SETUP - INITIALISATION
 // ============================================
 void setup() {
-  // Initialiser Serial pour debug
-  #if USE_SERIAL_DEBUG
+  // Initialiser Serial pour debug / télémétrie
+  #if USE_SERIAL_DEBUG || USE_SERIAL_TELEMETRY
   Serial.begin(SERIAL_BAUD_RATE);
   while (!Serial && millis() < 3000); // Attendre max 3s
 
@@ -76,9 +119,14 @@ void setup() {
   Serial.println();
   #endif
   
+  // Journal bufferisé : vidage bloquant pendant l'initialisation
+  #if USE_SERIAL_DEBUG
+  logger.begin(Serial);
+  logger.setSynchronous(true);
+  #endif
+  
   // Initialiser I2C
-  Wire.begin();
-  Wire.setClock(400000); // I2C Fast Mode (400 kHz)
+  I2CBus::begin(); // I2C Fast Mode (I2C_CLOCK_SPEED)
   
   DEBUG_PRINTLN(F("I2C initialise (400 kHz)"));
   delay(100);
@@ -88,51 +136,74 @@ void setup() {
   systemState.uptime = 0;
   
   DEBUG_PRINTLN(F("Etat systeme initialise"));
+  LOG_INFO("SystemState: %u octets (Alert: %u x %u) - RAM libre: %d",
+           (unsigned)sizeof(SystemState), (unsigned)sizeof(Alert),
+           (unsigned)ALERT_MAX_COUNT, freeRam());
+  
+  // Paramètres modifiables (EEPROM, sinon valeurs de config.h)
+  switch (settings.load()) {
+    case SettingsLoad::LOADED:
+      LOG_INFO("Parametres charges depuis l'EEPROM");
+      break;
+    case SettingsLoad::REPAIRED:
+      LOG_WARN("Parametres charges avec corrections (valeurs par defaut)");
+      break;
+    default:
+      LOG_INFO("Parametres par defaut (EEPROM vide ou invalide)");
+      break;
+  }
   
   // ====================================
   // INITIALISATION GESTIONNAIRES
   // ====================================
   // 1. DisplayManager (premier pour afficher progression)
   DEBUG_PRINTLN(F("\n--- Initialisation Display ---"));
-  displayManager = new DisplayManager(systemState);
-  if (!displayManager->begin()) {
-    DEBUG_PRINTLN(F("[ERREUR] Echec initialisation Display"));
+  if (!displayManager.begin()) {
+    LOG_ERROR("Echec initialisation Display");
   }
   delay(1000); // Laisser temps de lire écran boot
   
   // 2. SensorManager
   DEBUG_PRINTLN(F("\n--- Initialisation Capteurs ---"));
   if (systemState.sensors.lcd) {
-    displayManager->showMessage("Init capteurs...", 0);
+    displayManager.showMessage("Init capteurs...", 0);
   }
   
-  sensorManager = new SensorManager(systemState);
-  if (!sensorManager->begin()) {
-    DEBUG_PRINTLN(F("[ERREUR] Echec initialisation Capteurs"));
+  if (!sensorManager.begin()) {
+    LOG_ERROR("Echec initialisation Capteurs");
     if (systemState.sensors.lcd) {
-      displayManager->showMessage("ERREUR CAPTEURS!", 3000);
+      displayManager.showMessage("ERREUR CAPTEURS!", 3000);
     }
   }
   
+  // Supervision : capteurs absents retentés en tâche de fond
+  healthMonitor.begin();
+  
   // 3. AlertSystem
   DEBUG_PRINTLN(F("\n--- Initialisation Alertes ---"));
-  alertSystem = new AlertSystem(systemState);
-  if (!alertSystem->begin()) {
-    DEBUG_PRINTLN(F("[ERREUR] Echec initialisation Alertes"));
+  if (!alertSystem.begin()) {
+    LOG_ERROR("Echec initialisation Alertes");
   }
   
   // 4. LEDManager
   DEBUG_PRINTLN(F("\n--- Initialisation LEDs ---"));
-  ledManager = new LEDManager(systemState);
-  if (!ledManager->begin()) {
-    DEBUG_PRINTLN(F("[ERREUR] Echec initialisation LEDs"));
+  if (!ledManager.begin()) {
+    LOG_ERROR("Echec initialisation LEDs");
   }
   
   // Animation démarrage
   if (systemState.sensors.leds) {
-    ledManager->bootAnimation();
+    ledManager.bootAnimation();
   }
   
+  // 5. Tableau de bord déporté
+  #if USE_DASHBOARD_LCD
+  DEBUG_PRINTLN(F("\n--- Initialisation Tableau de bord ---"));
+  if (!dashboardLink.begin()) {
+    LOG_ERROR("Echec initialisation Tableau de bord");
+  }
+  #endif
+  
   // ====================================
   // RÉCAPITULATIF INITIALISATION
   // ====================================
@@ -142,55 +213,44 @@ void setup() {
   
   uint8_t sensorCount = 0;
   
-  DEBUG_PRINT(F("BME280 (temp/hum int): "));
-  DEBUG_PRINTLN(systemState.sensors.bme280 ? F("OK") : F("ABSENT"));
+  LOG_INFO("BME280 (temp/hum int): %S", SENSOR_STATUS(systemState.sensors.bme280));
   if (systemState.sensors.bme280) sensorCount++;
   
-  DEBUG_PRINT(F("DS18B20 (temp ext):    "));
-  DEBUG_PRINTLN(systemState.sensors.ds18b20 ? F("OK") : F("ABSENT"));
+  LOG_INFO("DS18B20 (temp ext): %S", SENSOR_STATUS(systemState.sensors.ds18b20));
   if (systemState.sensors.ds18b20) sensorCount++;
   
-  DEBUG_PRINT(F("MPU6050 (niveau):      "));
-  DEBUG_PRINTLN(systemState.sensors.mpu6050 ? F("OK") : F("ABSENT"));
+  LOG_INFO("MPU6050 (niveau): %S", SENSOR_STATUS(systemState.sensors.mpu6050));
   if (systemState.sensors.mpu6050) sensorCount++;
   
-  DEBUG_PRINT(F("MQ7 (CO):              "));
-  DEBUG_PRINTLN(systemState.sensors.mq7 ? F("OK") : F("ABSENT"));
+  LOG_INFO("MQ7 (CO): %S", SENSOR_STATUS(systemState.sensors.mq7));
   if (systemState.sensors.mq7) sensorCount++;
   
-  DEBUG_PRINT(F("MQ2 (GPL/fumee):       "));
-  DEBUG_PRINTLN(systemState.sensors.mq2 ? F("OK") : F("ABSENT"));
+  LOG_INFO("MQ2 (GPL/fumee): %S", SENSOR_STATUS(systemState.sensors.mq2));
   if (systemState.sensors.mq2) sensorCount++;
   
-  DEBUG_PRINT(F("INA226 12V:            "));
-  DEBUG_PRINTLN(systemState.sensors.ina226_12v ? F("OK") : F("ABSENT"));
+  LOG_INFO("INA226 12V: %S", SENSOR_STATUS(systemState.sensors.ina226_12v));
   if (systemState.sensors.ina226_12v) sensorCount++;
   
-  DEBUG_PRINT(F("INA226 5V:             "));
-  DEBUG_PRINTLN(systemState.sensors.ina226_5v ? F("OK") : F("ABSENT"));
+  LOG_INFO("INA226 5V: %S", SENSOR_STATUS(systemState.sensors.ina226_5v));
   if (systemState.sensors.ina226_5v) sensorCount++;
   
-  DEBUG_PRINT(F("LCD 20x4:              "));
-  DEBUG_PRINTLN(systemState.sensors.lcd ? F("OK") : F("ABSENT"));
+  LOG_INFO("LCD 20x4: %S", SENSOR_STATUS(systemState.sensors.lcd));
   
-  DEBUG_PRINT(F("Encodeur KY040:        "));
-  DEBUG_PRINTLN(systemState.sensors.encoder ? F("OK") : F("ABSENT"));
+  LOG_INFO("Encodeur KY040: %S", SENSOR_STATUS(systemState.sensors.encoder));
   
-  DEBUG_PRINT(F("LEDs WS2812B:          "));
-  DEBUG_PRINTLN(systemState.sensors.leds ? F("OK") : F("ABSENT"));
+  LOG_INFO("LEDs WS2812B: %S", SENSOR_STATUS(systemState.sensors.leds));
   
-  DEBUG_PRINT(F("Buzzer:                "));
-  DEBUG_PRINTLN(systemState.sensors.buzzer ? F("OK") : F("ABSENT"));
+  LOG_INFO("Buzzer: %S", SENSOR_STATUS(systemState.sensors.buzzer));
   
   DEBUG_PRINTLN(F("===================================="));
-  DEBUG_PRINTF("Total capteurs actifs: %d/7\n", sensorCount);
+  LOG_INFO("Total capteurs actifs: %d/%d", sensorCount, BoardProfile::sensorCount);
   DEBUG_PRINTLN(F("====================================\n"));
   
   // Vérifier qu'au moins les capteurs critiques sont présents
   if (!systemState.sensors.mq7 || !systemState.sensors.mq2) {
-    DEBUG_PRINTLN(F("[ALERTE] Capteurs gaz manquants - Securite compromise!"));
+    LOG_WARN("Capteurs gaz manquants - Securite compromise!");
     if (systemState.sensors.lcd) {
-      displayManager->showMessage("ALERTE: GAZ!", 3000);
+      displayManager.showMessage("ALERTE: GAZ!", 3000);
     }
   }
   
@@ -208,6 +268,22 @@ void setup() {
   
   DEBUG_PRINTLN(F("=== SYSTEME PRET ===\n"));
   
+  // Chien de garde : rapport du reset précédent, puis armement
+  // (après les délais d'initialisation)
+  watchdog.begin();
+  
+  // Veille CPU en fin de loop()
+  idleManager.begin();
+  
+  // Profils de fonctionnement : ACTIVE au démarrage
+  profileManager.begin();
+  
+  // Journal : vidage non-bloquant depuis loop()
+  #if USE_SERIAL_DEBUG
+  logger.flush();
+  logger.setSynchronous(false);
+  #endif
+  
   // Marquer temps de démarrage
   loopStartTime = millis();
 }
@@ -217,61 +293,95 @@ void setup() {
 // ============================================
 void loop() {
   unsigned long loopStart = millis();
+  #if USE_SERIAL_TELEMETRY
+  unsigned long loopStartUs = micros();
+  #endif
   
   // ====================================
   // 1. ACQUISITION CAPTEURS
   // ====================================
   // Chaque capteur gère son propre intervalle
-  if (sensorManager) {
-    sensorManager->update();
-  }
+  watchdog.mark(LoopStage::SENSORS);
+  sensorManager.update();
+  
+  // Supervision : un capteur contrôlé par appel
+  watchdog.mark(LoopStage::HEALTH);
+  healthMonitor.update();
+  
+  // Profil : ralentit les voies non critiques (jamais MQ7/MQ2)
+  profileManager.update();
   
   // ====================================
   // 2. VÉRIFICATION ALERTES
   // ====================================
   // PRIORITÉ ABSOLUE - Vérifié à chaque cycle
-  if (alertSystem) {
-    alertSystem->checkAlerts();
-    alertSystem->updateBuzzer();
-  }
+  watchdog.mark(LoopStage::ALERTS);
+  alertSystem.checkAlerts();
+  alertSystem.updateBuzzer();
   
   // ====================================
   // 3. MISE À JOUR LEDS
   // ====================================
-  if (ledManager) {
-    // Animation spéciale pendant pré-chauffage
-    if (systemState.mode == SystemMode::MODE_PREHEAT && sensorManager) {
-      uint8_t percent = sensorManager->getPreheatPercent();
-      ledManager->preheatAnimation(percent);
-    } else {
-      ledManager->update();
-    }
+  // Progression pré-chauffage (animation jouée par update())
+  watchdog.mark(LoopStage::LEDS);
+  if (systemState.mode == SystemMode::MODE_PREHEAT) {
+    ledManager.preheatAnimation(sensorManager.getPreheatPercent());
   }
+  ledManager.update();
   
   // ====================================
   // 4. MISE À JOUR AFFICHAGE
   // ====================================
-  if (displayManager) {
-    displayManager->update();
-    displayManager->handleScreenTimeout();
-  }
+  watchdog.mark(LoopStage::DISPLAY);
+  displayManager.update();
+  displayManager.handleScreenTimeout();
   
   // ====================================
-  // 5. GESTION CALIBRATION MPU6050
+  // 5. TABLEAU DE BORD DÉPORTÉ
   // ====================================
+  #if USE_DASHBOARD_LCD
+  watchdog.mark(LoopStage::DASHBOARD);
+  dashboardLink.update();
+  #endif
+  
+  // ====================================
+  // 6. GESTION CALIBRATION MPU6050
+  // ====================================
+  watchdog.mark(LoopStage::CALIBRATION);
   if (systemState.calibrationMode) {
+    startMPU6050Calibration();
+  }
+  
+  // Lancer la mesure une fois les consignes affichées
+  if (calibrationPending && !displayManager.hasMessage()) {
     performMPU6050Calibration();
   }
   
   // ====================================
-  // 6. MISE À JOUR UPTIME
+  // 7. CONSOLE SÉRIE
+  // ====================================
+  #if USE_SERIAL_CONSOLE
+  watchdog.mark(LoopStage::CONSOLE);
+  serialConsole.update();
+  #endif
+  
+  // ====================================
+  // 8. MISE À JOUR UPTIME
   // ====================================
   systemState.uptime = millis() / 1000; // En secondes
   
   // ====================================
-  // 7. STATISTIQUES DEBUG (toutes les 10s)
+  // 9. STATISTIQUES DEBUG (toutes les 10s)
   // ====================================
-  #if USE_SERIAL_DEBUG
+  watchdog.mark(LoopStage::STATS);
+  #if USE_SERIAL_TELEMETRY
+  // Instantané binaire, émis sans bloquer
+  if (millis() - lastStatsDisplay >= INTERVAL_TELEMETRY) {
+    lastStatsDisplay = millis();
+    sendTelemetry();
+  }
+  telemetry.update();
+  #elif USE_SERIAL_DEBUG
   if (millis() - lastStatsDisplay >= 10000) {
     lastStatsDisplay = millis();
     displayStats();
@@ -279,53 +389,123 @@ void loop() {
   #endif
   
   // ====================================
-  // 8. WATCHDOG / MONITORING LOOP
+  // 10. WATCHDOG / MONITORING LOOP
   // ====================================
   loopCount++;
   unsigned long loopDuration = millis() - loopStart;
   
+  #if USE_SERIAL_TELEMETRY
+  telemetry.recordLoop(micros() - loopStartUs);
+  #endif
+  
   // Avertir si loop trop lent (>100ms)
   if (loopDuration > 100) {
-    DEBUG_PRINTF("[WARNING] Loop lent: %lu ms\n", loopDuration);
+    LOG_WARN("Loop lent: %lu ms", loopDuration);
   }
   
-  // Petit délai pour stabilité (optionnel)
-  // delay(1); // Décommenter si nécessaire
+  // Réarmement conditionné aux signalements des tâches critiques
+  watchdog.update();
+  
+  // ====================================
+  // 11. VIDAGE JOURNAL (temps libre)
+  // ====================================
+  watchdog.mark(LoopStage::LOG);
+  #if USE_SERIAL_DEBUG
+  #if USE_SERIAL_TELEMETRY
+  // Ne pas couper une trame de télémétrie en cours
+  if (!telemetry.isBusy())
+  #endif
+  logger.drain();
+  #endif
+  
+  // ====================================
+  // 12. VEILLE CPU (jusqu'à l'échéance suivante)
+  // ====================================
+  watchdog.mark(LoopStage::IDLE);
+  idleManager.sleep();
 }
 
 // ============================================
 // FONCTIONS AUXILIAIRES
 // ============================================
 /**
- * @brief Effectue la calibration du MPU6050
+ * @brief Travail de fond à chaque réveil de veille (IdleManager)
+ * 
+ * @details Vide journal et télémétrie au fil de l'eau.
+ */
+void idleWork() {
+  #if USE_SERIAL_TELEMETRY
+  telemetry.update();
+  #endif
+  #if USE_SERIAL_DEBUG
+  #if USE_SERIAL_TELEMETRY
+  if (!telemetry.isBusy())
+  #endif
+  logger.drain();
+  #endif
+}
+
+/**
+ * @brief Test de reprise avant veille (IdleManager, interruptions masquées)
+ * @return true si loop() doit reprendre sans attendre l'échéance
+ * 
+ * @details Reprise immédiate sur commande reçue, cran d'encodeur ou
+ * calibration en attente. Lectures d'indices et de drapeaux seulement.
+ * Une alerte sonore ne réveille pas loop() : le buzzer est séquencé
+ * par l'interruption Timer0.
+ */
+bool wakePending() {
+  #if USE_SERIAL_CONSOLE
+  if (Serial.available() > 0) return true;
+  #endif
+  #if USE_DASHBOARD_LCD
+  if (DASHBOARD_SERIAL.available() > 0) return true;
+  #endif
+  
+  return displayManager.hasPendingInput() ||
+         calibrationPending;
+}
+
+/**
+ * @brief Prépare la calibration du MPU6050
  * 
  * @details
- * - Affiche instructions sur LCD
- * - Effectue 100 mesures
- * - Calcule et applique offsets
- * - Affiche résultat
+ * - Affiche les instructions sur LCD (messages non-bloquants)
+ * - La mesure est lancée par loop() une fois les messages expirés
  */
-void performMPU6050Calibration() {
+void startMPU6050Calibration() {
   systemState.calibrationMode = false; // Reset flag
   
-  if (!systemState.sensors.mpu6050 || !sensorManager) {
-    if (displayManager) {
-      displayManager->showMessage("MPU6050 absent!", 2000);
-    }
+  if (!systemState.sensors.mpu6050) {
+    displayManager.showMessage("MPU6050 absent!", 2000);
     return;
   }
   
   DEBUG_PRINTLN(F("\n=== CALIBRATION MPU6050 ==="));
   DEBUG_PRINTLN(F("Placez le van a plat et immobile"));
-  DEBUG_PRINTLN(F("Calibration en cours..."));
   
-  // Afficher message LCD
-  if (displayManager && systemState.sensors.lcd) {
-    displayManager->showMessage("Calibration MPU...", 0);
-    delay(1000);
-    displayManager->showMessage("Van a plat!", 2000);
+  // Afficher consignes LCD
+  if (systemState.sensors.lcd) {
+    displayManager.showMessage("Calibration MPU...", 1000);
+    displayManager.showMessage("Van a plat!", 2000);
   }
   
+  calibrationPending = true;
+}
+
+/**
+ * @brief Effectue la calibration du MPU6050
+ * 
+ * @details
+ * - Effectue 100 mesures
+ * - Calcule et applique offsets
+ * - Affiche résultat
+ */
+void performMPU6050Calibration() {
+  calibrationPending = false;
+  
+  DEBUG_PRINTLN(F("Calibration en cours..."));
+  
   // Callback progression
   auto progressCallback = [](uint16_t current, uint16_t total) {
     if (current % 10 == 0) { // Afficher tous les 10 échantillons
@@ -334,32 +514,32 @@ void performMPU6050Calibration() {
   };
   
   // Lancer calibration
-  bool success = sensorManager->calibrateMPU6050(progressCallback);
+  bool success = sensorManager.calibrateMPU6050(progressCallback);
   
   if (success) {
     DEBUG_PRINTLN(F("Calibration reussie!"));
     
     float roll, pitch;
-    sensorManager->getMPU6050Offsets(roll, pitch);
-    DEBUG_PRINTF("Offsets: Roll=%.2f, Pitch=%.2f\n", roll, pitch);
+    sensorManager.getMPU6050Offsets(roll, pitch);
+    #if USE_SERIAL_DEBUG
+    char rollText[FIXED_FORMAT_MAX], pitchText[FIXED_FORMAT_MAX];
+    FixedFormat::formatFloat(rollText, roll, 2);
+    FixedFormat::formatFloat(pitchText, pitch, 2);
+    DEBUG_PRINTF("Offsets: Roll=%s, Pitch=%s\n", rollText, pitchText);
+    #endif
     
-    if (displayManager) {
-      displayManager->showMessage("Calibration OK!", 2000);
-    }
+    // Conservés dans les paramètres (persistés par "save" en console)
+    settings.values.levelRollOffset = roll;
+    settings.values.levelPitchOffset = pitch;
+    
+    displayManager.showMessage("Calibration OK!", 2000);
   } else {
     DEBUG_PRINTLN(F("Echec calibration!"));
     
-    if (displayManager) {
-      displayManager->showMessage("Echec calib!", 2000);
-    }
+    displayManager.showMessage("Echec calib!", 2000);
   }
   
   DEBUG_PRINTLN(F("=========================\n"));
-  
-  // Retour écran précédent
-  if (displayManager) {
-    displayManager->forceRefresh();
-  }
 }
 
 /**
@@ -370,6 +550,8 @@ void displayStats() {
   DEBUG_PRINTLN(F("STATISTIQUES SYSTEME"));
   DEBUG_PRINTLN(F("===================================="));
   
+  char text[3][FIXED_FORMAT_MAX];   // Valeurs formatées (FixedFormat.h, sans %f)
+  
   // Uptime
   unsigned long uptimeSeconds = systemState.uptime;
   unsigned long hours = uptimeSeconds / 3600;
@@ -388,41 +570,47 @@ void displayStats() {
   // Environnement
   DEBUG_PRINTLN(F("\n--- ENVIRONNEMENT ---"));
   if (systemState.environment.tempIntValid) {
-    DEBUG_PRINTF("Temp int: %.1f C\n", systemState.environment.tempInterior);
+    FixedFormat::format(text[0], systemState.environment.tempInterior, 1);
+    DEBUG_PRINTF("Temp int: %s C\n", text[0]);
   }
   if (systemState.environment.tempExtValid) {
-    DEBUG_PRINTF("Temp ext: %.1f C\n", systemState.environment.tempExterior);
+    FixedFormat::format(text[0], systemState.environment.tempExterior, 1);
+    DEBUG_PRINTF("Temp ext: %s C\n", text[0]);
   }
   if (systemState.environment.humidityValid) {
-    DEBUG_PRINTF("Humidite: %.0f %%\n", systemState.environment.humidity);
+    FixedFormat::format(text[0], systemState.environment.humidity, 0);
+    DEBUG_PRINTF("Humidite: %s %%\n", text[0]);
   }
   if (systemState.environment.pressureValid) {
-    DEBUG_PRINTF("Pression: %.0f hPa\n", systemState.environment.pressure);
+    FixedFormat::format(text[0], systemState.environment.pressure, 0);
+    DEBUG_PRINTF("Pression: %s hPa\n", text[0]);
   }
   
   // Puissance
   DEBUG_PRINTLN(F("\n--- ENERGIE ---"));
   if (systemState.power.voltage12VValid) {
-    DEBUG_PRINTF("12V: %.2f V - %.2f A - %.1f W\n",
-                 systemState.power.voltage12V,
-                 systemState.power.current12V,
-                 systemState.power.power12V);
+    FixedFormat::format(text[0], systemState.power.voltage12V, 2);
+    FixedFormat::format(text[1], systemState.power.current12V, 2);
+    FixedFormat::format(text[2], systemState.power.power12V, 1);
+    DEBUG_PRINTF("12V: %s V - %s A - %s W\n", text[0], text[1], text[2]);
   }
   if (systemState.power.voltage5VValid) {
-    DEBUG_PRINTF("5V: %.2f V - %.2f A - %.1f W\n",
-                 systemState.power.voltage5V,
-                 systemState.power.current5V,
-                 systemState.power.power5V);
+    FixedFormat::format(text[0], systemState.power.voltage5V, 2);
+    FixedFormat::format(text[1], systemState.power.current5V, 2);
+    FixedFormat::format(text[2], systemState.power.power5V, 1);
+    DEBUG_PRINTF("5V: %s V - %s A - %s W\n", text[0], text[1], text[2]);
   }
-  DEBUG_PRINTF("Total: %.1f W\n", systemState.power.powerTotal);
+  FixedFormat::format(text[0], systemState.power.powerTotal, 1);
+  DEBUG_PRINTF("Total: %s W\n", text[0]);
   
   // Sécurité
   DEBUG_PRINTLN(F("\n--- SECURITE ---"));
   if (systemState.safety.mq7Preheated) {
-    DEBUG_PRINTF("CO:    %.0f ppm", systemState.safety.coPPM);
-    if (systemState.safety.coPPM > CO_THRESHOLD_DANGER) {
+    FixedFormat::format(text[0], systemState.safety.coPPM, 0);
+    DEBUG_PRINTF("CO:    %s ppm", text[0]);
+    if (systemState.safety.coPPM > settings.values.coDanger) {
       DEBUG_PRINTLN(F(" [DANGER]"));
-    } else if (systemState.safety.coPPM > CO_THRESHOLD_WARNING) {
+    } else if (systemState.safety.coPPM > settings.values.coWarning) {
       DEBUG_PRINTLN(F(" [WARNING]"));
     } else {
       DEBUG_PRINTLN(F(" [OK]"));
@@ -432,19 +620,21 @@ void displayStats() {
   }
   
   if (systemState.safety.mq2Preheated) {
-    DEBUG_PRINTF("GPL:   %.0f ppm", systemState.safety.gplPPM);
-    if (systemState.safety.gplPPM > GPL_THRESHOLD_DANGER) {
+    FixedFormat::format(text[0], systemState.safety.gplPPM, 0);
+    DEBUG_PRINTF("GPL:   %s ppm", text[0]);
+    if (systemState.safety.gplPPM > settings.values.gplDanger) {
       DEBUG_PRINTLN(F(" [DANGER]"));
-    } else if (systemState.safety.gplPPM > GPL_THRESHOLD_WARNING) {
+    } else if (systemState.safety.gplPPM > settings.values.gplWarning) {
       DEBUG_PRINTLN(F(" [WARNING]"));
     } else {
       DEBUG_PRINTLN(F(" [OK]"));
     }
     
-    DEBUG_PRINTF("Fumee: %.0f ppm", systemState.safety.smokePPM);
-    if (systemState.safety.smokePPM > SMOKE_THRESHOLD_DANGER) {
+    FixedFormat::format(text[0], systemState.safety.smokePPM, 0);
+    DEBUG_PRINTF("Fumee: %s ppm", text[0]);
+    if (systemState.safety.smokePPM > settings.values.smokeDanger) {
       DEBUG_PRINTLN(F(" [DANGER]"));
-    } else if (systemState.safety.smokePPM > SMOKE_THRESHOLD_WARNING) {
+    } else if (systemState.safety.smokePPM > settings.values.smokeWarning) {
       DEBUG_PRINTLN(F(" [WARNING]"));
     } else {
       DEBUG_PRINTLN(F(" [OK]"));
@@ -457,12 +647,14 @@ void displayStats() {
   // Horizontalité
   DEBUG_PRINTLN(F("\n--- HORIZONTALITE ---"));
   if (systemState.level.valid) {
-    DEBUG_PRINTF("Roll:  %+.1f deg\n", systemState.level.roll);
-    DEBUG_PRINTF("Pitch: %+.1f deg\n", systemState.level.pitch);
-    DEBUG_PRINTF("Total: %.1f deg", systemState.level.totalTilt);
-    if (systemState.level.totalTilt > TILT_DANGER) {
-      DEBUG_PRINTLN(F(" [DANGER]"));
-    } else if (systemState.level.totalTilt > TILT_WARNING) {
+    FixedFormat::format(text[0], systemState.level.roll, 1, FIXED_FORMAT_SIGN);
+    FixedFormat::format(text[1], systemState.level.pitch, 1, FIXED_FORMAT_SIGN);
+    FixedFormat::format(text[2], systemState.level.totalTilt, 1);
+    DEBUG_PRINTF("Roll:  %s deg\n", text[0]);
+    DEBUG_PRINTF("Pitch: %s deg\n", text[1]);
+    DEBUG_PRINTF("Total: %s deg", text[2]);
+    // Même seuil que AlertSystem (pas de niveau DANGER pour l'inclinaison)
+    if (systemState.level.totalTilt > settings.values.tiltWarning) {
       DEBUG_PRINTLN(F(" [WARNING]"));
     } else {
       DEBUG_PRINTLN(F(" [OK]"));
@@ -477,28 +669,104 @@ void displayStats() {
   if (systemState.alerts.activeAlertCount > 0) {
     DEBUG_PRINTLN(F("Liste:"));
     for (uint8_t i = 0; i < systemState.alerts.activeAlertCount; i++) {
-      Alert alert = systemState.alerts.alerts[i];
-      DEBUG_PRINTF("  %d. %s - %s (%.1f)\n",
+      const Alert& alert = systemState.alerts.alerts[i];
+      FixedFormat::format(text[0], alert.value, alertDecimals(alert.type), 1);
+      DEBUG_PRINTF("  %d. %s - %s (%s)\n",
                    i + 1,
                    alertTypeToShortString(alert.type),
                    alertLevelToString(alert.level),
-                   alert.value);
+                   text[0]);
     }
   }
   
+  // Santé capteurs
+  DEBUG_PRINTLN(F("\n--- SANTE CAPTEURS ---"));
+  for (uint8_t i = 0; i < (uint8_t)SensorId::COUNT; i++) {
+    SensorId id = (SensorId)i;
+    if (!SensorManager::isFitted(id)) continue;
+    const DeviceHealth& health = healthMonitor.getHealth(id);
+    DEBUG_PRINT(HealthMonitor::sensorName(id));
+    DEBUG_PRINTF(": %s - erreurs I2C %u - lectures %u - perimes %u - relances %u\n",
+                 sensorManager.isOnline(id) ? "OK" : "HORS SERVICE",
+                 health.errors, health.readFaults, health.staleCount, health.restarts);
+  }
+  DEBUG_PRINTF("Bus I2C: %u expiration(s) - %u deblocage(s)\n",
+               I2CBus::getTimeoutCount(), I2CBus::getRecoveryCount());
+  
   // Performance
   DEBUG_PRINTLN(F("\n--- PERFORMANCE ---"));
   DEBUG_PRINTF("Loops: %lu\n", loopCount);
   unsigned long avgLoopTime = (millis() - loopStartTime) / loopCount;
   DEBUG_PRINTF("Temps loop moyen: %lu ms\n", avgLoopTime);
-  DEBUG_PRINTF("RAM libre: %d bytes\n", freeRam());
+  DEBUG_PRINTF("RAM libre: %d bytes (SystemState: %u)\n", freeRam(), (unsigned)sizeof(SystemState));
+  DEBUG_PRINTF("CPU actif: %u %% - courant CPU estime: %u mA (reveils anticipes: %lu)\n",
+               idleManager.getActivePercent(),
+               idleManager.getEstimatedCurrent(),
+               idleManager.getWakeups());
+  DEBUG_PRINT(F("Profil: "));
+  DEBUG_PRINT(ProfileManager::profileName(profileManager.getProfile()));
+  DEBUG_PRINTF(" (x%u) - I2C capteurs %u/min - LCD %u trames/min\n",
+               ProfileManager::scale(profileManager.getProfile()),
+               ProfileManager::getSensorReadsPerMinute(profileManager.getProfile()),
+               systemState.backlightOn ?
+                 ProfileManager::getLcdFramesPerMinute(profileManager.getProfile()) : 0);
+  DEBUG_PRINTF("LCD: %s - %lu trame(s) evitee(s) en veille (~%lu Kio I2C) - %u reveil(s)\n",
+               displayManager.getPowerState() == DisplayPower::ASLEEP ? "veille" : "actif",
+               displayManager.getSkippedFrames(),
+               displayManager.getSavedI2CKilobytes(),
+               displayManager.getWakeCount());
+  DEBUG_PRINTF("LCD: %lu cellule(s) envoyee(s) - champs reformates %lu / inchanges %lu\n",
+               displayManager.getFlushedCells(),
+               displayManager.getFormattedSlots(),
+               displayManager.getUnchangedSlots());
+  const GlyphCache& glyphs = displayManager.getGlyphCache();
+  DEBUG_PRINTF("LCD: motifs CGRAM envoyes %lu / en place %lu - remplaces %u - repli %u - tendances %u\n",
+               glyphs.getUploads(), glyphs.getHits(), glyphs.getEvictions(),
+               glyphs.getMisses(), displayManager.getTrendSamples());
+  DEBUG_PRINTF("Watchdog: %s - %u reset(s)\n",
+               watchdog.isRunning() ? "actif" : "inactif", watchdog.getResetCount());
+  DEBUG_PRINTF("LED show: %lu (evites: %lu, %u/min)\n",
+               ledManager.getShowCount(),
+               ledManager.getSkipCount(),
+               ledManager.getShowsPerMinute());
+  
+  #if USE_DASHBOARD_LCD
+  DEBUG_PRINTLN(F("\n--- TABLEAU DE BORD ---"));
+  DEBUG_PRINTF("Liaison: %s\n", dashboardLink.isLinkUp() ? "OK" : "PERDUE");
+  DEBUG_PRINTF("Trames: %lu (%lu octets)\n",
+               dashboardLink.getFramesSent(),
+               dashboardLink.getBytesSent());
+  DEBUG_PRINTF("Retrans: %u - NAK: %u - Timeouts: %u - Erreurs RX: %u\n",
+               dashboardLink.getRetransmits(),
+               dashboardLink.getNakCount(),
+               dashboardLink.getTimeoutCount(),
+               dashboardLink.getRxErrorCount());
+  #endif
   
   DEBUG_PRINTLN(F("====================================\n"));
 }
 
+#if USE_SERIAL_TELEMETRY
+/**
+ * @brief Émet un instantané de télémétrie binaire
+ * 
+ * @details Décodage côté PC : tools/scripts/telemetry_decoder.py
+ */
+void sendTelemetry() {
+  TelemetryCounters counters;
+  counters.freeRam = freeRam();
+  counters.ledShowsPerMin = ledManager.getShowsPerMinute();
+  
+  telemetry.send(counters);
+}
+#endif
+
 /**
  * @brief Calcule la RAM libre disponible
  * @return Bytes de RAM libre
+ *
+ * @details Sans allocation dynamique, __brkval reste nul : l'écart
+ * mesuré va de la fin de .bss (__heap_start) au sommet de pile.
  */
 int freeRam() {
   extern int __heap_start, *__brkval;
@@ -0,0 +1,363 @@
+/**
+ * @file test_dashboard.ino
+ * @brief Programme de test du protocole tableau de bord (boucle Serial1)
+ * @author Frédéric BAILLON
+ * @version 1.0.0
+ * @date 2024-11-26
+ * 
+ * @details
+ * Ce programme valide le protocole de DashboardProtocol.h :
+ * - CRC16 + COBS : encodage/décodage de trames aléatoires
+ * - Boucle matérielle Serial1 : trames émises puis relues
+ * - Trames corrompues : rejet et resynchronisation sur le délimiteur
+ * - KEYFRAME + DELTA : reconstruction de la table de valeurs
+ * 
+ * Matériel requis :
+ * - Arduino Mega
+ * - Cavalier entre TX1 (broche 18) et RX1 (broche 19)
+ */
+
+#include "DashboardProtocol.h"
+
+// ============================================
+// CONFIGURATION
+// ============================================
+#define SERIAL_BAUD     115200  ///< Vitesse de communication série
+#define LOOPBACK_BAUD   19200   ///< Vitesse de la boucle Serial1
+#define TEST_FRAMES     200     ///< Nombre de trames par test
+#define RX_TIMEOUT      100     ///< Attente max d'une trame relue (ms)
+
+// ============================================
+// VARIABLES GLOBALES
+// ============================================
+DashboardFramer framer;
+
+// ============================================
+// SETUP
+// ============================================
+void setup() {
+  // Initialisation de la communication série
+  Serial.begin(SERIAL_BAUD);
+  Serial1.begin(LOOPBACK_BAUD);
+  delay(3000);
+  
+  Serial.println();
+  Serial.println(F("╔════════════════════════════════════════╗"));
+  Serial.println(F("║   TEST TABLEAU DE BORD - VOBC          ║"));
+  Serial.println(F("╚════════════════════════════════════════╝"));
+  Serial.println();
+  Serial.println(F("Cavalier requis : TX1 (18) -> RX1 (19)"));
+  
+  randomSeed(analogRead(A0));
+  
+  printMenu();
+}
+
+// ============================================
+// LOOP
+// ============================================
+void loop() {
+  // Attente d'une commande utilisateur
+  if (Serial.available()) {
+    handleCommand(Serial.read());
+    
+    while (Serial.available())  Serial.read();  // Vider le buffer série
+    
+    // Réaffichage du menu
+    delay(500);
+    printMenu();
+  }
+}
+
+// ============================================
+// GESTION COMMANDES
+// ============================================
+/**
+ * @brief Traite les commandes série
+ */
+void handleCommand(char cmd) {
+  Serial.println();
+
+  switch (cmd) {
+    case '1':
+      testEncodage();
+      break;
+    case '2':
+      testBoucle();
+      break;
+    case '3':
+      testCorruption();
+      break;
+    case '4':
+      testDelta();
+      break;
+    default:
+      Serial.println(F("Commande inconnue"));
+      break;
+  }
+}
+
+// ============================================
+// FONCTIONS AFFICHAGE
+// ============================================
+/**
+ * @brief Affiche le menu des tests
+ */
+void printMenu() {
+  Serial.println();
+  Serial.println(F("╔════════════════════════════════════════╗"));
+  Serial.println(F("║            COMMANDES                   ║"));
+  Serial.println(F("╚════════════════════════════════════════╝"));
+  Serial.println();
+  Serial.println(F("1. Test CRC16 + COBS (sans câblage)"));
+  Serial.println(F("2. Test boucle Serial1"));
+  Serial.println(F("3. Test trames corrompues"));
+  Serial.println(F("4. Test KEYFRAME + DELTA"));
+  Serial.println(F("----------------------------------------"));
+  Serial.println(F("Tapez le numéro du test à exécuter..."));
+  Serial.println();
+}
+
+/**
+ * @brief Affiche le résultat d'un test
+ * @param errors Nombre d'erreurs
+ * @param total Nombre de trames testées
+ */
+void printResult(uint16_t errors, uint16_t total) {
+  Serial.print(F("Trames : "));
+  Serial.print(total);
+  Serial.print(F(" - Erreurs : "));
+  Serial.println(errors);
+  Serial.println(errors == 0 ? F("✓ Test réussi") : F("✗ Test échoué"));
+}
+
+// ============================================
+// FONCTIONS UTILITAIRES
+// ============================================
+/**
+ * @brief Génère un payload aléatoire (avec des 0x00)
+ * @param payload [out] Payload
+ * @return Longueur
+ */
+uint8_t randomPayload(uint8_t* payload) {
+  uint8_t length = random(DASH_PAYLOAD_MAX + 1);
+  for (uint8_t i = 0; i < length; i++) {
+    payload[i] = (random(3) == 0) ? 0 : random(256);
+  }
+  return length;
+}
+
+/**
+ * @brief Attend une trame sur Serial1
+ * @param frame [out] Trame reçue
+ * @return true si une trame valide est reçue avant RX_TIMEOUT
+ */
+bool receiveFrame(DashboardFrame& frame) {
+  unsigned long start = millis();
+  while (millis() - start < RX_TIMEOUT) {
+    while (Serial1.available() > 0) {
+      if (framer.feed(Serial1.read(), frame)) return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Compare une trame reçue à la trame émise
+ */
+bool sameFrame(const DashboardFrame& frame, uint8_t type, uint8_t seq,
+               const uint8_t* payload, uint8_t length) {
+  return frame.type == type && frame.seq == seq && frame.length == length &&
+         memcmp(frame.payload, payload, length) == 0;
+}
+
+// ============================================
+// FONCTIONS DE TEST
+// ============================================
+/**
+ * @brief Encodage puis décodage local de trames aléatoires
+ */
+void testEncodage() {
+  Serial.println(F("=== Test 1 : CRC16 + COBS ==="));
+  
+  // Vecteur de référence CRC16-CCITT : "123456789" -> 0x29B1
+  const uint8_t check[] = {'1','2','3','4','5','6','7','8','9'};
+  uint16_t crc = dashCrc16(check, sizeof(check));
+  Serial.print(F("CRC16(\"123456789\") = 0x"));
+  Serial.println(crc, HEX);
+  
+  uint16_t errors = (crc == 0x29B1) ? 0 : 1;
+  DashboardFramer localFramer;
+  
+  for (uint16_t n = 0; n < TEST_FRAMES; n++) {
+    uint8_t payload[DASH_PAYLOAD_MAX];
+    uint8_t length = randomPayload(payload);
+    uint8_t encoded[DASH_ENCODED_MAX];
+    uint8_t size = dashBuildFrame(DASH_TYPE_DELTA, n, payload, length, encoded);
+    
+    // Aucun 0x00 avant le délimiteur
+    for (uint8_t i = 0; i < size - 1; i++) {
+      if (encoded[i] == 0) errors++;
+    }
+    
+    DashboardFrame frame;
+    bool received = false;
+    for (uint8_t i = 0; i < size; i++) {
+      received = localFramer.feed(encoded[i], frame);
+    }
+    if (!received || !sameFrame(frame, DASH_TYPE_DELTA, n, payload, length)) {
+      errors++;
+    }
+  }
+  
+  printResult(errors, TEST_FRAMES);
+}
+
+/**
+ * @brief Trames émises sur TX1 et relues sur RX1
+ */
+void testBoucle() {
+  Serial.println(F("=== Test 2 : Boucle Serial1 ==="));
+  
+  framer.reset();
+  while (Serial1.available()) Serial1.read();
+  
+  uint16_t errors = 0;
+  uint32_t bytes = 0;
+  unsigned long start = millis();
+  
+  for (uint16_t n = 0; n < TEST_FRAMES; n++) {
+    uint8_t payload[DASH_PAYLOAD_MAX];
+    uint8_t length = randomPayload(payload);
+    uint8_t encoded[DASH_ENCODED_MAX];
+    uint8_t size = dashBuildFrame(DASH_TYPE_KEYFRAME, n, payload, length, encoded);
+    
+    Serial1.write(encoded, size);
+    bytes += size;
+    
+    DashboardFrame frame;
+    if (!receiveFrame(frame) || !sameFrame(frame, DASH_TYPE_KEYFRAME, n, payload, length)) {
+      errors++;
+    }
+  }
+  
+  unsigned long duration = millis() - start;
+  Serial.print(F("Octets : "));
+  Serial.print(bytes);
+  Serial.print(F(" en "));
+  Serial.print(duration);
+  Serial.println(F(" ms"));
+  
+  if (errors == TEST_FRAMES) {
+    Serial.println(F("Aucune trame relue : vérifier le cavalier TX1 -> RX1"));
+  }
+  printResult(errors, TEST_FRAMES);
+}
+
+/**
+ * @brief Trames corrompues : rejet puis resynchronisation
+ */
+void testCorruption() {
+  Serial.println(F("=== Test 3 : Trames corrompues ==="));
+  
+  framer.reset();
+  while (Serial1.available()) Serial1.read();
+  
+  uint16_t errorsBefore = framer.getErrorCount();
+  uint16_t errors = 0;
+  
+  for (uint16_t n = 0; n < TEST_FRAMES; n++) {
+    uint8_t payload[DASH_PAYLOAD_MAX];
+    uint8_t length = randomPayload(payload);
+    uint8_t encoded[DASH_ENCODED_MAX];
+    uint8_t size = dashBuildFrame(DASH_TYPE_DELTA, n, payload, length, encoded);
+    
+    // Une trame sur deux : un octet altéré (jamais en 0x00)
+    bool corrupt = (n & 1);
+    if (corrupt) {
+      uint8_t index = random(size - 1);
+      uint8_t value = encoded[index] ^ (1 << random(8));
+      encoded[index] = value ? value : 0xFF;
+    }
+    
+    Serial1.write(encoded, size);
+    
+    DashboardFrame frame;
+    bool received = receiveFrame(frame);
+    if (corrupt && received) errors++;
+    if (!corrupt && (!received || !sameFrame(frame, DASH_TYPE_DELTA, n, payload, length))) {
+      errors++;
+    }
+  }
+  
+  Serial.print(F("Trames rejetées : "));
+  Serial.println(framer.getErrorCount() - errorsBefore);
+  printResult(errors, TEST_FRAMES);
+}
+
+/**
+ * @brief Reconstruction d'une table de valeurs par KEYFRAME + DELTA
+ */
+void testDelta() {
+  Serial.println(F("=== Test 4 : KEYFRAME + DELTA ==="));
+  
+  framer.reset();
+  while (Serial1.available()) Serial1.read();
+  
+  int16_t sent[DASH_FIELD_COUNT];
+  int16_t received[DASH_FIELD_COUNT];
+  uint16_t errors = 0;
+  uint32_t deltaBytes = 0;
+  
+  for (uint16_t n = 0; n < TEST_FRAMES; n++) {
+    uint8_t payload[DASH_PAYLOAD_MAX];
+    uint8_t length = 0;
+    uint8_t type;
+    
+    if (n == 0) {
+      // Image complète
+      type = DASH_TYPE_KEYFRAME;
+      for (uint8_t i = 0; i < DASH_FIELD_COUNT; i++) {
+        sent[i] = random(-1000, 1000);
+        uint8_t* out = dashPutInt16(payload + length, sent[i]);
+        length = out - payload;
+      }
+    } else {
+      // 1 à 3 champs modifiés
+      type = DASH_TYPE_DELTA;
+      memset(payload, 0, DASH_MASK_BYTES);
+      uint8_t changes = random(1, 4);
+      for (uint8_t c = 0; c < changes; c++) {
+        uint8_t field = random(DASH_FIELD_COUNT);
+        sent[field] += random(-20, 21);
+        payload[field >> 3] |= 1 << (field & 7);
+      }
+      length = DASH_MASK_BYTES;
+      for (uint8_t i = 0; i < DASH_FIELD_COUNT; i++) {
+        if (payload[i >> 3] & (1 << (i & 7))) {
+          dashPutInt16(payload + length, sent[i]);
+          length += 2;
+        }
+      }
+    }
+    
+    uint8_t encoded[DASH_ENCODED_MAX];
+    uint8_t size = dashBuildFrame(type, n, payload, length, encoded);
+    Serial1.write(encoded, size);
+    if (type == DASH_TYPE_DELTA) deltaBytes += size;
+    
+    DashboardFrame frame;
+    if (!receiveFrame(frame) || !dashApplyFrame(frame, received)) {
+      errors++;
+      continue;
+    }
+    if (memcmp(sent, received, sizeof(sent)) != 0) {
+      errors++;
+    }
+  }
+  
+  Serial.print(F("Taille moyenne DELTA : "));
+  Serial.print((float)deltaBytes / (TEST_FRAMES - 1), 1);
+  Serial.println(F(" octets"));
+  printResult(errors, TEST_FRAMES);
+}
@@ -0,0 +1,438 @@
+/**
+ * @file test_dashboard_responder.ino
+ * @brief Programme de test de la liaison tableau de bord (répondeur ACK/NAK)
+ * @author Frédéric BAILLON
+ * @version 1.0.0
+ * @date 2024-11-26
+ *
+ * @details
+ * Ce programme joue le rôle du Nano de la cabine face au VOBC
+ * (DashboardLink.h) et vérifie la réaction du Mega :
+ * - ACK : chaque trame acquittée n'est jamais réémise
+ * - NAK : la trame rejetée est réémise aussitôt, même seq
+ * - Trame ignorée : réémission après DASHBOARD_ACK_TIMEOUT, pas avant
+ * - Silence : 1 + DASHBOARD_MAX_RETRIES émissions de la trame, perte
+ *   de liaison, puis reprise par un KEYFRAME acquitté
+ *
+ * Matériel requis :
+ * - Arduino Mega (banc de test) exécutant ce programme
+ * - VOBC avec USE_DASHBOARD_LCD à true
+ * - Liaison croisée : TX1 (18) banc -> RX1 (19) VOBC,
+ *   TX1 (18) VOBC -> RX1 (19) banc, masse commune
+ */
+
+#include "DashboardProtocol.h"
+
+// ============================================
+// CONFIGURATION
+// ============================================
+#define SERIAL_BAUD     115200  ///< Vitesse de communication série
+
+// Doivent correspondre à config.h du VOBC
+#define DASHBOARD_BAUD_RATE         19200   ///< Vitesse liaison Serial1
+#define DASHBOARD_KEYFRAME_INTERVAL 5000    ///< Image complète périodique (ms)
+#define DASHBOARD_ACK_TIMEOUT       50      ///< Attente ACK avant retransmission (ms)
+#define DASHBOARD_MAX_RETRIES       3       ///< Retransmissions avant perte de liaison
+
+#define TEST_EVENTS     20      ///< Trames vérifiées par test
+#define RX_TIMEOUT      (DASHBOARD_KEYFRAME_INTERVAL + 1000)  ///< Attente max d'une trame (ms)
+#define SYNC_TIMEOUT    15000   ///< Attente max du premier KEYFRAME (ms)
+#define RETRANSMIT_SLACK 100    ///< Retard toléré d'une retransmission (ms)
+
+// ============================================
+// VARIABLES GLOBALES
+// ============================================
+DashboardFramer framer;
+int16_t values[DASH_FIELD_COUNT];   ///< Table reconstruite
+bool haveKeyframe = false;          ///< values exploitable
+unsigned long rxTime = 0;           ///< Réception de la dernière trame (ms)
+
+// ============================================
+// SETUP
+// ============================================
+void setup() {
+  // Initialisation de la communication série
+  Serial.begin(SERIAL_BAUD);
+  Serial1.begin(DASHBOARD_BAUD_RATE);
+  delay(3000);
+
+  Serial.println();
+  Serial.println(F("╔════════════════════════════════════════╗"));
+  Serial.println(F("║   TEST REPONDEUR TABLEAU DE BORD       ║"));
+  Serial.println(F("╚════════════════════════════════════════╝"));
+  Serial.println();
+  Serial.println(F("Liaison croisée Serial1 avec le VOBC requise"));
+
+  printMenu();
+}
+
+// ============================================
+// LOOP
+// ============================================
+void loop() {
+  // Hors test : acquitter pour garder la liaison active
+  DashboardFrame frame;
+  if (receiveFrame(frame, 0)) {
+    answer(frame);
+  }
+
+  // Attente d'une commande utilisateur
+  if (Serial.available()) {
+    handleCommand(Serial.read());
+
+    while (Serial.available())  Serial.read();  // Vider le buffer série
+
+    // Réaffichage du menu
+    delay(500);
+    printMenu();
+  }
+}
+
+// ============================================
+// GESTION COMMANDES
+// ============================================
+/**
+ * @brief Traite les commandes série
+ */
+void handleCommand(char cmd) {
+  Serial.println();
+
+  switch (cmd) {
+    case '1':
+      testAck();
+      break;
+    case '2':
+      testNak();
+      break;
+    case '3':
+      testTimeout();
+      break;
+    case '4':
+      testLinkLoss();
+      break;
+    default:
+      Serial.println(F("Commande inconnue"));
+      break;
+  }
+}
+
+// ============================================
+// FONCTIONS AFFICHAGE
+// ============================================
+/**
+ * @brief Affiche le menu des tests
+ */
+void printMenu() {
+  Serial.println();
+  Serial.println(F("╔════════════════════════════════════════╗"));
+  Serial.println(F("║            COMMANDES                   ║"));
+  Serial.println(F("╚════════════════════════════════════════╝"));
+  Serial.println();
+  Serial.println(F("1. Test ACK (aucune réémission)"));
+  Serial.println(F("2. Test NAK (réémission immédiate)"));
+  Serial.println(F("3. Test trame ignorée (timeout ACK)"));
+  Serial.println(F("4. Test perte de liaison et reprise"));
+  Serial.println(F("----------------------------------------"));
+  Serial.println(F("Tapez le numéro du test à exécuter..."));
+  Serial.println();
+}
+
+/**
+ * @brief Affiche le résultat d'un test
+ * @param errors Nombre d'erreurs
+ * @param total Nombre de trames testées
+ */
+void printResult(uint16_t errors, uint16_t total) {
+  Serial.print(F("Trames : "));
+  Serial.print(total);
+  Serial.print(F(" - Erreurs : "));
+  Serial.println(errors);
+  Serial.println(errors == 0 ? F("✓ Test réussi") : F("✗ Test échoué"));
+}
+
+/**
+ * @brief Affiche un délai moyen
+ * @param label Libellé
+ * @param total Somme des délais (ms)
+ * @param count Nombre de mesures
+ */
+void printDelay(const __FlashStringHelper* label, uint32_t total, uint16_t count) {
+  Serial.print(label);
+  Serial.print(count ? total / count : 0);
+  Serial.println(F(" ms"));
+}
+
+// ============================================
+// FONCTIONS UTILITAIRES
+// ============================================
+/**
+ * @brief Attend une trame KEYFRAME ou DELTA sur Serial1
+ * @param frame [out] Trame reçue
+ * @param timeout Attente max (ms, 0 = octets déjà reçus seulement)
+ * @return true si une trame valide est reçue (rxTime mis à jour)
+ */
+bool receiveFrame(DashboardFrame& frame, unsigned long timeout) {
+  unsigned long start = millis();
+  do {
+    while (Serial1.available() > 0) {
+      if (!framer.feed(Serial1.read(), frame)) continue;
+      if (frame.type != DASH_TYPE_KEYFRAME && frame.type != DASH_TYPE_DELTA) continue;
+      rxTime = millis();
+      return true;
+    }
+  } while (millis() - start < timeout);
+  return false;
+}
+
+/**
+ * @brief Émet un ACK ou un NAK
+ * @param type DASH_TYPE_ACK ou DASH_TYPE_NAK
+ * @param seq Seq de la trame visée (payload)
+ */
+void reply(uint8_t type, uint8_t seq) {
+  uint8_t encoded[DASH_ENCODED_MAX];
+  uint8_t size = dashBuildFrame(type, seq, &seq, 1, encoded);
+  Serial1.write(encoded, size);
+}
+
+/**
+ * @brief Réponse normale du Nano : applique la trame, ACK ou NAK
+ * @param frame Trame reçue
+ * @return true si la trame est acquittée
+ */
+bool answer(const DashboardFrame& frame) {
+  // DELTA sans KEYFRAME préalable : inapplicable
+  bool applied = (frame.type == DASH_TYPE_KEYFRAME || haveKeyframe) &&
+                 dashApplyFrame(frame, values);
+  if (applied && frame.type == DASH_TYPE_KEYFRAME) haveKeyframe = true;
+
+  reply(applied ? DASH_TYPE_ACK : DASH_TYPE_NAK, frame.seq);
+  return applied;
+}
+
+/**
+ * @brief Vide la liaison et attend un premier KEYFRAME acquitté
+ * @return false si le VOBC n'émet pas
+ *
+ * @details Sans table de référence, les DELTA sont rejetés (NAK) :
+ * le VOBC finit par déclarer la liaison perdue et émet un KEYFRAME.
+ */
+bool synchronize() {
+  framer.reset();
+  while (Serial1.available()) Serial1.read();
+  haveKeyframe = false;
+
+  Serial.println(F("Synchronisation (KEYFRAME)..."));
+  unsigned long start = millis();
+  DashboardFrame frame;
+  while (millis() - start < SYNC_TIMEOUT) {
+    if (!receiveFrame(frame, RX_TIMEOUT)) break;
+    if (answer(frame) && frame.type == DASH_TYPE_KEYFRAME) return true;
+  }
+
+  Serial.println(F("Aucun KEYFRAME : vérifier la liaison et USE_DASHBOARD_LCD"));
+  return false;
+}
+
+/**
+ * @brief Attend une trame nouvelle (seq différent du précédent) et l'applique
+ * @param frame [out] Trame reçue
+ * @param lastSeq [in/out] Seq de la dernière trame traitée
+ * @return false si aucune trame avant RX_TIMEOUT
+ */
+bool receiveFresh(DashboardFrame& frame, uint8_t& lastSeq) {
+  unsigned long start = millis();
+  while (millis() - start < RX_TIMEOUT) {
+    if (!receiveFrame(frame, RX_TIMEOUT)) return false;
+    if (frame.seq != lastSeq) {
+      lastSeq = frame.seq;
+      return true;
+    }
+    answer(frame);  // Réémission tardive d'une trame déjà traitée
+  }
+  return false;
+}
+
+// ============================================
+// FONCTIONS DE TEST
+// ============================================
+/**
+ * @brief Toutes les trames acquittées : aucune réémission ni saut de seq
+ */
+void testAck() {
+  Serial.println(F("=== Test 1 : ACK ==="));
+  if (!synchronize()) return;
+
+  uint16_t errors = 0;
+  uint16_t received = 0;
+  uint8_t lastSeq = 0;
+  bool first = true;
+  DashboardFrame frame;
+
+  while (received < TEST_EVENTS) {
+    if (!receiveFrame(frame, RX_TIMEOUT)) {
+      Serial.println(F("Timeout : plus de trame"));
+      errors++;
+      break;
+    }
+    received++;
+
+    if (!first && frame.seq != (uint8_t)(lastSeq + 1)) {
+      Serial.print(F("Seq inattendu : "));
+      Serial.print(frame.seq);
+      Serial.print(F(" après "));
+      Serial.println(lastSeq);
+      errors++;
+    }
+    first = false;
+    lastSeq = frame.seq;
+
+    if (!answer(frame)) errors++;
+  }
+
+  printResult(errors, received);
+}
+
+/**
+ * @brief Trames rejetées (NAK) : réémission immédiate, même seq
+ */
+void testNak() {
+  Serial.println(F("=== Test 2 : NAK ==="));
+  if (!synchronize()) return;
+
+  uint16_t errors = 0;
+  uint16_t events = 0;
+  uint32_t totalDelay = 0;
+  uint8_t lastSeq = 0xFF;
+  DashboardFrame frame;
+
+  while (events < TEST_EVENTS) {
+    if (!receiveFresh(frame, lastSeq)) {
+      Serial.println(F("Timeout : plus de trame"));
+      errors++;
+      break;
+    }
+    events++;
+
+    unsigned long sentAt = rxTime;
+    reply(DASH_TYPE_NAK, frame.seq);
+
+    DashboardFrame again;
+    if (!receiveFrame(again, DASHBOARD_ACK_TIMEOUT + RETRANSMIT_SLACK) || again.seq != frame.seq) {
+      Serial.print(F("Pas de réémission du seq "));
+      Serial.println(frame.seq);
+      errors++;
+      continue;
+    }
+    totalDelay += rxTime - sentAt;
+    answer(again);
+  }
+
+  printDelay(F("Délai moyen NAK -> réémission : "), totalDelay, events);
+  printResult(errors, events);
+}
+
+/**
+ * @brief Trames ignorées : réémission après DASHBOARD_ACK_TIMEOUT
+ */
+void testTimeout() {
+  Serial.println(F("=== Test 3 : Trame ignorée ==="));
+  if (!synchronize()) return;
+
+  uint16_t errors = 0;
+  uint16_t events = 0;
+  uint32_t totalDelay = 0;
+  uint8_t lastSeq = 0xFF;
+  DashboardFrame frame;
+
+  while (events < TEST_EVENTS) {
+    if (!receiveFresh(frame, lastSeq)) {
+      Serial.println(F("Timeout : plus de trame"));
+      errors++;
+      break;
+    }
+    events++;
+
+    // Aucune réponse
+    unsigned long sentAt = rxTime;
+    DashboardFrame again;
+    if (!receiveFrame(again, DASHBOARD_ACK_TIMEOUT + RETRANSMIT_SLACK) || again.seq != frame.seq) {
+      Serial.print(F("Pas de réémission du seq "));
+      Serial.println(frame.seq);
+      errors++;
+      continue;
+    }
+
+    unsigned long delayMs = rxTime - sentAt;
+    totalDelay += delayMs;
+    if (delayMs + 2 < DASHBOARD_ACK_TIMEOUT) {
+      Serial.print(F("Réémission prématurée : "));
+      Serial.print(delayMs);
+      Serial.println(F(" ms"));
+      errors++;
+    }
+    answer(again);
+  }
+
+  printDelay(F("Délai moyen de réémission : "), totalDelay, events);
+  printResult(errors, events);
+}
+
+/**
+ * @brief Silence prolongé : perte de liaison puis reprise par KEYFRAME
+ */
+void testLinkLoss() {
+  Serial.println(F("=== Test 4 : Perte de liaison ==="));
+  if (!synchronize()) return;
+
+  uint16_t errors = 0;
+  uint8_t lastSeq = 0xFF;
+  DashboardFrame frame;
+
+  if (!receiveFresh(frame, lastSeq)) {
+    Serial.println(F("Timeout : plus de trame"));
+    printResult(1, 0);
+    return;
+  }
+
+  // Aucune réponse : compter les émissions de la trame
+  uint8_t lostSeq = frame.seq;
+  uint8_t transmissions = 1;
+  DashboardFrame next;
+  bool resumed = false;
+  while (receiveFrame(next, RX_TIMEOUT)) {
+    if (next.seq != lostSeq) {
+      resumed = true;
+      break;
+    }
+    transmissions++;
+  }
+
+  Serial.print(F("Émissions de la trame perdue : "));
+  Serial.print(transmissions);
+  Serial.print(F(" (attendu "));
+  Serial.print(1 + DASHBOARD_MAX_RETRIES);
+  Serial.println(F(")"));
+  if (transmissions != 1 + DASHBOARD_MAX_RETRIES) errors++;
+
+  // Reprise : KEYFRAME au rythme DASHBOARD_KEYFRAME_INTERVAL
+  if (!resumed) {
+    Serial.println(F("Aucune trame après la perte de liaison"));
+    printResult(errors + 1, transmissions);
+    return;
+  }
+  if (next.type != DASH_TYPE_KEYFRAME) {
+    Serial.println(F("Reprise sans KEYFRAME"));
+    errors++;
+  }
+  if (!answer(next)) errors++;
+
+  // Liaison rétablie : trame suivante nouvelle et applicable
+  lastSeq = next.seq;
+  if (!receiveFresh(frame, lastSeq) || !answer(frame)) {
+    Serial.println(F("Liaison non rétablie après ACK"));
+    errors++;
+  }
+
+  printResult(errors, transmissions + 2);
+}
@@ -40,6 +40,8 @@
 #define INA226_MAX_CURRENT_12V  40.0f   ///< Courant max 12V : 81.92mV / 2mΩ = 40.96A
 #define INA226_MAX_CURRENT_5V   8.0f    ///< Courant max 5V : 81.92mV / 10mΩ = 8.19A
 
+#define INA226_MAX_BUS_VOLTAGE  36.0f   ///< Tension bus max mesurable (V)
+
 #define INA226_UPDATE_INTERVAL  500     ///< Intervalle de mise à jour (ms)
 
 // ============================================
@@ -177,16 +179,16 @@ public:
     if (rail == PowerRailType::RAIL_12V) {
       shuntResistance = INA226_SHUNT_12V;      // 2 mΩ
       maxCurrent = INA226_MAX_CURRENT_12V;     // 40A
-      voltageMin = 10.5f;   // Minimum 12V
-      voltageMax = 14.5f;   // Maximum 12V
-      currentMax = 20.0f;   // Seuil alerte courant (adapté à vos besoins)
     } else {
       shuntResistance = INA226_SHUNT_5V;       // 10 mΩ
       maxCurrent = INA226_MAX_CURRENT_5V;      // 8A
-      voltageMin = 4.5f;    // Minimum 5V
-      voltageMax = 5.5f;    // Maximum 5V
-      currentMax = 3.0f;    // Seuil alerte courant (adapté à vos besoins)
     }
+    
+    // Seuils d'alerte : plage de mesure complète tant que l'application
+    // ne les a pas fixés (setVoltageThresholds / setCurrentThreshold)
+    voltageMin = 0.0f;
+    voltageMax = INA226_MAX_BUS_VOLTAGE;
+    currentMax = maxCurrent;
   }
 
   // INITIALISATION
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""
+Détokeniseur du journal du Van Onboard Computer (USE_LOG_TOKENS).
+
+Le firmware remplace chaque format LOG_ERROR/LOG_WARN/LOG_INFO/LOG_DEBUG
+par son empreinte FNV-1a 32 bits (firmware/van_onboard_computer/Logger.h) :
+
+    [0xA5][0x5B][niveau][longueur][jeton][arguments][CRC16 LSB][CRC16 MSB]['\\n']
+
+Le dictionnaire jeton → format est reconstruit en parcourant les sources :
+aucune table à maintenir, il suffit d'utiliser les sources du firmware flashé.
+Le texte de debug et les trames de télémétrie (telemetry_decoder.py)
+du même flux sont également affichés.
+
+Usage :
+    log_detokenizer.py /dev/ttyACM0                  # port série (pyserial)
+    log_detokenizer.py capture.bin                   # fichier de capture
+    log_detokenizer.py - < capture.bin               # entrée standard
+    log_detokenizer.py --dump                        # affiche le dictionnaire
+    log_detokenizer.py /dev/ttyACM0 --src ../firmware/van_onboard_computer
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+from telemetry_decoder import StreamDecoder, open_source, render
+
+DEFAULT_SRC = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                           "..", "..", "firmware", "van_onboard_computer")
+
+LEVEL_PREFIXES = {1: "[ERREUR] ", 2: "[WARNING] ", 3: "[INFO] ", 4: "[DEBUG] "}
+
+# LOG_xxx( suivi d'un ou plusieurs littéraux concaténés
+LOG_CALL = re.compile(r'\bLOG_(?:ERROR|WARN|INFO|DEBUG)\s*\(\s*((?:"(?:[^"\\]|\\.)*"\s*)+)')
+LITERAL = re.compile(r'"((?:[^"\\]|\\.)*)"')
+ESCAPES = {"n": "\n", "t": "\t", "r": "\r", "\\": "\\", '"': '"', "'": "'", "0": "\0"}
+
+# Conversion printf : drapeaux, largeur, précision, longueur, type
+CONVERSION = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(l?)([diuxXcsSfeEgG%])")
+
+
+def fnv1a32(data):
+    """Empreinte FNV-1a 32 bits, identique à logTokenHash()."""
+    value = 2166136261
+    for byte in data:
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value
+
+
+def unescape(literal):
+    """Décode les séquences d'échappement d'un littéral C."""
+    return re.sub(r"\\(x[0-9a-fA-F]{2}|.)",
+                  lambda m: chr(int(m.group(1)[1:], 16)) if m.group(1)[0] == "x"
+                  else ESCAPES.get(m.group(1), m.group(1)),
+                  literal)
+
+
+def build_dictionary(src_dir):
+    """Parcourt les sources et associe chaque jeton à son format."""
+    tokens = {}
+    for root, _, files in os.walk(src_dir):
+        for name in sorted(files):
+            if not name.endswith((".h", ".cpp", ".ino")):
+                continue
+            path = os.path.join(root, name)
+            with open(path, encoding="utf-8") as source:
+                text = source.read()
+            for match in LOG_CALL.finditer(text):
+                fmt = "".join(unescape(lit) for lit in LITERAL.findall(match.group(1)))
+                token = fnv1a32(fmt.encode("utf-8"))
+                if token in tokens and tokens[token][0] != fmt:
+                    print("[JETON] Collision 0x%08X : %r / %r" % (token, tokens[token][0], fmt),
+                          file=sys.stderr)
+                line = text.count("\n", 0, match.start()) + 1
+                tokens[token] = (fmt, "%s:%d" % (name, line))
+    return tokens
+
+
+def format_record(fmt, args):
+    """Applique le format aux arguments binaires (tailles AVR)."""
+    out = []
+    pos = 0
+    offset = 0
+    for match in CONVERSION.finditer(fmt):
+        out.append(fmt[pos:match.start()])
+        pos = match.end()
+        flags, width, precision, long_mod, conv = match.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+
+        spec = "%" + flags + width + ("." + precision if precision is not None else "")
+        if conv in "sS":
+            end = args.find(b"\0", offset)
+            if end < 0:
+                out.append("<?>")
+                break
+            out.append((spec + "s") % args[offset:end].decode("utf-8", errors="replace"))
+            offset = end + 1
+            continue
+
+        if conv in "feEgG":
+            size, code = 4, "<f"
+        elif long_mod:
+            size, code = 4, "<l" if conv in "di" else "<L"
+        else:
+            size, code = 2, "<h" if conv in "di" else "<H"
+        if offset + size > len(args):
+            out.append("<?>")
+            break
+        value = struct.unpack_from(code, args, offset)[0]
+        offset += size
+
+        if conv == "c":
+            out.append((spec + "c") % chr(value & 0xFF))
+        elif conv in "iu":
+            out.append((spec + "d") % value)
+        else:
+            out.append((spec + conv) % value)
+    else:
+        out.append(fmt[pos:])
+    return "".join(out)
+
+
+def detokenize(level, payload, tokens):
+    """Rétablit le texte d'une trame de journal (sans fin de ligne)."""
+    prefix = LEVEL_PREFIXES.get(level, "[LOG%d] " % level)
+    if len(payload) < 4:
+        return prefix + "<trame invalide>"
+    token = struct.unpack_from("<I", payload)[0]
+    if token not in tokens:
+        return prefix + "<jeton inconnu 0x%08X : %s>" % (token, payload[4:].hex())
+    return prefix + format_record(tokens[token][0], payload[4:])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Détokeniseur du journal VOBC")
+    parser.add_argument("source", nargs="?", help="Port série, fichier de capture ou '-'")
+    parser.add_argument("--src", default=DEFAULT_SRC, help="Sources du firmware")
+    parser.add_argument("--baud", type=int, default=115200, help="Vitesse série")
+    parser.add_argument("--dump", action="store_true", help="Affiche le dictionnaire")
+    args = parser.parse_args()
+
+    tokens = build_dictionary(args.src)
+    if args.dump:
+        for token, (fmt, where) in sorted(tokens.items(), key=lambda item: item[1][1]):
+            print("0x%08X  %-28s %r" % (token, where, fmt))
+        return
+    if not args.source:
+        parser.error("source requise (ou --dump)")
+
+    source = open_source(args.source, args.baud)
+    decoder = StreamDecoder()
+
+    try:
+        while True:
+            data = source.read(256) if hasattr(source, "in_waiting") else source.read1(256) \
+                if hasattr(source, "read1") else source.read(256)
+            if not data:
+                if hasattr(source, "in_waiting"):
+                    continue  # Port série : attente
+                break          # Fin de fichier
+
+            for kind, item in decoder.feed(data):
+                if kind == "text":
+                    sys.stdout.write(item)
+                elif kind == "token":
+                    sys.stdout.write(detokenize(item[0], item[1], tokens))
+                else:
+                    print(render(item))
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+    if decoder.crc_errors:
+        print("\n[JOURNAL] En-têtes invalides ignorés : %d" % decoder.crc_errors, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""
+Tailles Flash/RAM et temps de boucle de chaque profil matériel.
+
+Compile le firmware pour chaque BOARD_PROFILE de config.h (arduino-cli,
+ATmega2560) puis mesure le .elf avec avr-size :
+
+    text  : code + constantes PROGMEM (Flash)
+    data  : variables initialisées (Flash et RAM)
+    bss   : variables non initialisées (RAM)
+
+Avec --port, chaque profil est aussi téléversé puis la télémétrie
+(USE_SERIAL_TELEMETRY forcé, telemetry_decoder.py) est lue pendant
+--seconds secondes : temps de boucle moyen et maximal relevés par la
+carte elle-même.
+
+Prérequis :
+    arduino-cli core install arduino:avr
+    bibliothèques du firmware (docs/INSTALL.md)
+
+Usage :
+    profile_sizes.py                              # tailles seules
+    profile_sizes.py --port /dev/ttyACM0          # tailles + temps de boucle
+    profile_sizes.py --profiles 0 2 --seconds 60
+"""
+
+import argparse
+import glob
+import os
+import shutil
+import subprocess
+import sys
+import time
+
+from telemetry_decoder import StreamDecoder, open_source
+
+SKETCH = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                      "..", "..", "firmware", "van_onboard_computer")
+FQBN = "arduino:avr:mega:cpu=atmega2560"
+
+# Doit correspondre aux BOARD_PROFILE_* de config.h
+PROFILES = {
+    0: "van (complet)",
+    1: "sans DS18B20 ni INA226 5V",
+    2: "MQ7 + MQ2 + INA226 12V",
+}
+
+FLASH_SIZE = 253952   # 256 Ko moins le bootloader (8 Ko)
+RAM_SIZE = 8192
+
+
+def find_avr_size(explicit):
+    """avr-size du PATH, sinon celui installé par arduino-cli."""
+    if explicit:
+        return explicit
+    found = shutil.which("avr-size")
+    if found:
+        return found
+    pattern = os.path.expanduser(
+        "~/.arduino15/packages/arduino/tools/avr-gcc/*/bin/avr-size")
+    candidates = sorted(glob.glob(pattern))
+    if candidates:
+        return candidates[-1]
+    sys.exit("avr-size introuvable : installer arduino:avr ou passer --avr-size")
+
+
+def build(profile, build_dir, telemetry):
+    """Compile un profil ; retourne le chemin du .elf."""
+    flags = "-DBOARD_PROFILE=%d" % profile
+    if telemetry:
+        flags += " -DUSE_SERIAL_TELEMETRY=true"
+    subprocess.run(["arduino-cli", "compile", "--fqbn", FQBN,
+                    "--build-property", "compiler.cpp.extra_flags=" + flags,
+                    "--build-path", build_dir, SKETCH],
+                   check=True, stdout=subprocess.DEVNULL)
+    return os.path.join(build_dir, "van_onboard_computer.ino.elf")
+
+
+def measure_size(avr_size, elf):
+    """text, data, bss (format Berkeley d'avr-size)."""
+    out = subprocess.run([avr_size, elf], check=True,
+                         capture_output=True, text=True).stdout
+    fields = out.splitlines()[1].split()
+    return int(fields[0]), int(fields[1]), int(fields[2])
+
+
+def measure_loop(build_dir, port, baud, seconds):
+    """Téléverse puis moyenne loop_avg_us / maximum loop_max_us."""
+    subprocess.run(["arduino-cli", "upload", "--fqbn", FQBN, "-p", port,
+                    "--input-dir", build_dir, SKETCH],
+                   check=True, stdout=subprocess.DEVNULL)
+    time.sleep(2)   # Reset après téléversement
+
+    source = open_source(port, baud)
+    decoder = StreamDecoder()
+    averages = []
+    worst = 0
+    end = time.time() + seconds
+    try:
+        while time.time() < end:
+            for kind, item in decoder.feed(source.read(256)):
+                if kind == "snapshot" and "error" not in item:
+                    averages.append(item["loop_avg_us"])
+                    worst = max(worst, item["loop_max_us"])
+    finally:
+        source.close()
+
+    if not averages:
+        return None, None
+    return sum(averages) / len(averages), worst
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Tailles et temps de boucle par profil")
+    parser.add_argument("--profiles", type=int, nargs="+", default=sorted(PROFILES),
+                        choices=sorted(PROFILES), help="Profils à mesurer")
+    parser.add_argument("--build-dir", default="build_profiles", help="Répertoire de compilation")
+    parser.add_argument("--avr-size", help="Chemin d'avr-size")
+    parser.add_argument("--port", help="Port série : téléverse et mesure le temps de boucle")
+    parser.add_argument("--baud", type=int, default=115200, help="Vitesse série")
+    parser.add_argument("--seconds", type=int, default=30, help="Durée de mesure par profil")
+    args = parser.parse_args()
+
+    avr_size = find_avr_size(args.avr_size)
+
+    header = "%-2s %-28s %7s %6s %6s %14s %12s" % (
+        "#", "profil", "text", "data", "bss", "Flash", "RAM")
+    if args.port:
+        header += " %10s %10s" % ("boucle µs", "max µs")
+    print(header, flush=True)
+
+    for profile in args.profiles:
+        build_dir = os.path.join(args.build_dir, "profile_%d" % profile)
+        elf = build(profile, build_dir, telemetry=bool(args.port))
+        text, data, bss = measure_size(avr_size, elf)
+
+        flash = text + data
+        ram = data + bss
+        row = "%-2d %-28s %7d %6d %6d %7d (%4.1f%%) %5d (%4.1f%%)" % (
+            profile, PROFILES[profile], text, data, bss,
+            flash, 100.0 * flash / FLASH_SIZE, ram, 100.0 * ram / RAM_SIZE)
+
+        if args.port:
+            average, worst = measure_loop(build_dir, args.port, args.baud, args.seconds)
+            row += " %10s %10s" % (
+                "%.0f" % average if average is not None else "-",
+                worst if worst is not None else "-")
+        print(row, flush=True)
+
+
+if __name__ == "__main__":
+    main()
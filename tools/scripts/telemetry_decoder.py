@@ -0,0 +1,247 @@
+#!/usr/bin/env python3
+"""
+Décodeur de la télémétrie binaire du Van Onboard Computer.
+
+Lit le flux du port série de debug (ou un fichier de capture), affiche
+le texte de debug tel quel et décode les trames de télémétrie
+(firmware/van_onboard_computer/Telemetry.h) :
+
+    [0xA5][0x5A][version][longueur][instantané][CRC16 LSB][CRC16 MSB]
+
+Les trames de journal à jetons ([0xA5][0x5B], USE_LOG_TOKENS) sont
+signalées par leur jeton ; log_detokenizer.py rétablit leur texte.
+
+Usage :
+    telemetry_decoder.py /dev/ttyACM0            # port série (pyserial)
+    telemetry_decoder.py capture.bin             # fichier de capture
+    telemetry_decoder.py - < capture.bin         # entrée standard
+    telemetry_decoder.py /dev/ttyACM0 --csv out.csv
+"""
+
+import argparse
+import csv
+import os
+import struct
+import sys
+
+SYNC = b"\xA5\x5A"
+SYNC_TOKEN = b"\xA5\x5B"
+VERSION = 1
+
+# Doit correspondre à TelemetrySnapshot (little-endian, packed)
+SNAPSHOT_FORMAT = "<IBBH4h7h3h3hBB4BIIIHHHH"
+SNAPSHOT_FIELDS = (
+    "uptime", "mode", "screen", "flags",
+    "temp_int", "temp_ext", "humidity", "pressure",
+    "v12", "i12", "p12", "v5", "i5_ma", "p5", "p_total",
+    "co", "gpl", "smoke",
+    "roll", "pitch", "tilt",
+    "alert_level", "alert_count", "alert_1", "alert_2", "alert_3", "alert_4",
+    "loops", "loop_avg_us", "loop_max_us", "slow_loops",
+    "free_ram", "led_shows_min", "dropped",
+)
+SNAPSHOT_SIZE = struct.calcsize(SNAPSHOT_FORMAT)
+
+# Échelles (valeur transmise / échelle = valeur réelle)
+SCALES = {
+    "temp_int": 10, "temp_ext": 10, "humidity": 10, "pressure": 10,
+    "v12": 100, "i12": 100, "p12": 10, "v5": 100, "p5": 100, "p_total": 10,
+    "roll": 10, "pitch": 10, "tilt": 10,
+}
+
+MODES = ("PRECHAUFFE", "NORMAL", "PARAMETRES", "ALERTE")
+LEVELS = ("NONE", "INFO", "WARNING", "DANGER", "CRITICAL")
+ALERT_TYPES = (
+    "-", "CO", "GPL", "FUMEE", "12V BAS", "12V HAUT", "5V BAS", "5V HAUT",
+    "I 12V", "I 5V", "TEMP HAUTE", "TEMP BASSE", "HUMIDITE", "INCLINAISON",
+)
+
+FLAG_NAMES = (
+    (0x0001, "temp_int"), (0x0002, "temp_ext"), (0x0004, "humidity"),
+    (0x0008, "pressure"), (0x0010, "v12"), (0x0020, "v5"),
+    (0x0040, "mq7_ready"), (0x0080, "mq2_ready"), (0x0100, "level"),
+)
+
+
+def crc16_ccitt(data, crc=0xFFFF):
+    """CRC16-CCITT (poly 0x1021, init 0xFFFF), identique à dashCrc16()."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+class StreamDecoder:
+    """Sépare le texte de debug des trames binaires dans un flux mixte."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.crc_errors = 0
+
+    def feed(self, data):
+        """Ajoute des octets ; produit ('text', str), ('snapshot', dict)
+        ou ('token', (niveau, payload))."""
+        self.buffer += data
+
+        while self.buffer:
+            starts = [i for i in (self.buffer.find(SYNC), self.buffer.find(SYNC_TOKEN)) if i >= 0]
+            start = min(starts) if starts else -1
+
+            # Texte avant l'en-tête (ou tout le tampon sans en-tête)
+            text_end = start if start >= 0 else len(self.buffer)
+            if start < 0 and self.buffer.endswith(SYNC[:1]):
+                text_end -= 1  # En-tête possiblement coupé
+            if text_end > 0:
+                text = bytes(self.buffer[:text_end])
+                del self.buffer[:text_end]
+                yield ("text", text.decode("utf-8", errors="replace"))
+                continue
+            if start < 0:
+                return
+
+            # En-tête en tête de tampon : attendre la trame complète
+            if len(self.buffer) < 4:
+                return
+            length = self.buffer[3]
+            total = 4 + length + 2
+            if len(self.buffer) < total:
+                return
+
+            frame = bytes(self.buffer[:total])
+            crc = frame[-2] | (frame[-1] << 8)
+            if crc16_ccitt(frame[2:-2]) != crc:
+                # Faux en-tête (ou trame corrompue) : le traiter comme du texte
+                self.crc_errors += 1
+                del self.buffer[:1]
+                yield ("text", "�")
+                continue
+
+            del self.buffer[:total]
+            if frame[:2] == SYNC_TOKEN:
+                yield ("token", (frame[2], frame[4:-2]))
+            else:
+                yield ("snapshot", decode_snapshot(frame[2], frame[4:-2]))
+
+
+def decode_snapshot(version, payload):
+    """Décode un instantané ; valeurs mises à l'échelle réelle."""
+    if version != VERSION or len(payload) != SNAPSHOT_SIZE:
+        return {"error": "version %d / taille %d non supportée" % (version, len(payload))}
+
+    values = dict(zip(SNAPSHOT_FIELDS, struct.unpack(SNAPSHOT_FORMAT, payload)))
+    for name, scale in SCALES.items():
+        values[name] = values[name] / scale
+    values["i5"] = values.pop("i5_ma") / 1000
+    values["valid"] = {name for bit, name in FLAG_NAMES if values["flags"] & bit}
+    return values
+
+
+def name_of(table, index):
+    return table[index] if 0 <= index < len(table) else "?%d" % index
+
+
+def render(snap):
+    """Rendu texte d'un instantané."""
+    if "error" in snap:
+        return "[TELEMETRIE] " + snap["error"]
+
+    valid = snap["valid"]
+
+    def value(field, fmt, unit, flag=None):
+        return (fmt % snap[field]) + unit if (flag or field) in valid else "--"
+
+    uptime = snap["uptime"]
+    alerts = [name_of(ALERT_TYPES, snap["alert_%d" % i])
+              for i in range(1, min(snap["alert_count"], 4) + 1)]
+    lines = [
+        "=== TELEMETRIE %02d:%02d:%02d - %s ===" % (
+            uptime // 3600, uptime // 60 % 60, uptime % 60, name_of(MODES, snap["mode"])),
+        "Env    : int %s  ext %s  hum %s  %s" % (
+            value("temp_int", "%.1f", "C"), value("temp_ext", "%.1f", "C"),
+            value("humidity", "%.0f", "%"), value("pressure", "%.1f", "hPa")),
+        "12V    : %s  %.2fA  %.1fW" % (value("v12", "%.2f", "V"), snap["i12"], snap["p12"]),
+        "5V     : %s  %.3fA  %.2fW   total %.1fW" % (
+            value("v5", "%.2f", "V"), snap["i5"], snap["p5"], snap["p_total"]),
+        "Gaz    : CO %s  GPL %s  fumee %s" % (
+            "%dppm" % snap["co"] if "mq7_ready" in valid else "[PRE-CHAUFFE]",
+            "%dppm" % snap["gpl"] if "mq2_ready" in valid else "[PRE-CHAUFFE]",
+            "%dppm" % snap["smoke"] if "mq2_ready" in valid else "[PRE-CHAUFFE]"),
+        "Niveau : roll %s  pitch %s  total %s" % (
+            value("roll", "%+.1f", "deg", "level"), value("pitch", "%+.1f", "deg", "level"),
+            value("tilt", "%.1f", "deg", "level")),
+        "Alertes: %s (%d) %s" % (name_of(LEVELS, snap["alert_level"]),
+                                 snap["alert_count"], " ".join(alerts)),
+        "Perf   : loops %d  moy %.2fms  max %.2fms  lents %d  RAM %d  LED %d/min  perdus %d" % (
+            snap["loops"], snap["loop_avg_us"] / 1000, snap["loop_max_us"] / 1000,
+            snap["slow_loops"], snap["free_ram"], snap["led_shows_min"], snap["dropped"]),
+    ]
+    return "\n".join(lines)
+
+
+def open_source(path, baud):
+    """Ouvre un port série, un fichier ou l'entrée standard."""
+    if path == "-":
+        return sys.stdin.buffer
+    if os.path.exists(path) and not path.startswith("/dev/"):
+        return open(path, "rb")
+    try:
+        import serial  # pyserial
+    except ImportError:
+        sys.exit("pyserial requis pour lire un port série : pip install pyserial")
+    return serial.Serial(path, baud, timeout=0.1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Décodeur télémétrie VOBC")
+    parser.add_argument("source", help="Port série, fichier de capture ou '-'")
+    parser.add_argument("--baud", type=int, default=115200, help="Vitesse série")
+    parser.add_argument("--csv", help="Enregistre les instantanés en CSV")
+    parser.add_argument("--quiet", action="store_true", help="Masque le texte de debug")
+    args = parser.parse_args()
+
+    source = open_source(args.source, args.baud)
+    decoder = StreamDecoder()
+    writer = None
+    csv_file = None
+
+    if args.csv:
+        csv_file = open(args.csv, "w", newline="")
+        writer = csv.DictWriter(csv_file, fieldnames=[
+            f for f in SNAPSHOT_FIELDS if f != "i5_ma"] + ["i5"], extrasaction="ignore")
+        writer.writeheader()
+
+    try:
+        while True:
+            data = source.read(256) if hasattr(source, "in_waiting") else source.read1(256) \
+                if hasattr(source, "read1") else source.read(256)
+            if not data:
+                if hasattr(source, "in_waiting"):
+                    continue  # Port série : attente
+                break          # Fin de fichier
+
+            for kind, item in decoder.feed(data):
+                if kind == "text":
+                    if not args.quiet:
+                        sys.stdout.write(item)
+                elif kind == "token":
+                    if not args.quiet and len(item[1]) >= 4:
+                        sys.stdout.write("[JETON 0x%08X]" % struct.unpack_from("<I", item[1])[0])
+                else:
+                    print(render(item))
+                    if writer and "error" not in item:
+                        writer.writerow(item)
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if csv_file:
+            csv_file.close()
+
+    if decoder.crc_errors:
+        print("\n[TELEMETRIE] En-têtes invalides ignorés : %d" % decoder.crc_errors, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()